@@ -0,0 +1,11 @@
+#ifndef __audit_Output_hpp__
+#define __audit_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "audit"
+} // namespace test
+
+#endif // of __audit_Output_hpp
@@ -0,0 +1,194 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "audit/Output.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+#include "vega/shapes.hpp"
+
+using namespace test;
+using namespace std;
+
+namespace NAudit
+{
+  // prints the table of test::compare() followed by the maximal and
+  // the RMS errors relative to max(|exact|, dFloor)
+  void report(const std::valarray<double> &rExact, const std::valarray<double> &rApprox,
+              const std::string &sTitle, double dFloor = 0.)
+  {
+    std::valarray<double> uScale = std::abs(rExact);
+    for (double &dS : uScale)
+    {
+      dS = std::max(dS, dFloor);
+    }
+    std::valarray<double> uError = std::abs(rApprox - rExact) / uScale;
+    compare(rExact, rApprox, sTitle);
+    print(uError.max(), "maximal relative error");
+    print(std::sqrt((uError * uError).sum() / uError.size()), "RMS relative error", true);
+  }
+
+  // the values of a curve at the points
+  std::valarray<double> values(const std::function<double(double)> &rF,
+                               const std::valarray<double> &rArg)
+  {
+    std::valarray<double> uY(rArg.size());
+    for (unsigned i = 0; i < rArg.size(); i++)
+    {
+      uY[i] = rF(rArg[i]);
+    }
+    return uY;
+  }
+
+  // the time of evaluation of a curve at the points
+  Measurement time(const std::function<double(double)> &rF, const std::valarray<double> &rArg,
+                   const std::string &sCurve, const std::string &sKind)
+  {
+    double dSum = 0.;
+    Measurement uM = measure([&rF, &rArg, &dSum]()
+                             {
+                               for (double dT : rArg)
+                               {
+                                 dSum += rF(dT);
+                               } },
+                             sCurve, sKind, 0, rArg.size());
+    keepAlive(dSum);
+    return uM;
+  }
+
+  // shape2 in long double: the Taylor series for small arguments
+  long double shape2(long double dX)
+  {
+    if (dX > 0.5L)
+    {
+      return (1.L - std::exp(-dX) * (1.L + dX)) / dX;
+    }
+    // (-1)^k (k+1) x^{k+1} / (k+2)!
+    long double dTerm = dX / 2.L;
+    long double dSum = 0.L;
+    for (unsigned k = 0; k < 30; k++)
+    {
+      dSum += dTerm;
+      dTerm *= -dX * (k + 2) / ((k + 1) * (k + 3.L));
+    }
+    return dSum;
+  }
+} // namespace NAudit
+
+void fusedShapes()
+{
+  print("ERRORS OF SHAPES");
+
+  unsigned iPoints = 1000000;
+  print(iPoints, "random points in every test", true);
+
+  // shape1(x) + shape1(2x) from two exponentials and from one
+  std::function<double(double)> uSeparate = [](double dX)
+  { return vega::Shapes::shape1(dX) + vega::Shapes::shape1(2 * dX); };
+  std::function<double(double)> uFused = [](double dX)
+  {
+    vega::ShapeValues uShapes = vega::Shapes::values(dX);
+    return uShapes.shape1 + uShapes.shape1Of2x;
+  };
+  // the references in long double are free of the cancellations
+  std::function<double(double)> uReference1 = [](double dX)
+  { return double(-std::expm1(-(long double)dX) / dX); };
+  std::function<double(double)> uReference1Of2x = [](double dX)
+  { return double(-std::expm1(-2.L * dX) / (2.L * dX)); };
+  std::function<double(double)> uReference2 = [](double dX)
+  { return double(NAudit::shape2(dX)); };
+  std::function<double(double)> uShape1 = [](double dX)
+  { return vega::Shapes::shape1(dX); };
+  std::function<double(double)> uShape1Of2x = [](double dX)
+  { return vega::Shapes::shape1Of2x(dX); };
+  std::function<double(double)> uFusedShape1 = [](double dX)
+  { return vega::Shapes::values(dX).shape1; };
+  std::function<double(double)> uFusedShape1Of2x = [](double dX)
+  { return vega::Shapes::values(dX).shape1Of2x; };
+  std::function<double(double)> uShape2 = [](double dX)
+  { return vega::Shapes::shape2(dX); };
+  std::function<double(double)> uFusedShape2 = [](double dX)
+  { return vega::Shapes::values(dX).shape2; };
+
+  std::valarray<double> uArg = std::exp(getRandArg(-25., 3., iPoints));
+  std::valarray<double> uExact = NAudit::values(uReference1, uArg);
+  NAudit::report(uExact, NAudit::values(uShape1, uArg), "shape1(x) on [1e-11,20]");
+  NAudit::report(uExact, NAudit::values(uFusedShape1, uArg),
+                 "shape1(x) on [1e-11,20] from the fused shapes");
+  uExact = NAudit::values(uReference1Of2x, uArg);
+  NAudit::report(uExact, NAudit::values(uShape1Of2x, uArg),
+                 "shape1(2x) on [1e-11,20] from exp(-2x)");
+  NAudit::report(uExact, NAudit::values(uFusedShape1Of2x, uArg),
+                 "shape1(2x) on [1e-11,20] from exp(-x)");
+  uExact = NAudit::values(uReference2, uArg);
+  NAudit::report(uExact, NAudit::values(uShape2, uArg), "shape2(x) on [1e-11,20]");
+  NAudit::report(uExact, NAudit::values(uFusedShape2, uArg),
+                 "shape2(x) on [1e-11,20] from the fused shapes");
+
+  // the volatility of options on bonds that mature one year later
+  double dInitialTime = 1.;
+  double dSigma = 0.01;
+  double dLambda = 0.1;
+  std::function<double(double, double)> uHullWhite =
+      vega::volatilityHullWhite(dSigma, dLambda, dInitialTime);
+  std::function<double(double)> uCurve = [uHullWhite](double dS)
+  { return uHullWhite(dS, dS + 1.); };
+  std::function<double(double)> uReferenceCurve = [&](double dS)
+  {
+    long double dX = dLambda * (dS - dInitialTime);
+    long double dShape = (dX > 0) ? -std::expm1(-2.L * dX) / (2.L * dX) : 1.L;
+    return double(-dSigma * std::expm1(-(long double)dLambda) / dLambda * std::sqrt(dShape));
+  };
+  std::valarray<double> uTimesArg = dInitialTime + std::exp(getRandArg(-25., 3., iPoints));
+  NAudit::report(NAudit::values(uReferenceCurve, uTimesArg), NAudit::values(uCurve, uTimesArg),
+                 "volatilityHullWhite(s, s+1) on [t0+1e-11,t0+20]");
+
+  // the curves near the initial time, where every shape is a series
+  std::function<double(double)> uShape2Curve = vega::yieldShape2(dLambda, dInitialTime);
+  std::function<double(double)> uReferenceShape2Curve = [&](double dT)
+  { return double(NAudit::shape2((long double)dLambda * (dT - dInitialTime))); };
+  NAudit::report(NAudit::values(uReferenceShape2Curve, uTimesArg),
+                 NAudit::values(uShape2Curve, uTimesArg),
+                 "yieldShape2(t) on [t0+1e-11,t0+20]");
+
+  double dLambda2 = 0.5;
+  std::function<double(double)> uSvensson =
+      vega::yieldSvensson(0.03, -0.01, 0.02, 0.01, dLambda, dLambda2, dInitialTime);
+  std::function<double(double)> uReferenceSvensson = [&](double dT)
+  {
+    long double dX1 = dLambda * (dT - dInitialTime);
+    long double dX2 = dLambda2 * (dT - dInitialTime);
+    long double dShape1 = (dX1 > 0) ? -std::expm1(-dX1) / dX1 : 1.L;
+    return double(0.03L - 0.01L * dShape1 + 0.02L * NAudit::shape2(dX1) +
+                  0.01L * NAudit::shape2(dX2));
+  };
+  NAudit::report(NAudit::values(uReferenceSvensson, uTimesArg),
+                 NAudit::values(uSvensson, uTimesArg),
+                 "yieldSvensson(t) on [t0+1e-11,t0+20]");
+
+  std::vector<Measurement> uTimes;
+  uTimes.push_back(NAudit::time(uSeparate, uArg, "shape1(x) + shape1(2x)", "separate"));
+  uTimes.push_back(NAudit::time(uFused, uArg, "shape1(x) + shape1(2x)", "fused"));
+  // the times depend on the machine
+  printBench(uTimes, "times of evaluation of separate and fused shapes");
+  print("row 0: shape1(x) and shape1(2x) from two exponentials");
+  print("row 1: shape1(x) and shape1(2x) from one exponential");
+  out() << endl;
+}
+
+std::function<void()> test_audit()
+{
+  return []()
+  {
+    print("AUDIT OF THE SHAPES OF CURVES");
+
+    fusedShapes();
+  };
+}
+
+int main()
+{
+  project(test_audit(), PROJECT_NAME, PROJECT_NAME,
+          "Errors of the shapes of curves");
+}
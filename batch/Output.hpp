@@ -0,0 +1,11 @@
+#ifndef __batch_Output_hpp__
+#define __batch_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "batch"
+} // namespace test
+
+#endif // of __batch_Output_hpp
@@ -0,0 +1,31 @@
+#include "test/Main.hpp"
+#include "test/Print.hpp"
+#include "batch/Output.hpp"
+#include <cstdlib>
+
+using namespace test;
+using namespace std;
+
+std::function<void()> test_prep1();
+std::function<void()> test_prep2();
+std::function<void()> test_prepExam();
+
+namespace NBatch
+{
+  // the projects of the batch; every report is written to its own
+  // file in the directory of the batch
+  std::vector<Job> jobs()
+  {
+    return {{test_prep1(), PROJECT_NAME, "prep1", "Set 1"},
+            {test_prep2(), PROJECT_NAME, "prep2", "Set 2"},
+            {test_prepExam(), PROJECT_NAME, "prepExam", "Exam for Vega-Prep"}};
+  }
+} // namespace NBatch
+
+int main(int argc, char *argv[])
+{
+  // "batch <threads>" sets the number of threads; by default, all
+  // hardware threads are used
+  unsigned iThreads = (argc > 1) ? unsigned(std::atoi(argv[1])) : 0;
+  runProjects(NBatch::jobs(), iThreads);
+}
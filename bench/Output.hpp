@@ -0,0 +1,11 @@
+#ifndef __bench_Output_hpp__
+#define __bench_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "bench"
+} // namespace test
+
+#endif // of __bench_Output_hpp
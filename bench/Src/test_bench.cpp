@@ -0,0 +1,335 @@
+#include "test/Main.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "test/Histogram.hpp"
+#include "bench/Output.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+#include <random>
+
+using namespace test;
+using namespace std;
+
+namespace NBench
+{
+  const double c_dInitialTime = 1.;
+  const double c_dHorizon = 30.;
+  const double c_dRate = 0.05;
+  const std::vector<unsigned> c_uKnots = {10, 100, 1000, 10000};
+  const unsigned long c_iMaxPoints = 10000000;
+  // the number of single calls for the histograms of latencies
+  const unsigned long c_iLatencyPoints = 10000;
+  // the sizes of batches grow while one run takes less than this time
+  const double c_dMaxRun = 0.5;
+
+  /**
+   * A curve in the benchmark: the builder and the domain of the curve.
+   */
+  class Curve
+  {
+  public:
+    std::string name;
+    unsigned knots;
+    std::function<std::function<double(double)>()> build;
+    double start;
+    double end;
+  };
+
+  std::function<double(double)> DF(double dRate, double dInitialTime)
+  {
+    return [dRate, dInitialTime](double dT)
+    {
+      return std::exp(-dRate * (dT - dInitialTime));
+    };
+  }
+
+  std::vector<double> knotTimes(unsigned iKnots)
+  {
+    return getTimes(c_dInitialTime, c_dInitialTime + c_dHorizon, iKnots);
+  }
+
+  std::vector<double> knotValues(const std::vector<double> &rTimes,
+                                 const std::function<double(double)> &rF)
+  {
+    std::vector<double> uValues(rTimes.size());
+    std::transform(rTimes.begin(), rTimes.end(), uValues.begin(), rF);
+    return uValues;
+  }
+
+  // curves without knots
+  std::vector<Curve> parametric()
+  {
+    double dT0 = c_dInitialTime;
+    double dT1 = c_dInitialTime + c_dHorizon;
+    std::function<double(double)> uDF = DF(c_dRate, dT0);
+    std::function<double(double)> uDF2 = DF(2. * c_dRate, dT0);
+
+    return {
+        {"discountNelsonSiegel", 0, [dT0]()
+         { return vega::discountNelsonSiegel(0.02, 0.04, 0.06, 0.05, dT0); },
+         dT0, dT1},
+        {"forwardFX (prep1)", 0, [uDF, uDF2]()
+         {
+           std::function<double(double, double)> uFX = vega::forwardFX(100.);
+           return std::function<double(double)>([uFX, uDF, uDF2](double dT)
+                                                { return uFX(uDF(dT), uDF2(dT)); });
+         },
+         dT0, dT1},
+        {"yield (discount factor)", 0, [dT0, uDF]()
+         {
+           std::function<double(double, double)> uYield = vega::yield(dT0);
+           return std::function<double(double)>([uYield, uDF](double dT)
+                                                { return uYield(dT, uDF(dT)); });
+         },
+         dT0 + 0.01, dT1},
+        {"yield (discount curve)", 0, [dT0, uDF]()
+         { return vega::yield(uDF, dT0); },
+         dT0, dT1},
+        {"yieldNelsonSiegel", 0, [dT0]()
+         { return vega::yieldNelsonSiegel(0.02, 0.04, 0.06, 0.05, dT0); },
+         dT0, dT1},
+        {"yieldShape1", 0, [dT0]()
+         { return vega::yieldShape1(0.05, dT0); },
+         dT0, dT1},
+        {"yieldShape2", 0, [dT0]()
+         { return vega::yieldShape2(0.05, dT0); },
+         dT0, dT1},
+        {"carryBlack", 0, [dT0]()
+         { return vega::carryBlack(0.03, 0.05, 0.2, dT0); },
+         dT0, dT1},
+        {"discountVasicek", 0, [dT0]()
+         { return vega::discountVasicek(0.02, 0.05, 0.01, 0.04, dT0); },
+         dT0, dT1},
+        {"volatilityHullWhite", 0, [dT0]()
+         {
+           std::function<double(double, double)> uVol = vega::volatilityHullWhite(0.01, 0.05, dT0);
+           return std::function<double(double)>([uVol](double dS)
+                                                { return uVol(dS, dS + 0.5); });
+         },
+         dT0, dT1},
+        {"volatilityVar", 0, [dT0]()
+         {
+           std::function<double(double)> uVar = [dT0](double dT)
+           { return 0.04 * (dT - dT0); };
+           return vega::volatilityVar(uVar, dT0);
+         },
+         dT0, dT1},
+        {"yieldVasicek", 0, [dT0]()
+         { return vega::yieldVasicek(0.02, 0.05, 0.01, 0.04, dT0); },
+         dT0, dT1},
+        {"costOfCarry", 0, [dT0]()
+         {
+           std::function<double(double, double)> uCarry = vega::costOfCarry(100., dT0);
+           return std::function<double(double)>([uCarry, dT0](double dT)
+                                                { return uCarry(100. * std::exp(0.03 * (dT - dT0)), dT); });
+         },
+         dT0 + 0.01, dT1},
+        {"forwardFX (prepExam)", 0, [uDF, uDF2]()
+         { return vega::forwardFX(100., uDF, uDF2); },
+         dT0, dT1},
+        {"yieldSvensson", 0, [dT0]()
+         { return vega::yieldSvensson(0.02, 0.04, 0.06, 0.03, 0.05, 0.07, dT0); },
+         dT0, dT1},
+        {"volatilityBlack", 0, [dT0]()
+         { return vega::volatilityBlack(0.2, 0.05, dT0); },
+         dT0, dT1},
+        {"forwardLibor", 0, [uDF]()
+         { return vega::forwardLibor(0.25, uDF); },
+         dT0, dT1},
+    };
+  }
+
+  // curves with iKnots market quotes or payments
+  std::vector<Curve> interpolated(unsigned iKnots)
+  {
+    double dT0 = c_dInitialTime;
+    double dT1 = c_dInitialTime + c_dHorizon;
+    double dPeriod = c_dHorizon / iKnots;
+    std::function<double(double)> uDF = DF(c_dRate, dT0);
+    std::vector<double> uTimes = knotTimes(iKnots);
+    std::vector<double> uDiscount = knotValues(uTimes, uDF);
+    std::vector<double> uForward = knotValues(uTimes, [dT0](double dT)
+                                              { return 100. * std::exp(0.03 * (dT - dT0)); });
+    std::vector<double> uVols = knotValues(uTimes, [](double dT)
+                                           { return 0.2 + 0.01 * std::sin(dT); });
+    std::vector<double> uPayments(iKnots, 1.);
+    double dR = c_dRate;
+
+    return {
+        {"discountYieldLinInterp", iKnots, [uTimes, uDiscount, dR, dT0]()
+         { return vega::discountYieldLinInterp(uTimes, uDiscount, dR, dT0); },
+         dT0, dT1},
+        {"forwardCashFlow", iKnots, [uPayments, uTimes, uDF]()
+         { return vega::forwardCashFlow(uPayments, uTimes, uDF); },
+         dT0, dT1},
+        {"forwardCouponBond", iKnots, [dPeriod, dT1, uDF]()
+         { return vega::forwardCouponBond(0.05, dPeriod, dT1, uDF, true); },
+         dT0, dT1},
+        {"discountLogLinInterp", iKnots, [uTimes, uDiscount, dT0]()
+         { return vega::discountLogLinInterp(uTimes, uDiscount, dT0); },
+         dT0, dT1},
+        {"forwardAnnuity", iKnots, [dPeriod, dT1, uDF]()
+         { return vega::forwardAnnuity(0.05, dPeriod, dT1, uDF, true); },
+         dT0, dT1},
+        {"forwardStockDividends", iKnots, [uTimes, uPayments, uDF]()
+         { return vega::forwardStockDividends(100., uTimes, uPayments, uDF); },
+         dT0, dT1},
+        {"forwardSwapRate", iKnots, [iKnots, uDF]()
+         { return vega::forwardSwapRate(0.25, iKnots, uDF); },
+         dT0, dT1},
+        {"volatilityVarLinInterp", iKnots, [uTimes, uVols, dT0]()
+         { return vega::volatilityVarLinInterp(uTimes, uVols, dT0); },
+         dT0, dT1},
+        {"forwardCarryLinInterp", iKnots, [uTimes, uForward, dT0]()
+         { return vega::forwardCarryLinInterp(100., uTimes, uForward, dT0); },
+         dT0, dT1},
+    };
+  }
+
+  // uniform random numbers on [0,1) in random order
+  const std::vector<double> &uniforms()
+  {
+    static std::vector<double> uU;
+    if (uU.empty())
+    {
+      uU.resize(c_iMaxPoints);
+      std::mt19937_64 uGen(1);
+      std::uniform_real_distribution<double> uRand(0., 1.);
+      std::generate(uU.begin(), uU.end(), [&uGen, &uRand]()
+                    { return uRand(uGen); });
+    }
+    return uU;
+  }
+
+  std::vector<Measurement> measure(const Curve &rCurve)
+  {
+    std::vector<Measurement> uResults;
+
+    uResults.push_back(test::measure([&rCurve]()
+                                     { rCurve.build(); },
+                                     rCurve.name, "construction", rCurve.knots, 1));
+
+    std::function<double(double)> uF = rCurve.build();
+    const double *pU = uniforms().data();
+    double dStart = rCurve.start;
+    double dLength = rCurve.end - rCurve.start;
+
+    // every point depends on the previous value, so calls do not overlap
+    unsigned long iChain = 10000;
+    uResults.push_back(test::measure([&uF, pU, dStart, dLength, iChain]()
+                                     {
+                                       double dX = 0.;
+                                       for (unsigned long i = 0; i < iChain; i++)
+                                       {
+                                         dX = uF(dStart + dLength * pU[i] + 0. * dX);
+                                       }
+                                       keepAlive(dX); },
+                                     rCurve.name, "latency", rCurve.knots, iChain));
+
+    for (unsigned long iPoints = 1; iPoints <= c_iMaxPoints; iPoints *= 10)
+    {
+      Measurement uM = test::measure([&uF, pU, dStart, dLength, iPoints]()
+                                     {
+                                       double dSum = 0.;
+                                       for (unsigned long i = 0; i < iPoints; i++)
+                                       {
+                                         dSum += uF(dStart + dLength * pU[i]);
+                                       }
+                                       keepAlive(dSum); },
+                                     rCurve.name, "throughput", rCurve.knots, iPoints);
+      uResults.push_back(uM);
+      if (uM.seconds / uM.repeats > c_dMaxRun / 10.)
+      {
+        break;
+      }
+    }
+    return uResults;
+  }
+
+  // the tail latencies of single calls of the curves
+  void latency(const std::vector<Curve> &rCurves, const std::string &sTitle)
+  {
+    std::vector<std::string> uNames;
+    std::vector<Histogram> uHistograms;
+    const std::vector<double> &rU = uniforms();
+    for (const Curve &rCurve : rCurves)
+    {
+      std::vector<double> uPoints(c_iLatencyPoints);
+      std::transform(rU.begin(), rU.begin() + c_iLatencyPoints, uPoints.begin(),
+                     [&rCurve](double dU)
+                     { return rCurve.start + (rCurve.end - rCurve.start) * dU; });
+      uNames.push_back(rCurve.name);
+      uHistograms.push_back(test::latency(rCurve.build(), uPoints));
+    }
+    printLatency(uNames, uHistograms, sTitle);
+  }
+
+  void print(const std::vector<Measurement> &rResults, const std::string &sKind)
+  {
+    std::vector<Measurement> uKind;
+    std::copy_if(rResults.begin(), rResults.end(), std::back_inserter(uKind),
+                 [&sKind](const Measurement &rM)
+                 { return rM.kind == sKind; });
+    printBench(uKind, sKind + ":");
+  }
+} // namespace NBench
+
+using namespace NBench;
+
+void benchCurves(std::vector<Measurement> &rResults, const std::vector<Curve> &rCurves)
+{
+  for (const Curve &rCurve : rCurves)
+  {
+    std::vector<Measurement> uResults = NBench::measure(rCurve);
+    std::string sTitle = rCurve.name;
+    if (rCurve.knots > 0)
+    {
+      sTitle += ", knots = " + std::to_string(rCurve.knots);
+    }
+    test::print(sTitle);
+    NBench::print(uResults, "construction");
+    NBench::print(uResults, "latency");
+    NBench::print(uResults, "throughput");
+    rResults.insert(rResults.end(), uResults.begin(), uResults.end());
+  }
+}
+
+std::function<void()> test_bench()
+{
+  return []()
+  {
+    print("BENCHMARKS OF DATA CURVES");
+
+    PerfCounters uCounters;
+    uCounters.start();
+    if (!uCounters.stop().available())
+    {
+      print("Hardware counters are not available (see kernel.perf_event_paranoid); only times are reported.");
+    }
+
+    std::vector<Measurement> uResults;
+    benchCurves(uResults, parametric());
+    for (unsigned iKnots : c_uKnots)
+    {
+      benchCurves(uResults, interpolated(iKnots));
+    }
+
+    print("TAIL LATENCIES OF SINGLE CALLS");
+    NBench::latency(parametric(), "curves without knots:");
+    for (unsigned iKnots : c_uKnots)
+    {
+      NBench::latency(interpolated(iKnots), "curves with " + std::to_string(iKnots) + " knots:");
+    }
+
+    std::string sFile = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME + "/" + PROJECT_NAME + ".json";
+    writeJson(uResults, sFile);
+    print("The results in JSON format are written to the file " + sFile);
+  };
+}
+
+int main()
+{
+  project(test_bench(), PROJECT_NAME, PROJECT_NAME,
+          "Benchmarks");
+}
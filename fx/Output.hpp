@@ -0,0 +1,11 @@
+#ifndef __fx_Output_hpp__
+#define __fx_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "fx"
+} // namespace test
+
+#endif // of __fx_Output_hpp
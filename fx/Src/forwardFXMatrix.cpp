@@ -0,0 +1,66 @@
+#include "fx/fx.hpp"
+#include "prep1/prep1.hpp"
+#include <algorithm>
+
+vega::ForwardFXMatrix::ForwardFXMatrix(const std::vector<std::function<double(double)>> &rDiscounts,
+                                       const std::vector<double> &rTimes)
+    : m_uDiscounts(rTimes.size() * rDiscounts.size()), m_iCurrencies(rDiscounts.size())
+{
+  PRECONDITION(!rDiscounts.empty());
+
+  // every curve is evaluated once at every time
+  for (unsigned j = 0; j < m_iCurrencies; j++)
+  {
+    for (std::size_t t = 0; t < rTimes.size(); t++)
+    {
+      double dD = rDiscounts[j](rTimes[t]);
+      PRECONDITION(dD > 0);
+      m_uDiscounts[t * m_iCurrencies + j] = dD;
+    }
+  }
+}
+
+std::vector<double> vega::ForwardFXMatrix::operator()(const std::vector<double> &rSpots) const
+{
+  std::vector<double> uForwards;
+  (*this)(rSpots, uForwards);
+  return uForwards;
+}
+
+void vega::ForwardFXMatrix::operator()(const std::vector<double> &rSpots,
+                                       std::vector<double> &rForwards) const
+{
+  PRECONDITION(rSpots.size() == m_iCurrencies);
+  PRECONDITION(std::all_of(rSpots.begin(), rSpots.end(), [](double dS)
+                           { return dS > 0; }));
+
+  std::size_t iN = m_iCurrencies;
+  std::size_t iTimes = m_uDiscounts.size() / iN;
+  rForwards.resize(iTimes * iN * iN);
+  std::vector<double> uValues(iN);
+  std::vector<double> uInverses(iN);
+
+  for (std::size_t t = 0; t < iTimes; t++)
+  {
+    const double *pD = m_uDiscounts.data() + t * iN;
+    for (std::size_t j = 0; j < iN; j++)
+    {
+      uValues[j] = rSpots[j] * pD[j];
+      uInverses[j] = 1. / uValues[j];
+    }
+
+    // the outer product of the reciprocals and the values; the
+    // diagonal is exact
+    double *pMatrix = rForwards.data() + t * iN * iN;
+    for (std::size_t i = 0; i < iN; i++)
+    {
+      double dInverse = uInverses[i];
+      double *pRow = pMatrix + i * iN;
+      for (std::size_t j = 0; j < iN; j++)
+      {
+        pRow[j] = dInverse * uValues[j];
+      }
+      pRow[i] = 1.;
+    }
+  }
+}
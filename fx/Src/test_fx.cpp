@@ -0,0 +1,170 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "fx/Output.hpp"
+#include "fx/fx.hpp"
+#include "prep1/prep1.hpp"
+#include "prepExam/prepExam.hpp"
+
+using namespace test;
+using namespace std;
+
+namespace NFX
+{
+  const double c_dInitialTime = 1.;
+
+  // the Nelson-Siegel discount curves with the given long-term yields
+  std::vector<std::function<double(double)>> discounts(const std::vector<double> &rYields)
+  {
+    std::vector<std::function<double(double)>> uDiscounts;
+    for (double dC0 : rYields)
+    {
+      uDiscounts.push_back(vega::discountNelsonSiegel(dC0, -0.01, 0.02, 0.5, c_dInitialTime));
+    }
+    return uDiscounts;
+  }
+} // namespace NFX
+
+void forwardFXMatrix()
+{
+  print("FORWARD EXCHANGE RATES OF ALL PAIRS OF CURRENCIES");
+
+  double dInitialTime = NFX::c_dInitialTime;
+  std::vector<std::string> uNames = {"USD", "EUR", "GBP", "JPY"};
+  std::vector<double> uSpots = {1., 1.08, 1.27, 0.0067};
+  std::vector<double> uYields = {0.04, 0.03, 0.045, 0.005};
+  print(dInitialTime, "initial time", true);
+  printTable({uSpots, uYields}, {"spot", "yield c0"},
+             "spot prices in USD and long-term yields of USD, EUR, GBP, JPY", 10, 6, 4);
+
+  std::vector<std::function<double(double)>> uDiscounts = NFX::discounts(uYields);
+  std::vector<double> uTimes;
+  for (unsigned t = 1; t <= 6; t++)
+  {
+    uTimes.push_back(dInitialTime + 0.5 * t);
+  }
+  vega::ForwardFXMatrix uEngine(uDiscounts, uTimes);
+  std::vector<double> uForwards = uEngine(uSpots);
+
+  // the matrix at the last time
+  unsigned iN = uSpots.size();
+  const double *pMatrix = uForwards.data() + (uTimes.size() - 1) * iN * iN;
+  std::vector<std::vector<double>> uColumns(iN + 1);
+  for (unsigned i = 0; i < iN; i++)
+  {
+    uColumns[0].push_back(i);
+    for (unsigned j = 0; j < iN; j++)
+    {
+      uColumns[j + 1].push_back(pMatrix[i * iN + j]);
+    }
+  }
+  std::vector<std::string> uTitles = {"currency"};
+  uTitles.insert(uTitles.end(), uNames.begin(), uNames.end());
+  print(uTimes.back(), "delivery time", true);
+  printTable(uColumns, uTitles, "units of currency i per one unit of currency j", 10, 5, iN);
+
+  // the crosses agree with forwardFX for the cross spot rates and
+  // satisfy the triangulation F_ik = F_ij F_jk
+  double dForwardFX = 0.;
+  double dTriangle = 0.;
+  for (unsigned t = 0; t < uTimes.size(); t++)
+  {
+    const double *pF = uForwards.data() + t * iN * iN;
+    for (unsigned i = 0; i < iN; i++)
+    {
+      for (unsigned j = 0; j < iN; j++)
+      {
+        double dF = vega::forwardFX(uSpots[j] / uSpots[i], uDiscounts[i], uDiscounts[j])(uTimes[t]);
+        dForwardFX = std::max(dForwardFX, std::abs(pF[i * iN + j] / dF - 1.));
+        for (unsigned k = 0; k < iN; k++)
+        {
+          double dCross = pF[i * iN + j] * pF[j * iN + k];
+          dTriangle = std::max(dTriangle, std::abs(dCross / pF[i * iN + k] - 1.));
+        }
+      }
+    }
+  }
+  print(dForwardFX, "maximal relative difference with forwardFX");
+  print(dTriangle, "maximal relative error of triangulation", true);
+}
+
+void speed()
+{
+  print("SPEED OF FORWARD EXCHANGE RATES OF MANY CURRENCIES");
+
+  double dInitialTime = NFX::c_dInitialTime;
+  unsigned iN = 30;
+  unsigned iTimes = 1000;
+  std::valarray<double> uRandSpots = getRandArg(0.005, 2., iN);
+  std::valarray<double> uRandYields = getRandArg(0., 0.1, iN);
+  std::vector<double> uSpots(std::begin(uRandSpots), std::end(uRandSpots));
+  std::vector<double> uYields(std::begin(uRandYields), std::end(uRandYields));
+  std::vector<std::function<double(double)>> uDiscounts = NFX::discounts(uYields);
+  // the business days of four years
+  std::vector<double> uTimes;
+  for (unsigned t = 1; t <= iTimes; t++)
+  {
+    uTimes.push_back(dInitialTime + t / 250.);
+  }
+  print(iN, "currencies");
+  print(iTimes, "delivery times", true);
+
+  unsigned long iPoints = (unsigned long)iN * iN * iTimes;
+  std::vector<Measurement> uTimesBench;
+  std::vector<double> uForwards;
+  double dSum = 0.;
+  uTimesBench.push_back(measure([&]()
+                                {
+                                  for (unsigned i = 0; i < iN; i++)
+                                  {
+                                    for (unsigned j = 0; j < iN; j++)
+                                    {
+                                      std::function<double(double)> uFX =
+                                          vega::forwardFX(uSpots[j] / uSpots[i], uDiscounts[i], uDiscounts[j]);
+                                      for (double dT : uTimes)
+                                      {
+                                        dSum += uFX(dT);
+                                      }
+                                    }
+                                  } },
+                                "forwardFXMatrix", "scalar", iN, iPoints));
+  uTimesBench.push_back(measure([&]()
+                                {
+                                  vega::ForwardFXMatrix uEngine(uDiscounts, uTimes);
+                                  uEngine(uSpots, uForwards);
+                                  dSum += uForwards.back();
+                                },
+                                "forwardFXMatrix", "batch", iN, iPoints));
+  vega::ForwardFXMatrix uEngine(uDiscounts, uTimes);
+  uTimesBench.push_back(measure([&]()
+                                {
+                                  uEngine(uSpots, uForwards);
+                                  dSum += uForwards.back();
+                                },
+                                "forwardFXMatrix", "spots", iN, iPoints));
+  keepAlive(dSum);
+  // the times depend on the machine
+  printBench(uTimesBench, "forward rates of all pairs and times");
+  print("row 0: forwardFX for every pair");
+  print("row 1: construction of the engine and the matrices");
+  print("row 2: the matrices for new spot prices");
+  out() << endl;
+}
+
+std::function<void()> test_fx()
+{
+  return []()
+  {
+    print("FORWARD EXCHANGE RATES OF MANY CURRENCIES");
+
+    forwardFXMatrix();
+    speed();
+  };
+}
+
+int main()
+{
+  project(test_fx(), PROJECT_NAME, PROJECT_NAME,
+          "Matrices of forward exchange rates of many currencies");
+}
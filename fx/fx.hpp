@@ -0,0 +1,101 @@
+#ifndef __vega_fx_hpp__
+#define __vega_fx_hpp__
+
+/**
+ * @file fx.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Forward exchange rates of many currencies
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaFX Forward exchange rates of many currencies.
+   *
+   * This module computes the forward exchange rates of all pairs of
+   * \f$N\f$ currencies at given delivery times. The curve forwardFX()
+   * evaluates the domestic and the foreign discount curves at every
+   * call, so the \f$N^2\f$ crosses evaluate every curve \f$2N\f$ times
+   * at the same time. Here, the discount curve of a currency is
+   * evaluated once at every time and the crosses are products of the
+   * stored values.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The matrices of forward exchange rates of all pairs of
+   * currencies.
+   *
+   * The spot price of currency \f$j\f$ in units of a base currency is
+   * \f$S_j\f$; the base currency has \f$S_j=1\f$. The forward exchange
+   * rate of the pair \f$(i,j)\f$ is the number of units of currency
+   * \f$i\f$ per one unit of currency \f$j\f$ delivered at time \f$t\f$:
+   * \f[
+   *   F_{ij}(t) = \frac{S_j}{S_i}\frac{D_j(t)}{D_i(t)} = V_i(t)^{-1}
+   *   V_j(t), \quad V_j(t) = S_j D_j(t),
+   * \f]
+   * where \f$D_j\f$ is the discount curve of currency \f$j\f$. Thus,
+   * \f$F_{ij}\f$ is the curve forwardFX() for the cross spot rate
+   * \f$S_j/S_i\f$, the domestic currency \f$i\f$ and the foreign
+   * currency \f$j\f$.
+   *
+   * At construction, the discount factors of all currencies are
+   * computed once at every time and stored contiguously by time. A
+   * matrix of forward rates at a time is the outer product of the
+   * reciprocals \f$V_i^{-1}\f$ and the values \f$V_j\f$, so a change
+   * of spot prices does not evaluate the curves again.
+   */
+  class ForwardFXMatrix
+  {
+  public:
+    /**
+     * Constructs the engine.
+     *
+     * @param rDiscounts The discount curves of the currencies.
+     * @param rTimes The delivery times.
+     */
+    ForwardFXMatrix(const std::vector<std::function<double(double)>> &rDiscounts,
+                    const std::vector<double> &rTimes);
+
+    /**
+     * Computes the forward exchange rates of all pairs of currencies
+     * at all times.
+     *
+     * @param rSpots The spot prices \f$S_j>0\f$ of the currencies in
+     * units of the base currency.
+     * @return The rates \f$F_{ij}(t)\f$ in the row-major order (time,
+     * \f$i\f$, \f$j\f$).
+     */
+    std::vector<double> operator()(const std::vector<double> &rSpots) const;
+
+    /**
+     * Computes the forward exchange rates of all pairs of currencies
+     * at all times. If the spot prices are updated often, the memory
+     * for the results is allocated once.
+     *
+     * @param rSpots The spot prices \f$S_j>0\f$ of the currencies in
+     * units of the base currency.
+     * @param rForwards The rates \f$F_{ij}(t)\f$ in the row-major
+     * order (time, \f$i\f$, \f$j\f$).
+     */
+    void operator()(const std::vector<double> &rSpots, std::vector<double> &rForwards) const;
+
+  private:
+    /** The discount factors in the row-major order (time, currency). */
+    std::vector<double> m_uDiscounts;
+    unsigned m_iCurrencies;
+  };
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_fx_hpp__
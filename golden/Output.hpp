@@ -0,0 +1,11 @@
+#ifndef __golden_Output_hpp__
+#define __golden_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "golden"
+} // namespace test
+
+#endif // of __golden_Output_hpp
@@ -0,0 +1,90 @@
+#include "test/Main.hpp"
+#include "test/Print.hpp"
+#include "test/Golden.hpp"
+#include "golden/Output.hpp"
+#include <cstring>
+
+using namespace test;
+using namespace std;
+
+std::function<void()> test_prep1();
+std::function<void()> test_prep2();
+std::function<void()> test_prepExam();
+
+namespace NGolden
+{
+  // the minimal time of the replays of every project in seconds; the
+  // running time of a section is the minimum over the batches of
+  // replays of its average time in a batch
+  const double c_dMinTime = 0.2;
+
+  /**
+   * A replayed project: the name of its golden files and the
+   * testing function.
+   */
+  class Project
+  {
+  public:
+    std::string name;
+    std::function<void()> run;
+  };
+
+  std::vector<Project> projects()
+  {
+    return {{"prep1", test_prep1()},
+            {"prep2", test_prep2()},
+            {"prepExam", test_prepExam()}};
+  }
+
+  bool g_bRecord = false;
+  bool g_bPassed = true;
+} // namespace NGolden
+
+using namespace NGolden;
+
+std::function<void()> test_golden()
+{
+  return []()
+  {
+    print("REGRESSION TESTS AGAINST GOLDEN OUTPUTS");
+
+    Tolerance uTolerance;
+    print(uTolerance.relative, "relative tolerance for numbers");
+    print(uTolerance.absolute, "absolute tolerance for numbers");
+    print(uTolerance.slowdown, "maximal slowdown of a section");
+    print(uTolerance.noise, "allowed noise of the timer in seconds", true);
+
+    for (const Project &rProject : projects())
+    {
+      std::string sFile = std::string(GOLDEN_DIR) + "/" + rProject.name;
+      std::vector<Section> uReplay = replay(rProject.run, c_dMinTime);
+      if (g_bRecord)
+      {
+        writeGolden(uReplay, sFile);
+        print("The golden output of " + rProject.name + " is written to the files " +
+              sFile + ".txt and " + sFile + ".time");
+        continue;
+      }
+      std::vector<Section> uGolden = readGolden(sFile);
+      if (uGolden.empty())
+      {
+        print("FAILED: the golden output of " + rProject.name + " in the files " + sFile +
+              ".txt and " + sFile + ".time is missing or corrupt; run \"golden --record\"");
+        g_bPassed = false;
+        continue;
+      }
+      bool bPassed = checkGolden(uGolden, uReplay, uTolerance, rProject.name);
+      g_bPassed = g_bPassed && bPassed;
+    }
+    print(g_bPassed ? "ALL PROJECTS PASSED" : "SOME PROJECTS FAILED");
+  };
+}
+
+int main(int argc, char *argv[])
+{
+  // "golden --record" replaces the golden outputs by the current ones
+  g_bRecord = (argc > 1) && (std::strcmp(argv[1], "--record") == 0);
+  project(test_golden(), PROJECT_NAME, PROJECT_NAME,
+          "Golden outputs");
+  return g_bPassed ? 0 : 1;
+}
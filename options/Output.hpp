@@ -0,0 +1,11 @@
+#ifndef __options_Output_hpp__
+#define __options_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "options"
+} // namespace test
+
+#endif // of __options_Output_hpp
@@ -0,0 +1,108 @@
+#include "options/options.hpp"
+#include "prep1/prep1.hpp"
+#include "header.hpp"
+
+vega::Black76::Black76(const std::function<double(double)> &rForward,
+                       const std::function<double(double)> &rDiscount,
+                       const std::function<double(double)> &rVolatility,
+                       double dInitialTime, unsigned iThreads)
+    : m_uForward(rForward), m_uDiscount(rDiscount), m_uVolatility(rVolatility),
+      m_dInitialTime(dInitialTime), m_iThreads(iThreads)
+{
+}
+
+vega::OptionValues vega::Black76::operator()(const std::vector<double> &rStrikes,
+                                             const std::vector<double> &rMaturities,
+                                             const std::vector<Payoff> &rPayoffs) const
+{
+  OptionValues uValues;
+  (*this)(rStrikes, rMaturities, rPayoffs, uValues);
+  return uValues;
+}
+
+void vega::Black76::operator()(const std::vector<double> &rStrikes,
+                               const std::vector<double> &rMaturities,
+                               const std::vector<Payoff> &rPayoffs,
+                               OptionValues &rValues) const
+{
+  PRECONDITION(rStrikes.size() == rMaturities.size());
+  PRECONDITION(rStrikes.size() == rPayoffs.size());
+
+  // the curves at the distinct maturities
+  std::vector<unsigned> uIndex;
+  std::vector<double> uExpiries = options::expiries(rMaturities, uIndex);
+  std::vector<double> uF(uExpiries.size());
+  std::vector<double> uD(uExpiries.size());
+  std::vector<double> uRoot(uExpiries.size());
+  std::vector<double> uS(uExpiries.size());
+  for (unsigned e = 0; e < uExpiries.size(); e++)
+  {
+    double dT = uExpiries[e];
+    PRECONDITION(dT > m_dInitialTime);
+    uF[e] = m_uForward(dT);
+    uD[e] = m_uDiscount(dT);
+    uRoot[e] = std::sqrt(dT - m_dInitialTime);
+    uS[e] = m_uVolatility(dT) * uRoot[e];
+    PRECONDITION(uS[e] > 0);
+  }
+
+  std::size_t iSize = rStrikes.size();
+  rValues.price.resize(iSize);
+  rValues.delta.resize(iSize);
+  rValues.gamma.resize(iSize);
+  rValues.vega.resize(iSize);
+
+  auto uKernel = [&](std::size_t iBegin, std::size_t iEnd)
+  {
+    double uChunkF[options::c_iChunk];
+    double uChunkD[options::c_iChunk];
+    double uChunkS[options::c_iChunk];
+    double uChunkRoot[options::c_iChunk];
+    double uPhi[options::c_iChunk];
+    double uD1[options::c_iChunk];
+    double uN1[options::c_iChunk];
+    double uN2[options::c_iChunk];
+    for (std::size_t iStart = iBegin; iStart < iEnd; iStart += options::c_iChunk)
+    {
+      std::size_t iChunk = std::min(options::c_iChunk, iEnd - iStart);
+      const double *pK = rStrikes.data() + iStart;
+      double *pPrice = rValues.price.data() + iStart;
+      double *pDelta = rValues.delta.data() + iStart;
+      double *pGamma = rValues.gamma.data() + iStart;
+      double *pVega = rValues.vega.data() + iStart;
+
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        unsigned e = uIndex[iStart + p];
+        uChunkF[p] = uF[e];
+        uChunkD[p] = uD[e];
+        uChunkS[p] = uS[e];
+        uChunkRoot[p] = uRoot[e];
+        uPhi[p] = (rPayoffs[iStart + p] == Payoff::call) ? 1. : -1.;
+      }
+
+      // the vectorized loops
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uD1[p] = std::log(uChunkF[p] / pK[p]) / uChunkS[p] + 0.5 * uChunkS[p];
+      }
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uN1[p] = options::normal(uPhi[p] * uD1[p]);
+        uN2[p] = options::normal(uPhi[p] * (uD1[p] - uChunkS[p]));
+        pGamma[p] = options::density(uD1[p]);
+      }
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        double dD = uChunkD[p];
+        double dF = uChunkF[p];
+        double dDensity = pGamma[p];
+        pPrice[p] = uPhi[p] * dD * (dF * uN1[p] - pK[p] * uN2[p]);
+        pDelta[p] = uPhi[p] * dD * uN1[p];
+        pGamma[p] = dD * dDensity / (dF * uChunkS[p]);
+        pVega[p] = dD * dF * dDensity * uChunkRoot[p];
+      }
+    }
+  };
+  options::parallel(iSize, m_iThreads, uKernel);
+}
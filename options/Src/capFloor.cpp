@@ -0,0 +1,97 @@
+#include "options/options.hpp"
+#include "prepExam/prepExam.hpp"
+#include "prep1/prep1.hpp"
+#include "header.hpp"
+#include <numeric>
+
+vega::CapFloor::CapFloor(double dNotional, double dPeriod, unsigned iNumberOfPayments,
+                         const std::function<double(double)> &rDiscount,
+                         const std::function<double(double)> &rVolatility,
+                         double dInitialTime, unsigned iThreads)
+    : m_uLogLibor(iNumberOfPayments), m_uLibor(iNumberOfPayments),
+      m_uWeight(iNumberOfPayments), m_uDeviation(iNumberOfPayments), m_iThreads(iThreads)
+{
+  PRECONDITION(dPeriod > 0);
+  PRECONDITION(iNumberOfPayments > 0);
+
+  // the schedule is evaluated once for all rates and maturities
+  std::function<double(double)> uLibor = forwardLibor(dPeriod, rDiscount);
+  for (unsigned i = 0; i < iNumberOfPayments; i++)
+  {
+    double dT = dInitialTime + (i + 1) * dPeriod;
+    m_uLibor[i] = uLibor(dT);
+    PRECONDITION(m_uLibor[i] > 0);
+    m_uLogLibor[i] = std::log(m_uLibor[i]);
+    m_uWeight[i] = dNotional * dPeriod * rDiscount(dT + dPeriod);
+    m_uDeviation[i] = rVolatility(dT) * std::sqrt(dT - dInitialTime);
+    PRECONDITION(m_uDeviation[i] > 0);
+  }
+}
+
+std::vector<double> vega::CapFloor::operator()(const std::vector<double> &rRates, Payoff ePayoff) const
+{
+  PRECONDITION(std::all_of(rRates.begin(), rRates.end(), [](double dK)
+                           { return dK > 0; }));
+
+  std::size_t iN = m_uLibor.size();
+  std::vector<double> uValues(rRates.size() * iN);
+  double dPhi = (ePayoff == Payoff::call) ? 1. : -1.;
+
+  // the rows of rates are split between the threads
+  auto uKernel = [&](std::size_t iBegin, std::size_t iEnd)
+  {
+    double uD1[options::c_iChunk];
+    for (std::size_t j = iBegin; j < iEnd; j++)
+    {
+      double dK = rRates[j];
+      double dLogK = std::log(dK);
+      double *pRow = uValues.data() + j * iN;
+      for (std::size_t iStart = 0; iStart < iN; iStart += options::c_iChunk)
+      {
+        std::size_t iChunk = std::min(options::c_iChunk, iN - iStart);
+        const double *pLogL = m_uLogLibor.data() + iStart;
+        const double *pL = m_uLibor.data() + iStart;
+        const double *pW = m_uWeight.data() + iStart;
+        const double *pS = m_uDeviation.data() + iStart;
+        double *pCaplet = pRow + iStart;
+
+        // the vectorized loops
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          uD1[p] = (pLogL[p] - dLogK) / pS[p] + 0.5 * pS[p];
+        }
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          double dN1 = options::normal(dPhi * uD1[p]);
+          double dN2 = options::normal(dPhi * (uD1[p] - pS[p]));
+          pCaplet[p] = dPhi * pW[p] * (pL[p] * dN1 - dK * dN2);
+        }
+      }
+
+      // the caps of all maturities
+      std::partial_sum(pRow, pRow + iN, pRow);
+    }
+  };
+  options::parallel(rRates.size(), m_iThreads, uKernel, iN);
+
+  return uValues;
+}
+
+double vega::CapFloor::operator()(double dRate, unsigned iNumberOfPayments, Payoff ePayoff) const
+{
+  PRECONDITION(dRate > 0);
+  PRECONDITION(iNumberOfPayments > 0 && iNumberOfPayments <= m_uLibor.size());
+
+  double dPhi = (ePayoff == Payoff::call) ? 1. : -1.;
+  double dLogK = std::log(dRate);
+  double dValue = 0.;
+  for (unsigned i = 0; i < iNumberOfPayments; i++)
+  {
+    double dS = m_uDeviation[i];
+    double dD1 = (m_uLogLibor[i] - dLogK) / dS + 0.5 * dS;
+    double dN1 = options::normal(dPhi * dD1);
+    double dN2 = options::normal(dPhi * (dD1 - dS));
+    dValue += dPhi * m_uWeight[i] * (m_uLibor[i] * dN1 - dRate * dN2);
+  }
+  return dValue;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace options
+{
+  // the options that are processed together; their data stays in the
+  // L1 cache
+  const std::size_t c_iChunk = 256;
+  // the minimal number of options of a thread
+  const std::size_t c_iPerThread = 16 * c_iChunk;
+
+  // the standard normal distribution function; in the loops compiled
+  // with -ffast-math, erfc is vectorized by libmvec
+  inline double normal(double dX)
+  {
+    return 0.5 * std::erfc(-M_SQRT1_2 * dX);
+  }
+
+  // the standard normal density
+  inline double density(double dX)
+  {
+    return 0.5 * M_2_SQRTPI * M_SQRT1_2 * std::exp(-0.5 * dX * dX);
+  }
+
+  // the distinct maturities of a book in the order of appearance and
+  // the index of the maturity of every option; the options of a book
+  // are usually grouped by expiry, so the maturity of the previous
+  // option is tried first
+  inline std::vector<double> expiries(const std::vector<double> &rMaturities,
+                                      std::vector<unsigned> &rIndex)
+  {
+    std::vector<double> uExpiries;
+    std::unordered_map<double, unsigned> uFound;
+    rIndex.resize(rMaturities.size());
+    for (std::size_t i = 0; i < rMaturities.size(); i++)
+    {
+      double dT = rMaturities[i];
+      if (i > 0 && dT == rMaturities[i - 1])
+      {
+        rIndex[i] = rIndex[i - 1];
+        continue;
+      }
+      auto uResult = uFound.emplace(dT, uExpiries.size());
+      if (uResult.second)
+      {
+        uExpiries.push_back(dT);
+      }
+      rIndex[i] = uResult.first->second;
+    }
+    return uExpiries;
+  }
+
+  // runs fKernel(iBegin, iEnd) on contiguous ranges of [0, iSize) on
+  // several threads; all hardware threads are used if iThreads is 0;
+  // an item costs as much as iWork options
+  template <class F>
+  void parallel(std::size_t iSize, unsigned iThreads, const F &fKernel, std::size_t iWork = 1)
+  {
+    if (iThreads == 0)
+    {
+      iThreads = std::thread::hardware_concurrency();
+    }
+    std::size_t iMax = std::max<std::size_t>(iSize * iWork / c_iPerThread, 1);
+    iThreads = std::max<std::size_t>(std::min<std::size_t>(iThreads, iMax), 1);
+
+    auto uWork = [iSize, iThreads, &fKernel](unsigned iThread)
+    {
+      fKernel(iSize * iThread / iThreads, iSize * (iThread + 1) / iThreads);
+    };
+    std::vector<std::thread> uThreads;
+    for (unsigned t = 1; t < iThreads; t++)
+    {
+      uThreads.emplace_back(uWork, t);
+    }
+    uWork(0);
+    for (std::thread &rThread : uThreads)
+    {
+      rThread.join();
+    }
+  }
+} // namespace options
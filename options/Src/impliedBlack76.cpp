@@ -0,0 +1,170 @@
+#include "options/options.hpp"
+#include "prep1/prep1.hpp"
+#include "header.hpp"
+#include <cfloat>
+
+namespace impliedBlack76
+{
+  // an iteration decreases s at most by this factor, so s stays positive
+  const double c_dShrink = 1E-3;
+}
+
+vega::ImpliedBlack76::ImpliedBlack76(const std::function<double(double)> &rForward,
+                                     const std::function<double(double)> &rDiscount,
+                                     double dInitialTime, unsigned iIterations,
+                                     unsigned iThreads)
+    : m_uForward(rForward), m_uDiscount(rDiscount), m_dInitialTime(dInitialTime),
+      m_iIterations(iIterations), m_iThreads(iThreads)
+{
+}
+
+std::vector<double> vega::ImpliedBlack76::operator()(const std::vector<double> &rPrices,
+                                                     const std::vector<double> &rStrikes,
+                                                     const std::vector<double> &rMaturities,
+                                                     const std::vector<Payoff> &rPayoffs) const
+{
+  std::vector<double> uVols;
+  (*this)(rPrices, rStrikes, rMaturities, rPayoffs, uVols);
+  return uVols;
+}
+
+void vega::ImpliedBlack76::operator()(const std::vector<double> &rPrices,
+                                      const std::vector<double> &rStrikes,
+                                      const std::vector<double> &rMaturities,
+                                      const std::vector<Payoff> &rPayoffs,
+                                      std::vector<double> &rVols) const
+{
+  PRECONDITION(rPrices.size() == rStrikes.size());
+  PRECONDITION(rPrices.size() == rMaturities.size());
+  PRECONDITION(rPrices.size() == rPayoffs.size());
+
+  // the curves at the distinct maturities
+  std::vector<unsigned> uIndex;
+  std::vector<double> uExpiries = options::expiries(rMaturities, uIndex);
+  std::vector<double> uF(uExpiries.size());
+  std::vector<double> uD(uExpiries.size());
+  std::vector<double> uRoot(uExpiries.size());
+  for (unsigned e = 0; e < uExpiries.size(); e++)
+  {
+    double dT = uExpiries[e];
+    PRECONDITION(dT > m_dInitialTime);
+    uF[e] = m_uForward(dT);
+    uD[e] = m_uDiscount(dT);
+    uRoot[e] = std::sqrt(dT - m_dInitialTime);
+  }
+
+  std::size_t iSize = rPrices.size();
+  rVols.resize(iSize);
+
+  auto uKernel = [&](std::size_t iBegin, std::size_t iEnd)
+  {
+    double uPhi[options::c_iChunk];
+    double uChunkRoot[options::c_iChunk];
+    double uX[options::c_iChunk];
+    double uE[options::c_iChunk];
+    double uBeta[options::c_iChunk];
+    double uLogBeta[options::c_iChunk];
+    double uS[options::c_iChunk];
+    double uN1[options::c_iChunk];
+    double uN2[options::c_iChunk];
+    double uDensity[options::c_iChunk];
+    double uB[options::c_iChunk];
+    double uLogB[options::c_iChunk];
+    for (std::size_t iStart = iBegin; iStart < iEnd; iStart += options::c_iChunk)
+    {
+      std::size_t iChunk = std::min(options::c_iChunk, iEnd - iStart);
+      const double *pV = rPrices.data() + iStart;
+      const double *pK = rStrikes.data() + iStart;
+      double *pVol = rVols.data() + iStart;
+
+      // the log-moneyness and the price normalized by D sqrt(FK)
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        unsigned e = uIndex[iStart + p];
+        uPhi[p] = (rPayoffs[iStart + p] == Payoff::call) ? 1. : -1.;
+        uChunkRoot[p] = uRoot[e];
+        uX[p] = uF[e] / pK[p];
+        uBeta[p] = pV[p] / (uD[e] * std::sqrt(uF[e] * pK[p]));
+      }
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uX[p] = std::log(uX[p]);
+      }
+
+      // the out-of-the-money call with x = -|log(F/K)|: an option in
+      // the money loses its intrinsic value e^{|x|/2} - e^{-|x|/2}
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uE[p] = std::exp(-0.5 * std::abs(uX[p]));
+      }
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uBeta[p] -= (uPhi[p] * uX[p] > 0.) ? 1. / uE[p] - uE[p] : 0.;
+        uX[p] = -std::abs(uX[p]);
+      }
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uLogBeta[p] = std::log(uBeta[p]);
+      }
+
+      // the initial guess
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        double dE = uE[p];
+        double dF = 1. / dE;
+        double dA = uBeta[p] - 0.5 * (dE - dF);
+        double dR = std::max(dA * dA - (dE - dF) * (dE - dF) / M_PI, 0.);
+        double dMiller = std::sqrt(2. * M_PI) / (dE + dF) * (dA + std::sqrt(dR));
+        double dTail = -uX[p] / std::sqrt(-2. * std::min(uLogBeta[p], -1.));
+        uS[p] = std::max(std::max(dMiller, dTail), DBL_MIN);
+      }
+
+      // the iterations of Householder for f(s) = log b(x, s) - log beta:
+      // b' = e^{x/2} n(d_1), b''/b' = d_1 d_2 / s = h and
+      // b'''/b' = h^2 - 3 x^2 / s^4 - 1 / 4
+      for (unsigned i = 0; i < m_iIterations; i++)
+      {
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          double dD1 = uX[p] / uS[p] + 0.5 * uS[p];
+          uN1[p] = options::normal(dD1);
+          uN2[p] = options::normal(dD1 - uS[p]);
+          uDensity[p] = options::density(dD1);
+        }
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          uB[p] = uE[p] * uN1[p] - uN2[p] / uE[p];
+        }
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          uLogB[p] = std::log(uB[p]);
+        }
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          double dS = uS[p];
+          double dX = uX[p];
+          double dD1 = dX / dS + 0.5 * dS;
+          double dH = dD1 * (dD1 - dS) / dS;
+          double dH3 = dH * dH - 3. * dX * dX / (dS * dS * dS * dS) - 0.25;
+          // the derivatives of f divided by f'
+          double dG = uE[p] * uDensity[p] / uB[p];
+          double dF2 = dH - dG;
+          double dF3 = dH3 - 3. * dG * dH + 2. * dG * dG;
+          double dNewton = (uLogBeta[p] - uLogB[p]) / dG;
+          double dStep = dNewton * (1. + 0.5 * dF2 * dNewton) /
+                         (1. + dF2 * dNewton + dF3 * dNewton * dNewton / 6.);
+          uS[p] = std::max(dS + dStep, impliedBlack76::c_dShrink * dS);
+        }
+      }
+
+      // the prices outside of the bounds 0 < beta < e^{x/2} have no
+      // implied volatility
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        bool bArbitrage = !(uBeta[p] > 0.) || !(uBeta[p] < uE[p]);
+        pVol[p] = bArbitrage ? 0. : uS[p] / uChunkRoot[p];
+      }
+    }
+  };
+  options::parallel(iSize, m_iThreads, uKernel);
+}
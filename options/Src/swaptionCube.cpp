@@ -0,0 +1,135 @@
+#include "options/options.hpp"
+#include "prep1/prep1.hpp"
+#include "header.hpp"
+
+vega::SwaptionCube::SwaptionCube(const std::vector<double> &rExpiries,
+                                 const std::vector<unsigned> &rTenors, double dPeriod,
+                                 const std::function<double(double)> &rDiscount,
+                                 double dInitialTime, unsigned iThreads)
+    : m_uRates(rExpiries.size() * rTenors.size()),
+      m_uAnnuities(rExpiries.size() * rTenors.size()), m_uRoots(rExpiries.size()),
+      m_iTenors(rTenors.size()), m_iThreads(iThreads)
+{
+  PRECONDITION(dPeriod > 0);
+  PRECONDITION(!rTenors.empty());
+  PRECONDITION(std::all_of(rTenors.begin(), rTenors.end(), [](unsigned n)
+                           { return n > 0; }));
+
+  unsigned iMax = *std::max_element(rTenors.begin(), rTenors.end());
+
+  // one pass over the discount factors of an expiry gives the swap
+  // rates and the annuities of all tenors
+  auto uKernel = [&](std::size_t iBegin, std::size_t iEnd)
+  {
+    std::vector<double> uD(iMax + 1);
+    std::vector<double> uSum(iMax + 1);
+    for (std::size_t e = iBegin; e < iEnd; e++)
+    {
+      double dT = rExpiries[e];
+      PRECONDITION(dT > dInitialTime);
+      m_uRoots[e] = std::sqrt(dT - dInitialTime);
+      uD[0] = rDiscount(dT);
+      uSum[0] = 0.;
+      for (unsigned i = 1; i <= iMax; i++)
+      {
+        uD[i] = rDiscount(dT + i * dPeriod);
+        uSum[i] = uSum[i - 1] + uD[i];
+      }
+      for (unsigned k = 0; k < m_iTenors; k++)
+      {
+        unsigned n = rTenors[k];
+        double dAnnuity = dPeriod * uSum[n];
+        m_uAnnuities[e * m_iTenors + k] = dAnnuity;
+        m_uRates[e * m_iTenors + k] = (uD[0] - uD[n]) / dAnnuity;
+      }
+    }
+  };
+  options::parallel(rExpiries.size(), m_iThreads, uKernel, iMax);
+}
+
+std::vector<double> vega::SwaptionCube::operator()(const std::vector<double> &rSpreads,
+                                                   const std::vector<double> &rVols,
+                                                   SwaptionModel eModel, Payoff ePayoff) const
+{
+  std::size_t iStrikes = rSpreads.size();
+  std::size_t iPlane = m_iTenors * iStrikes;
+  PRECONDITION(rVols.size() == m_uRoots.size() * iPlane);
+  PRECONDITION(eModel == SwaptionModel::bachelier ||
+               *std::min_element(m_uRates.begin(), m_uRates.end()) +
+                       *std::min_element(rSpreads.begin(), rSpreads.end()) >
+                   0);
+
+  std::vector<double> uValues(rVols.size());
+  double dPhi = (ePayoff == Payoff::call) ? 1. : -1.;
+  bool bBlack = (eModel == SwaptionModel::black);
+
+  // the expiries are split between the threads; the tenors and the
+  // strikes of an expiry are processed in chunks
+  auto uKernel = [&](std::size_t iBegin, std::size_t iEnd)
+  {
+    double uS[options::c_iChunk];
+    double uA[options::c_iChunk];
+    double uK[options::c_iChunk];
+    double uDev[options::c_iChunk];
+    double uD[options::c_iChunk];
+    for (std::size_t e = iBegin; e < iEnd; e++)
+    {
+      const double *pRate = m_uRates.data() + e * m_iTenors;
+      const double *pAnnuity = m_uAnnuities.data() + e * m_iTenors;
+      double dRoot = m_uRoots[e];
+      for (std::size_t iStart = 0; iStart < iPlane; iStart += options::c_iChunk)
+      {
+        std::size_t iChunk = std::min(options::c_iChunk, iPlane - iStart);
+        const double *pVol = rVols.data() + e * iPlane + iStart;
+        double *pValue = uValues.data() + e * iPlane + iStart;
+
+        for (std::size_t p = 0; p < iChunk; p++)
+        {
+          std::size_t k = (iStart + p) / iStrikes;
+          uS[p] = pRate[k];
+          uA[p] = pAnnuity[k];
+          uK[p] = uS[p] + rSpreads[(iStart + p) - k * iStrikes];
+          uDev[p] = pVol[p] * dRoot;
+        }
+
+        // the vectorized loops
+        if (bBlack)
+        {
+          for (std::size_t p = 0; p < iChunk; p++)
+          {
+            uD[p] = std::log(uS[p] / uK[p]) / uDev[p] + 0.5 * uDev[p];
+          }
+          for (std::size_t p = 0; p < iChunk; p++)
+          {
+            double dN1 = options::normal(dPhi * uD[p]);
+            double dN2 = options::normal(dPhi * (uD[p] - uDev[p]));
+            pValue[p] = dPhi * uA[p] * (uS[p] * dN1 - uK[p] * dN2);
+          }
+        }
+        else
+        {
+          for (std::size_t p = 0; p < iChunk; p++)
+          {
+            double dDiff = dPhi * (uS[p] - uK[p]);
+            double dD = dDiff / uDev[p];
+            pValue[p] = uA[p] * (dDiff * options::normal(dD) +
+                                 uDev[p] * options::density(dD));
+          }
+        }
+      }
+    }
+  };
+  options::parallel(m_uRoots.size(), m_iThreads, uKernel, iPlane);
+
+  return uValues;
+}
+
+const std::vector<double> &vega::SwaptionCube::rates() const
+{
+  return m_uRates;
+}
+
+const std::vector<double> &vega::SwaptionCube::annuities() const
+{
+  return m_uAnnuities;
+}
@@ -0,0 +1,620 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "options/Output.hpp"
+#include "options/options.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+
+using namespace test;
+using namespace std;
+
+namespace NOptions
+{
+  const double c_dSpot = 100.;
+  const double c_dInitialTime = 1.;
+
+  // the data curves of the examples
+  class Curves
+  {
+  public:
+    std::function<double(double)> forward;
+    std::function<double(double)> discount;
+    std::function<double(double)> volatility;
+  };
+
+  Curves curves()
+  {
+    auto uF = getForward(c_dSpot, c_dInitialTime);
+    auto uDF = getDiscount(c_dInitialTime);
+    Curves uCurves;
+    uCurves.forward = vega::forwardCarryLinInterp(c_dSpot, uF.first, uF.second, c_dInitialTime);
+    uCurves.discount = vega::discountLogLinInterp(uDF.first, uDF.second, c_dInitialTime);
+    uCurves.volatility = vega::volatilityBlack(0.3, 0.2, c_dInitialTime);
+    return uCurves;
+  }
+
+  // the Black formula for the total standard deviation s
+  double black(double dF, double dD, double dK, double dS, vega::Payoff ePayoff)
+  {
+    double dD1 = std::log(dF / dK) / dS + 0.5 * dS;
+    double dPhi = (ePayoff == vega::Payoff::call) ? 1. : -1.;
+    double dN1 = 0.5 * std::erfc(-dPhi * dD1 / std::sqrt(2.));
+    double dN2 = 0.5 * std::erfc(-dPhi * (dD1 - dS) / std::sqrt(2.));
+    return dPhi * dD * (dF * dN1 - dK * dN2);
+  }
+
+  // the scalar Black formula as in the loops of the desks: the curves
+  // are evaluated for every option
+  double price(const Curves &rCurves, double dK, double dT, vega::Payoff ePayoff)
+  {
+    double dS = rCurves.volatility(dT) * std::sqrt(dT - c_dInitialTime);
+    return black(rCurves.forward(dT), rCurves.discount(dT), dK, dS, ePayoff);
+  }
+
+  // the reference implied volatility: the bisection of the scalar
+  // Black formula until the interval can not be divided
+  double implied(const Curves &rCurves, double dPrice, double dK, double dT, vega::Payoff ePayoff)
+  {
+    double dF = rCurves.forward(dT);
+    double dD = rCurves.discount(dT);
+    double dRoot = std::sqrt(dT - c_dInitialTime);
+    double dLow = 0.;
+    double dHigh = 5.;
+    double dMiddle = 0.5 * (dLow + dHigh);
+    while (dLow < dMiddle && dMiddle < dHigh)
+    {
+      if (black(dF, dD, dK, dMiddle * dRoot, ePayoff) < dPrice)
+      {
+        dLow = dMiddle;
+      }
+      else
+      {
+        dHigh = dMiddle;
+      }
+      dMiddle = 0.5 * (dLow + dHigh);
+    }
+    return dMiddle;
+  }
+
+  // the maximal difference relative to the scale
+  double difference(const std::vector<double> &rX, const std::vector<double> &rY, double dScale)
+  {
+    double dDifference = 0.;
+    for (unsigned i = 0; i < rX.size(); i++)
+    {
+      dDifference = std::max(dDifference, std::abs(rX[i] - rY[i]) / dScale);
+    }
+    return dDifference;
+  }
+} // namespace NOptions
+
+void black76()
+{
+  print("PRICES AND SENSITIVITIES OF OPTIONS");
+
+  NOptions::Curves uCurves = NOptions::curves();
+  vega::Black76 uEngine(uCurves.forward, uCurves.discount, uCurves.volatility, NOptions::c_dInitialTime);
+
+  std::vector<double> uK, uT;
+  for (double dT : {1.5, 3., 5.})
+  {
+    for (double dK : {80., 100., 120.})
+    {
+      uK.push_back(dK);
+      uT.push_back(dT);
+    }
+  }
+  std::vector<vega::Payoff> uCalls(uK.size(), vega::Payoff::call);
+  std::vector<vega::Payoff> uPuts(uK.size(), vega::Payoff::put);
+  vega::OptionValues uCall = uEngine(uK, uT, uCalls);
+  vega::OptionValues uPut = uEngine(uK, uT, uPuts);
+  printTable({uK, uT, uCall.price, uPut.price, uCall.delta, uCall.gamma, uCall.vega},
+             {"strike", "maturity", "call", "put", "delta", "gamma", "vega"},
+             "calls and puts", 10, 3, uK.size());
+
+  // put-call parity: C - P = D(t)(F(t) - K)
+  double dParity = 0.;
+  for (unsigned i = 0; i < uK.size(); i++)
+  {
+    double dForward = uCurves.discount(uT[i]) * (uCurves.forward(uT[i]) - uK[i]);
+    dParity = std::max(dParity, std::abs(uCall.price[i] - uPut.price[i] - dForward));
+  }
+  print(dParity, "maximal error of put-call parity", true);
+
+  // the sensitivities against central differences of bumped curves
+  double dH = 1E-4;
+  auto uBumped = [&uCurves](double dForward, double dVol)
+  {
+    NOptions::Curves uCurve = uCurves;
+    uCurve.forward = [uCurves, dForward](double dT)
+    { return uCurves.forward(dT) * dForward; };
+    uCurve.volatility = [uCurves, dVol](double dT)
+    { return uCurves.volatility(dT) + dVol; };
+    return vega::Black76(uCurve.forward, uCurve.discount, uCurve.volatility, NOptions::c_dInitialTime);
+  };
+  vega::OptionValues uUp = uBumped(1. + dH, 0.)(uK, uT, uCalls);
+  vega::OptionValues uDown = uBumped(1. - dH, 0.)(uK, uT, uCalls);
+  vega::OptionValues uVolUp = uBumped(1., dH)(uK, uT, uCalls);
+  vega::OptionValues uVolDown = uBumped(1., -dH)(uK, uT, uCalls);
+  double dDelta = 0., dGamma = 0., dVega = 0.;
+  for (unsigned i = 0; i < uK.size(); i++)
+  {
+    double dStep = dH * uCurves.forward(uT[i]);
+    dDelta = std::max(dDelta, std::abs((uUp.price[i] - uDown.price[i]) / (2. * dStep) - uCall.delta[i]));
+    dGamma = std::max(dGamma, std::abs((uUp.delta[i] - uDown.delta[i]) / (2. * dStep) - uCall.gamma[i]));
+    dVega = std::max(dVega, std::abs((uVolUp.price[i] - uVolDown.price[i]) / (2. * dH) - uCall.vega[i]));
+  }
+  print(dDelta, "maximal error of delta against central differences");
+  print(dGamma, "maximal error of gamma against central differences");
+  print(dVega, "maximal error of vega against central differences", true);
+}
+
+void batchPricing()
+{
+  print("BATCH PRICING OF A BOOK OF OPTIONS");
+
+  NOptions::Curves uCurves = NOptions::curves();
+  unsigned iOptions = 1000000;
+  unsigned iExpiries = 40;
+  print(iOptions, "options");
+  print(iExpiries, "monthly expiries", true);
+
+  // the book is grouped by expiry
+  std::valarray<double> uRandK = getRandArg(50., 150., iOptions);
+  std::valarray<double> uRandType = getRandArg(0., 1., iOptions);
+  std::vector<double> uK(std::begin(uRandK), std::end(uRandK));
+  std::vector<double> uT(iOptions);
+  std::vector<vega::Payoff> uPayoffs(iOptions);
+  for (unsigned i = 0; i < iOptions; i++)
+  {
+    uT[i] = NOptions::c_dInitialTime + (1 + i * iExpiries / iOptions) / 12.;
+    uPayoffs[i] = (uRandType[i] < 0.5) ? vega::Payoff::call : vega::Payoff::put;
+  }
+
+  vega::Black76 uEngine(uCurves.forward, uCurves.discount, uCurves.volatility, NOptions::c_dInitialTime);
+  vega::Black76 uSingle(uCurves.forward, uCurves.discount, uCurves.volatility, NOptions::c_dInitialTime, 1);
+  std::vector<double> uScalar(iOptions);
+  for (unsigned i = 0; i < iOptions; i++)
+  {
+    uScalar[i] = NOptions::price(uCurves, uK[i], uT[i], uPayoffs[i]);
+  }
+  vega::OptionValues uValues = uEngine(uK, uT, uPayoffs);
+  print(NOptions::difference(uValues.price, uScalar, NOptions::c_dSpot),
+        "maximal difference of batch and scalar prices per unit of spot");
+  print(NOptions::difference(uValues.price, uSingle(uK, uT, uPayoffs).price, NOptions::c_dSpot),
+        "maximal difference of one and all threads", true);
+
+  std::vector<Measurement> uTimes;
+  uTimes.push_back(measure([&uCurves, &uK, &uT, &uPayoffs, &uScalar]()
+                           {
+                             for (unsigned i = 0; i < uK.size(); i++)
+                             {
+                               uScalar[i] = NOptions::price(uCurves, uK[i], uT[i], uPayoffs[i]);
+                             } },
+                           "black76", "scalar", iExpiries, iOptions));
+  uTimes.push_back(measure([&uSingle, &uK, &uT, &uPayoffs, &uValues]()
+                           { uSingle(uK, uT, uPayoffs, uValues); },
+                           "black76", "batch, one thread", iExpiries, iOptions));
+  uTimes.push_back(measure([&uEngine, &uK, &uT, &uPayoffs, &uValues]()
+                           { uEngine(uK, uT, uPayoffs, uValues); },
+                           "black76", "batch, all threads", iExpiries, iOptions));
+  // the times depend on the machine
+  printBench(uTimes, "scalar prices and batch prices with sensitivities");
+  print("row 0: scalar prices, the curves are evaluated for every option");
+  print("row 1: batch on one thread");
+  print("row 2: batch on all threads");
+  out() << endl;
+}
+
+void impliedVolatility()
+{
+  print("IMPLIED VOLATILITIES OF MARKET OPTIONS");
+
+  NOptions::Curves uCurves = NOptions::curves();
+  auto uVol = getVol(NOptions::c_dInitialTime);
+  std::function<double(double)> uMarket =
+      vega::volatilityVarLinInterp(uVol.first, uVol.second, NOptions::c_dInitialTime);
+
+  // at-the-money calls, in-the-money puts and out-of-the-money calls
+  std::vector<double> uK, uT;
+  std::vector<vega::Payoff> uPayoffs;
+  for (double dT : uVol.first)
+  {
+    double dF = uCurves.forward(dT);
+    for (double dMoney : {1., 0.9, 1.1})
+    {
+      uK.push_back(dF * dMoney);
+      uT.push_back(dT);
+      uPayoffs.push_back((dMoney < 1.) ? vega::Payoff::put : vega::Payoff::call);
+    }
+  }
+  vega::Black76 uEngine(uCurves.forward, uCurves.discount, uMarket, NOptions::c_dInitialTime);
+  std::vector<double> uPrices = uEngine(uK, uT, uPayoffs).price;
+  vega::ImpliedBlack76 uImplied(uCurves.forward, uCurves.discount, NOptions::c_dInitialTime);
+  std::vector<double> uVols = uImplied(uPrices, uK, uT, uPayoffs);
+
+  double dError = 0.;
+  std::vector<double> uTimes, uAtTheMoney, uInput;
+  for (unsigned i = 0; i < uK.size(); i++)
+  {
+    dError = std::max(dError, std::abs(uVols[i] - uMarket(uT[i])));
+    if (i % 3 == 0)
+    {
+      uTimes.push_back(uT[i]);
+      uAtTheMoney.push_back(uVols[i]);
+      uInput.push_back(uMarket(uT[i]));
+    }
+  }
+  printTable({uTimes, uInput, uAtTheMoney}, {"maturity", "market vol", "implied vol"},
+             "implied volatilities of at-the-money calls", 12, 3, uTimes.size());
+  print(dError, "maximal error of implied volatilities of all options", true);
+
+  // a call below its intrinsic value has no implied volatility
+  double dT = uVol.first.front();
+  double dIntrinsic = uCurves.discount(dT) * (uCurves.forward(dT) - 90.);
+  print(uImplied({0.5 * dIntrinsic}, {90.}, {dT}, {vega::Payoff::call}).front(),
+        "implied volatility of a call at half of its intrinsic value", true);
+
+  // the implied volatilities are the inputs of volatilityVarLinInterp
+  std::function<double(double)> uCurve =
+      vega::volatilityVarLinInterp(uTimes, uAtTheMoney, NOptions::c_dInitialTime);
+  print("volatility curve from implied volatilities:");
+  test::print(uCurve, NOptions::c_dInitialTime, uTimes.back() - NOptions::c_dInitialTime);
+}
+
+void batchImplied()
+{
+  print("BATCH IMPLIED VOLATILITIES");
+
+  NOptions::Curves uCurves = NOptions::curves();
+  unsigned iOptions = 100000;
+  unsigned iExpiries = 40;
+  print(iOptions, "options");
+  print(iExpiries, "monthly expiries", true);
+
+  // volatilities from 5% to 80% and strikes within 4 standard
+  // deviations from the forward price
+  std::valarray<double> uRandVol = getRandArg(0.05, 0.8, iOptions);
+  std::valarray<double> uRandZ = getRandArg(-4., 4., iOptions);
+  std::valarray<double> uRandType = getRandArg(0., 1., iOptions);
+  std::vector<double> uK(iOptions), uT(iOptions), uPrices(iOptions);
+  std::vector<vega::Payoff> uPayoffs(iOptions);
+  for (unsigned i = 0; i < iOptions; i++)
+  {
+    uT[i] = NOptions::c_dInitialTime + (1 + i * iExpiries / iOptions) / 12.;
+    double dF = uCurves.forward(uT[i]);
+    double dS = uRandVol[i] * std::sqrt(uT[i] - NOptions::c_dInitialTime);
+    uK[i] = dF * std::exp(uRandZ[i] * dS);
+    uPayoffs[i] = (uRandType[i] < 0.5) ? vega::Payoff::call : vega::Payoff::put;
+    uPrices[i] = NOptions::black(dF, uCurves.discount(uT[i]), uK[i], dS, uPayoffs[i]);
+  }
+
+  std::vector<double> uReference(iOptions);
+  double dReference = 0.;
+  for (unsigned i = 0; i < iOptions; i++)
+  {
+    uReference[i] = NOptions::implied(uCurves, uPrices[i], uK[i], uT[i], uPayoffs[i]);
+    dReference = std::max(dReference, std::abs(uReference[i] - uRandVol[i]));
+  }
+  print(dReference, "maximal difference of the reference solve and the input volatilities", true);
+
+  std::vector<double> uIterations, uErrors, uResiduals;
+  std::vector<Measurement> uTimes;
+  std::vector<double> uVols(iOptions);
+  for (unsigned iIterations = 2; iIterations <= 5; iIterations++)
+  {
+    vega::ImpliedBlack76 uImplied(uCurves.forward, uCurves.discount, NOptions::c_dInitialTime,
+                                  iIterations, 1);
+    uImplied(uPrices, uK, uT, uPayoffs, uVols);
+    uIterations.push_back(iIterations);
+    uErrors.push_back(NOptions::difference(uVols, uReference, 1.));
+    double dResidual = 0.;
+    for (unsigned i = 0; i < iOptions; i++)
+    {
+      double dS = uVols[i] * std::sqrt(uT[i] - NOptions::c_dInitialTime);
+      double dPrice = NOptions::black(uCurves.forward(uT[i]), uCurves.discount(uT[i]), uK[i], dS, uPayoffs[i]);
+      dResidual = std::max(dResidual, std::abs(dPrice - uPrices[i]) / NOptions::c_dSpot);
+    }
+    uResiduals.push_back(dResidual);
+    uTimes.push_back(measure([&uImplied, &uPrices, &uK, &uT, &uPayoffs, &uVols]()
+                             { uImplied(uPrices, uK, uT, uPayoffs, uVols); },
+                             "impliedBlack76", "one thread", iExpiries, iOptions));
+  }
+  // the options far in the money are ill-conditioned: their prices
+  // determine the volatilities only up to about 1e-10
+  printTable({uIterations, uErrors, uResiduals}, {"iterations", "vol error", "price error"},
+             "errors against the reference solve and of repricing per unit of spot", 12, 3,
+             uIterations.size());
+
+  vega::ImpliedBlack76 uImplied(uCurves.forward, uCurves.discount, NOptions::c_dInitialTime);
+  uTimes.push_back(measure([&uImplied, &uPrices, &uK, &uT, &uPayoffs, &uVols]()
+                           { uImplied(uPrices, uK, uT, uPayoffs, uVols); },
+                           "impliedBlack76", "all threads", iExpiries, iOptions));
+  double dReferenceSum = 0.;
+  uTimes.push_back(measure([&uCurves, &uPrices, &uK, &uT, &uPayoffs, &dReferenceSum]()
+                           {
+                             for (unsigned i = 0; i < uK.size(); i++)
+                             {
+                               dReferenceSum += NOptions::implied(uCurves, uPrices[i], uK[i], uT[i], uPayoffs[i]);
+                             } },
+                           "impliedBlack76", "bisection", iExpiries, iOptions));
+  keepAlive(dReferenceSum);
+  // the times depend on the machine
+  printBench(uTimes, "implied volatilities");
+  print("rows 0-3: 2 to 5 iterations on one thread");
+  print("row 4: 4 iterations on all threads");
+  print("row 5: the reference solve by bisection");
+  out() << endl;
+}
+
+void capFloor()
+{
+  print("CAPS AND FLOORS");
+
+  double dInitialTime = NOptions::c_dInitialTime;
+  auto uDF = getDiscount(dInitialTime);
+  std::function<double(double)> uDiscount =
+      vega::discountLogLinInterp(uDF.first, uDF.second, dInitialTime);
+  std::function<double(double)> uVol = vega::volatilityBlack(0.2, 0.1, dInitialTime);
+  CashFlow uCap;
+  uCap.notional = 100.;
+  uCap.period = 0.25;
+  uCap.numberOfPayments = 19;
+  print(uCap.notional, "notional");
+  print(uCap.period, "period");
+  print(uCap.numberOfPayments, "maximal number of payments", true);
+
+  vega::CapFloor uEngine(uCap.notional, uCap.period, uCap.numberOfPayments, uDiscount, uVol,
+                         dInitialTime);
+  std::vector<double> uRates = {0.05, 0.07};
+  std::vector<double> uCaps = uEngine(uRates, vega::Payoff::call);
+  std::vector<double> uFloors = uEngine(uRates, vega::Payoff::put);
+  unsigned iN = uCap.numberOfPayments;
+  std::vector<std::vector<double>> uColumns(5);
+  for (unsigned m = 1; m <= iN; m++)
+  {
+    uColumns[0].push_back(m);
+    uColumns[1].push_back(uCaps[m - 1]);
+    uColumns[2].push_back(uCaps[iN + m - 1]);
+    uColumns[3].push_back(uFloors[m - 1]);
+    uColumns[4].push_back(uFloors[iN + m - 1]);
+  }
+  printTable(uColumns, {"payments", "cap 5%", "cap 7%", "floor 5%", "floor 7%"},
+             "caps and floors for all maturities", 10, 3, iN);
+
+  // cap - floor = forward swap with the fixed rate K, and the cumulative
+  // sums agree with the caps valued one by one
+  std::function<double(double)> uLibor = vega::forwardLibor(uCap.period, uDiscount);
+  double dParity = 0.;
+  double dSums = 0.;
+  for (unsigned j = 0; j < uRates.size(); j++)
+  {
+    double dSwap = 0.;
+    for (unsigned m = 1; m <= iN; m++)
+    {
+      double dT = dInitialTime + m * uCap.period;
+      dSwap += uCap.notional * uCap.period * uDiscount(dT + uCap.period) * (uLibor(dT) - uRates[j]);
+      double dCap = uCaps[j * iN + m - 1];
+      dParity = std::max(dParity, std::abs(dCap - uFloors[j * iN + m - 1] - dSwap));
+      dSums = std::max(dSums, std::abs(dCap - uEngine(uRates[j], m, vega::Payoff::call)));
+    }
+  }
+  print(dParity, "maximal error of cap-floor parity");
+  print(dSums, "maximal difference of cumulative sums and single caps", true);
+
+  // many rates: the desks value every cap separately from the curves
+  unsigned iRates = 2000;
+  std::valarray<double> uRand = getRandArg(0.01, 0.12, iRates);
+  std::vector<double> uManyRates(std::begin(uRand), std::end(uRand));
+  print(iRates, "random cap rates", true);
+  std::vector<Measurement> uTimes;
+  double dSum = 0.;
+  uTimes.push_back(measure([&]()
+                           {
+                             for (double dK : uManyRates)
+                             {
+                               for (unsigned m = 1; m <= iN; m++)
+                               {
+                                 for (unsigned i = 1; i <= m; i++)
+                                 {
+                                   double dT = dInitialTime + i * uCap.period;
+                                   double dS = uVol(dT) * std::sqrt(dT - dInitialTime);
+                                   double dD = uCap.notional * uCap.period * uDiscount(dT + uCap.period);
+                                   dSum += NOptions::black(uLibor(dT), dD, dK, dS, vega::Payoff::call);
+                                 }
+                               }
+                             } },
+                           "capFloor", "scalar", iN, iRates * iN));
+  uTimes.push_back(measure([&]()
+                           {
+                             vega::CapFloor uMany(uCap.notional, uCap.period, uCap.numberOfPayments,
+                                                  uDiscount, uVol, dInitialTime);
+                             dSum += uMany(uManyRates, vega::Payoff::call).back();
+                           },
+                           "capFloor", "batch", iN, iRates * iN));
+  keepAlive(dSum);
+  // the times depend on the machine
+  printBench(uTimes, "caps of all rates and maturities");
+  print("row 0: every cap from the curves");
+  print("row 1: construction of the engine and cumulative sums");
+  out() << endl;
+}
+
+void swaptionCube()
+{
+  print("CUBE OF EUROPEAN SWAPTIONS");
+
+  double dInitialTime = NOptions::c_dInitialTime;
+  auto uDF = getDiscount(dInitialTime);
+  std::function<double(double)> uDiscount =
+      vega::discountLogLinInterp(uDF.first, uDF.second, dInitialTime);
+  double dPeriod = 0.5;
+  std::vector<double> uExpiries = {1.5, 2., 3., 4.};
+  std::vector<unsigned> uTenors = {1, 2, 4, 6};
+  std::vector<double> uSpreads = {-0.01, 0., 0.01};
+  print(dPeriod, "period");
+  print(dInitialTime, "initial time", true);
+
+  vega::SwaptionCube uCube(uExpiries, uTenors, dPeriod, uDiscount, dInitialTime);
+  const std::vector<double> &rRates = uCube.rates();
+  const std::vector<double> &rAnnuities = uCube.annuities();
+
+  // the lognormal smile and the normal volatilities of about the same
+  // level
+  unsigned iPlane = uTenors.size() * uSpreads.size();
+  std::vector<double> uBlackVols(uExpiries.size() * iPlane);
+  std::vector<double> uNormalVols(uBlackVols.size());
+  for (unsigned i = 0; i < uBlackVols.size(); i++)
+  {
+    double dSpread = uSpreads[i % uSpreads.size()];
+    double dRate = rRates[i / uSpreads.size()];
+    uBlackVols[i] = 0.2 + 50. * dSpread * dSpread;
+    uNormalVols[i] = uBlackVols[i] * dRate;
+  }
+  std::vector<double> uBlack =
+      uCube(uSpreads, uBlackVols, vega::SwaptionModel::black, vega::Payoff::call);
+  std::vector<double> uBachelier =
+      uCube(uSpreads, uNormalVols, vega::SwaptionModel::bachelier, vega::Payoff::call);
+
+  std::vector<std::vector<double>> uColumns(6);
+  for (unsigned e = 0; e < uExpiries.size(); e++)
+  {
+    for (unsigned k = 0; k < uTenors.size(); k++)
+    {
+      unsigned iAtm = (e * uTenors.size() + k) * uSpreads.size() + 1;
+      uColumns[0].push_back(uExpiries[e]);
+      uColumns[1].push_back(uTenors[k]);
+      uColumns[2].push_back(rRates[e * uTenors.size() + k]);
+      uColumns[3].push_back(rAnnuities[e * uTenors.size() + k]);
+      uColumns[4].push_back(uBlack[iAtm]);
+      uColumns[5].push_back(uBachelier[iAtm]);
+    }
+  }
+  printTable(uColumns, {"expiry", "payments", "swap rate", "annuity", "Black", "Bachelier"},
+             "rates, annuities and at-the-money payer swaptions", 10, 5, uColumns[0].size());
+
+  // the rates and the annuities agree with the curves of swap rates and
+  // annuities, and payer - receiver = A (S - K) in both models
+  double dRates = 0.;
+  double dAnnuities = 0.;
+  for (unsigned e = 0; e < uExpiries.size(); e++)
+  {
+    double dT = uExpiries[e];
+    for (unsigned k = 0; k < uTenors.size(); k++)
+    {
+      unsigned n = uTenors[k];
+      double dRate = vega::forwardSwapRate(dPeriod, n, uDiscount)(dT);
+      double dAnnuity =
+          vega::forwardAnnuity(1., dPeriod, dT + n * dPeriod, uDiscount, false)(dT) * uDiscount(dT);
+      dRates = std::max(dRates, std::abs(rRates[e * uTenors.size() + k] - dRate));
+      dAnnuities = std::max(dAnnuities, std::abs(rAnnuities[e * uTenors.size() + k] - dAnnuity));
+    }
+  }
+  std::vector<double> uReceivers =
+      uCube(uSpreads, uBlackVols, vega::SwaptionModel::black, vega::Payoff::put);
+  std::vector<double> uNormalReceivers =
+      uCube(uSpreads, uNormalVols, vega::SwaptionModel::bachelier, vega::Payoff::put);
+  double dParity = 0.;
+  for (unsigned i = 0; i < uBlack.size(); i++)
+  {
+    unsigned j = i / uSpreads.size();
+    double dSwap = -rAnnuities[j] * uSpreads[i % uSpreads.size()];
+    dParity = std::max(dParity, std::abs(uBlack[i] - uReceivers[i] - dSwap));
+    dParity = std::max(dParity, std::abs(uBachelier[i] - uNormalReceivers[i] - dSwap));
+  }
+  print(dRates, "maximal difference with forwardSwapRate");
+  print(dAnnuities, "maximal difference with forwardAnnuity");
+  print(dParity, "maximal error of payer-receiver parity", true);
+
+  // the cube of the marking: monthly expiries, quarterly payments
+  double dQuarter = 0.25;
+  std::vector<double> uManyExpiries;
+  for (unsigned m = 1; m <= 36; m++)
+  {
+    uManyExpiries.push_back(dInitialTime + m / 12.);
+  }
+  std::vector<unsigned> uManyTenors;
+  for (unsigned n = 1; n <= 12; n++)
+  {
+    uManyTenors.push_back(n);
+  }
+  std::vector<double> uManySpreads;
+  for (int j = -10; j <= 10; j++)
+  {
+    uManySpreads.push_back(0.001 * j);
+  }
+  unsigned iSize = uManyExpiries.size() * uManyTenors.size() * uManySpreads.size();
+  std::valarray<double> uRand = getRandArg(0.15, 0.35, iSize);
+  std::vector<double> uManyVols(std::begin(uRand), std::end(uRand));
+  print(uManyExpiries.size(), "expiries");
+  print(uManyTenors.size(), "tenors");
+  print(uManySpreads.size(), "strikes", true);
+
+  std::vector<Measurement> uTimes;
+  double dSum = 0.;
+  uTimes.push_back(measure([&]()
+                           {
+                             unsigned i = 0;
+                             for (double dT : uManyExpiries)
+                             {
+                               double dS = std::sqrt(dT - dInitialTime);
+                               for (unsigned n : uManyTenors)
+                               {
+                                 for (double dSpread : uManySpreads)
+                                 {
+                                   double dRate = vega::forwardSwapRate(dQuarter, n, uDiscount)(dT);
+                                   double dAnnuity = vega::forwardAnnuity(1., dQuarter, dT + n * dQuarter,
+                                                                          uDiscount, false)(dT) *
+                                                     uDiscount(dT);
+                                   dSum += NOptions::black(dRate, dAnnuity, dRate + dSpread,
+                                                           uManyVols[i++] * dS, vega::Payoff::call);
+                                 }
+                               }
+                             } },
+                           "swaptionCube", "scalar", iSize, iSize));
+  uTimes.push_back(measure([&]()
+                           {
+                             vega::SwaptionCube uMany(uManyExpiries, uManyTenors, dQuarter, uDiscount,
+                                                      dInitialTime);
+                             dSum += uMany(uManySpreads, uManyVols, vega::SwaptionModel::black,
+                                           vega::Payoff::call)
+                                         .back();
+                           },
+                           "swaptionCube", "batch", iSize, iSize));
+  vega::SwaptionCube uMany(uManyExpiries, uManyTenors, dQuarter, uDiscount, dInitialTime);
+  uTimes.push_back(measure([&]()
+                           { dSum += uMany(uManySpreads, uManyVols, vega::SwaptionModel::black,
+                                           vega::Payoff::call)
+                                         .back(); },
+                           "swaptionCube", "revaluation", iSize, iSize));
+  keepAlive(dSum);
+  // the times depend on the machine
+  printBench(uTimes, "swaptions of the cube");
+  print("row 0: the swap rate and the annuity from the curves for every swaption");
+  print("row 1: construction of the engine and pricing");
+  print("row 2: pricing with new volatilities");
+  out() << endl;
+}
+
+std::function<void()> test_options()
+{
+  return []()
+  {
+    print("PRICING OF EUROPEAN OPTIONS, CAPS, FLOORS AND SWAPTIONS");
+
+    black76();
+    batchPricing();
+    impliedVolatility();
+    batchImplied();
+    capFloor();
+    swaptionCube();
+  };
+}
+
+int main()
+{
+  project(test_options(), PROJECT_NAME, PROJECT_NAME,
+          "Batch pricing and implied volatilities of European options, caps, floors and swaptions");
+}
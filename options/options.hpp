@@ -0,0 +1,429 @@
+#ifndef __vega_options_hpp__
+#define __vega_options_hpp__
+
+/**
+ * @file options.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Batch pricing of European options in the Black model
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaOptions Batch pricing of European options.
+   *
+   * This module prices books of European options from the data
+   * curves: forward prices (forwardCarryLinInterp(),
+   * forwardStockDividends()), discount factors and implied
+   * volatilities (volatilityBlack(), volatilityVarLinInterp()). A book
+   * usually has many options and few expiries, so the curves are
+   * evaluated once for every distinct maturity. The options are then
+   * processed in chunks: the data of the expiries are gathered into
+   * contiguous arrays and the logarithms, exponentials and the normal
+   * distribution function are computed in vectorized loops. Large
+   * books are split between several threads. The inverse problem,
+   * from the prices of options to implied volatilities, is solved in
+   * the same way. Caps and floors are sums of options on forward
+   * LIBORs (forwardLibor()) over one schedule, which is evaluated
+   * once for all strikes and maturities. In the same way, the swap
+   * rates (forwardSwapRate()) and the annuities (forwardAnnuity()) of
+   * all tenors of a swaption with a given expiry come from one pass
+   * over the discount factors of its payment dates.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The type of a European option.
+   */
+  enum class Payoff
+  {
+    /** The call option \f$\max(S_t-K,0)\f$. */
+    call,
+    /** The put option \f$\max(K-S_t,0)\f$. */
+    put
+  };
+
+  /**
+   * @brief The prices and the sensitivities of a book of options.
+   *
+   * The values of the option with index \p i are stored at position
+   * \p i of every vector.
+   */
+  class OptionValues
+  {
+  public:
+    /**
+     * The prices \f$V\f$.
+     */
+    std::vector<double> price;
+
+    /**
+     * The derivatives \f$\partial V/\partial F\f$ in the forward price.
+     */
+    std::vector<double> delta;
+
+    /**
+     * The second derivatives \f$\partial^2 V/\partial F^2\f$ in the
+     * forward price.
+     */
+    std::vector<double> gamma;
+
+    /**
+     * The derivatives \f$\partial V/\partial \Sigma\f$ in the implied
+     * volatility.
+     */
+    std::vector<double> vega;
+  };
+
+  /**
+   * @brief The batch pricing engine for the Black formula.
+   *
+   * For the option with strike \f$K\f$ and maturity \f$t\f$,
+   * \f[
+   *   V = \phi D(t)\left(F(t)N(\phi d_1) - K N(\phi d_2)\right), \quad
+   *   d_{1,2} = \frac{\log(F(t)/K)}{s} \pm \frac{s}{2}, \quad
+   *   s = \Sigma(t)\sqrt{t-t_0},
+   * \f]
+   * where \f$\phi=1\f$ for calls, \f$\phi=-1\f$ for puts and
+   * \f$N\f$ is the standard normal distribution function. The
+   * sensitivities are
+   * \f[
+   *   \frac{\partial V}{\partial F} = \phi D N(\phi d_1), \quad
+   *   \frac{\partial^2 V}{\partial F^2} = \frac{D n(d_1)}{F s}, \quad
+   *   \frac{\partial V}{\partial \Sigma} = D F n(d_1)\sqrt{t-t_0},
+   * \f]
+   * where \f$n=N'\f$ is the standard normal density.
+   */
+  class Black76
+  {
+  public:
+    /**
+     * Constructs the engine.
+     *
+     * @param rForward The forward curve \f$F(t)\f$.
+     * @param rDiscount The discount curve \f$D(t)\f$.
+     * @param rVolatility The implied volatility curve \f$\Sigma(t)\f$.
+     * @param dInitialTime \f$t_0\f$ The initial time.
+     * @param iThreads The number of threads. If \p 0, then all hardware
+     * threads are used.
+     */
+    Black76(const std::function<double(double)> &rForward,
+            const std::function<double(double)> &rDiscount,
+            const std::function<double(double)> &rVolatility,
+            double dInitialTime, unsigned iThreads = 0);
+
+    /**
+     * Computes the prices and the sensitivities of a book of options.
+     *
+     * @param rStrikes The strikes \f$K>0\f$.
+     * @param rMaturities The maturities \f$t>t_0\f$.
+     * @param rPayoffs The types of the options.
+     * @return The prices and the sensitivities of the options.
+     */
+    OptionValues operator()(const std::vector<double> &rStrikes,
+                            const std::vector<double> &rMaturities,
+                            const std::vector<Payoff> &rPayoffs) const;
+
+    /**
+     * Computes the prices and the sensitivities of a book of options.
+     * The vectors of \p rValues are resized only if their sizes
+     * differ from the size of the book, so the storage of repeated
+     * computations is allocated once.
+     *
+     * @param rStrikes The strikes \f$K>0\f$.
+     * @param rMaturities The maturities \f$t>t_0\f$.
+     * @param rPayoffs The types of the options.
+     * @param rValues The prices and the sensitivities of the options.
+     */
+    void operator()(const std::vector<double> &rStrikes,
+                    const std::vector<double> &rMaturities,
+                    const std::vector<Payoff> &rPayoffs,
+                    OptionValues &rValues) const;
+
+  private:
+    std::function<double(double)> m_uForward;
+    std::function<double(double)> m_uDiscount;
+    std::function<double(double)> m_uVolatility;
+    double m_dInitialTime;
+    unsigned m_iThreads;
+  };
+
+  /**
+   * @brief The batch solver of implied volatilities for the Black
+   * formula.
+   *
+   * The price of an option is normalized by \f$D(t)\sqrt{F(t)K}\f$
+   * and converted by the put-call parity to the price \f$\beta\f$ of
+   * the out-of-the-money call with log-moneyness
+   * \f$x=-|\log(F(t)/K)|\f$:
+   * \f[
+   *   \beta = b(x,s) = e^{x/2}N\left(\frac{x}{s}+\frac{s}{2}\right) -
+   *   e^{-x/2}N\left(\frac{x}{s}-\frac{s}{2}\right), \quad
+   *   s = \Sigma\sqrt{t-t_0}.
+   * \f]
+   * The equation \f$\log b(x,s) = \log\beta\f$ is solved by a fixed
+   * number of iterations of the third-order Householder method,
+   * which use the closed-form derivatives of \f$b\f$ in \f$s\f$. The
+   * initial guess is the largest of the approximation of Corrado and
+   * Miller and the asymptotic \f$|x|/\sqrt{-2\log\beta}\f$ for deep
+   * out-of-the-money options. As all options take the same number of
+   * iterations, the options are processed in vectorized loops over
+   * chunks without branches, and large books are split between
+   * several threads.
+   */
+  class ImpliedBlack76
+  {
+  public:
+    /**
+     * Constructs the solver.
+     *
+     * @param rForward The forward curve \f$F(t)\f$.
+     * @param rDiscount The discount curve \f$D(t)\f$.
+     * @param dInitialTime \f$t_0\f$ The initial time.
+     * @param iIterations The number of iterations of the Householder
+     * method.
+     * @param iThreads The number of threads. If \p 0, then all hardware
+     * threads are used.
+     */
+    ImpliedBlack76(const std::function<double(double)> &rForward,
+                   const std::function<double(double)> &rDiscount,
+                   double dInitialTime, unsigned iIterations = 4,
+                   unsigned iThreads = 0);
+
+    /**
+     * Computes the implied volatilities of a book of options.
+     *
+     * @param rPrices The prices of the options.
+     * @param rStrikes The strikes \f$K>0\f$.
+     * @param rMaturities The maturities \f$t>t_0\f$.
+     * @param rPayoffs The types of the options.
+     * @return The implied volatilities \f$\Sigma\f$. They are 0 for the
+     * prices outside of the bounds of no-arbitrage.
+     */
+    std::vector<double> operator()(const std::vector<double> &rPrices,
+                                   const std::vector<double> &rStrikes,
+                                   const std::vector<double> &rMaturities,
+                                   const std::vector<Payoff> &rPayoffs) const;
+
+    /**
+     * Computes the implied volatilities of a book of options. The
+     * vector \p rVols is resized only if its size differs from the
+     * size of the book.
+     *
+     * @param rPrices The prices of the options.
+     * @param rStrikes The strikes \f$K>0\f$.
+     * @param rMaturities The maturities \f$t>t_0\f$.
+     * @param rPayoffs The types of the options.
+     * @param rVols The implied volatilities \f$\Sigma\f$. They are 0
+     * for the prices outside of the bounds of no-arbitrage.
+     */
+    void operator()(const std::vector<double> &rPrices,
+                    const std::vector<double> &rStrikes,
+                    const std::vector<double> &rMaturities,
+                    const std::vector<Payoff> &rPayoffs,
+                    std::vector<double> &rVols) const;
+
+  private:
+    std::function<double(double)> m_uForward;
+    std::function<double(double)> m_uDiscount;
+    double m_dInitialTime;
+    unsigned m_iIterations;
+    unsigned m_iThreads;
+  };
+
+  /**
+   * @brief The batch pricing engine for caps and floors in the Black
+   * model.
+   *
+   * The caplets (floorlets) have the period \f$\delta t\f$. The
+   * caplet with index \f$i=1,\dots,n\f$ is set at time
+   * \f$t_i = t_0 + i\delta t\f$ and pays at \f$t_i+\delta t\f$ the
+   * amount
+   * \f[
+   *   N\delta t \max(\phi(L(t_i,t_i+\delta t) - K), 0),
+   * \f]
+   * where \f$N\f$ is the notional, \f$K\f$ is the cap (floor)
+   * rate, \f$\phi=1\f$ for caps and \f$\phi=-1\f$ for floors. Its
+   * value is given by the Black formula for the forward LIBOR
+   * \f$L^f(t_i,t_i+\delta t)\f$ and the caplet volatility
+   * \f$\Sigma(t_i)\f$. The cap with \f$m\f$ payments is the sum of
+   * the first \f$m\f$ caplets.
+   *
+   * The forward LIBORs, the discount factors and the volatilities of
+   * the schedule are computed at construction. For every rate, the
+   * caplets are valued in vectorized loops and their cumulative sums
+   * give the caps of all maturities at once.
+   */
+  class CapFloor
+  {
+  public:
+    /**
+     * Constructs the engine.
+     *
+     * @param dNotional \f$N\f$ The notional amount.
+     * @param dPeriod \f$\delta t\f$ The interval between payments.
+     * @param iNumberOfPayments \f$n\f$ The maximal number of payments.
+     * @param rDiscount The discount curve.
+     * @param rVolatility The caplet volatility curve \f$\Sigma(t)\f$
+     * as the function of the time of setting.
+     * @param dInitialTime \f$t_0\f$ The initial time.
+     * @param iThreads The number of threads. If \p 0, then all hardware
+     * threads are used.
+     */
+    CapFloor(double dNotional, double dPeriod, unsigned iNumberOfPayments,
+             const std::function<double(double)> &rDiscount,
+             const std::function<double(double)> &rVolatility,
+             double dInitialTime, unsigned iThreads = 0);
+
+    /**
+     * Computes the values of caps or floors for many rates and all
+     * maturities.
+     *
+     * @param rRates The cap (floor) rates \f$K>0\f$.
+     * @param ePayoff Payoff::call for caps and Payoff::put for floors.
+     * @return The row-major matrix with one row per rate: the value with
+     * rate \p rRates[j] and \f$m\f$ payments is at position
+     * \f$jn+m-1\f$.
+     */
+    std::vector<double> operator()(const std::vector<double> &rRates, Payoff ePayoff) const;
+
+    /**
+     * Computes the value of a cap or a floor.
+     *
+     * @param dRate \f$K>0\f$ The cap (floor) rate.
+     * @param iNumberOfPayments \f$1\leq m\leq n\f$ The number of payments.
+     * @param ePayoff Payoff::call for caps and Payoff::put for floors.
+     * @return The value of the cap (floor).
+     */
+    double operator()(double dRate, unsigned iNumberOfPayments, Payoff ePayoff) const;
+
+  private:
+    /** The logarithms of the forward LIBORs of the caplets. */
+    std::vector<double> m_uLogLibor;
+    /** The forward LIBORs of the caplets. */
+    std::vector<double> m_uLibor;
+    /** The discount factors at payments times the notional and the period. */
+    std::vector<double> m_uWeight;
+    /** The standard deviations of the logarithms of LIBORs. */
+    std::vector<double> m_uDeviation;
+    unsigned m_iThreads;
+  };
+
+  /**
+   * @brief The model of the volatilities of swaptions.
+   */
+  enum class SwaptionModel
+  {
+    /** The lognormal volatilities of the Black formula. */
+    black,
+    /** The normal volatilities of the Bachelier formula. */
+    bachelier
+  };
+
+  /**
+   * @brief The batch pricing engine for cubes of European swaptions.
+   *
+   * The swaption with expiry \f$T\f$ and tenor of \f$n\f$ payments
+   * is the option to enter at \f$T\f$ the swap with payments at
+   * \f$T+i\delta t\f$, \f$i=1,\dots,n\f$. Its value per unit of
+   * notional is
+   * \f[
+   *   A\,\phi\left(S N(\phi d_1) - K N(\phi d_2)\right), \quad
+   *   d_{1,2} = \frac{\log(S/K)}{\sigma\sqrt{T-t_0}} \pm
+   *   \frac{\sigma\sqrt{T-t_0}}{2},
+   * \f]
+   * in the Black model and
+   * \f[
+   *   A\left(\phi(S-K)N(\phi d) + v\,n(d)\right), \quad
+   *   v = \sigma\sqrt{T-t_0}, \quad d = \frac{S-K}{v},
+   * \f]
+   * in the Bachelier model, where \f$\phi=1\f$ for payer and
+   * \f$\phi=-1\f$ for receiver swaptions,
+   * \f[
+   *   A = \delta t\sum_{i=1}^n D(T+i\delta t), \quad
+   *   S = \frac{D(T)-D(T+n\delta t)}{A}
+   * \f]
+   * are the annuity and the forward swap rate. The strikes of a cube
+   * are spreads \f$K-S\f$ over the forward swap rates.
+   *
+   * At construction, the discount factors \f$D(T+i\delta t)\f$ are
+   * computed once for every expiry and their cumulative sums give the
+   * annuities and the swap rates of all tenors. A revaluation of the
+   * cube with new volatilities uses the stored rates and annuities;
+   * the expiries are split between several threads.
+   */
+  class SwaptionCube
+  {
+  public:
+    /**
+     * Constructs the engine.
+     *
+     * @param rExpiries The expiries \f$T>t_0\f$.
+     * @param rTenors The numbers of payments \f$n\geq 1\f$ of the
+     * underlying swaps.
+     * @param dPeriod \f$\delta t\f$ The interval between payments.
+     * @param rDiscount The discount curve.
+     * @param dInitialTime \f$t_0\f$ The initial time.
+     * @param iThreads The number of threads. If \p 0, then all hardware
+     * threads are used.
+     */
+    SwaptionCube(const std::vector<double> &rExpiries, const std::vector<unsigned> &rTenors,
+                 double dPeriod, const std::function<double(double)> &rDiscount,
+                 double dInitialTime, unsigned iThreads = 0);
+
+    /**
+     * Computes the values of swaptions per unit of notional.
+     *
+     * @param rSpreads The strikes as spreads \f$K-S\f$ over the forward
+     * swap rates.
+     * @param rVols The volatilities of the cube in the row-major order
+     * (expiry, tenor, strike).
+     * @param eModel The model of the volatilities.
+     * @param ePayoff Payoff::call for payer and Payoff::put for receiver
+     * swaptions.
+     * @return The values of the swaptions in the order of \p rVols.
+     */
+    std::vector<double> operator()(const std::vector<double> &rSpreads,
+                                   const std::vector<double> &rVols,
+                                   SwaptionModel eModel, Payoff ePayoff) const;
+
+    /**
+     * Returns the forward swap rates.
+     *
+     * @return The row-major matrix of rates with one row per expiry
+     * and one column per tenor.
+     */
+    const std::vector<double> &rates() const;
+
+    /**
+     * Returns the annuities.
+     *
+     * @return The row-major matrix of annuities with one row per
+     * expiry and one column per tenor.
+     */
+    const std::vector<double> &annuities() const;
+
+  private:
+    /** The forward swap rates of the expiries and the tenors. */
+    std::vector<double> m_uRates;
+    /** The annuities of the expiries and the tenors. */
+    std::vector<double> m_uAnnuities;
+    /** The square roots of the times to expiry. */
+    std::vector<double> m_uRoots;
+    unsigned m_iTenors;
+    unsigned m_iThreads;
+  };
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_options_hpp__
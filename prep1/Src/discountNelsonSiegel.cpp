@@ -1,4 +1,5 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 // DONE
 
@@ -10,9 +11,9 @@ vega::discountNelsonSiegel(double dC0, double dC1, double dC2,
 
     std::function<double(double)> uYield =
         yieldNelsonSiegel(dC0, dC1, dC2, dLambda, dInitialTime);
-    return [uYield, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("discountNelsonSiegel", [uYield, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         return std::exp(-uYield(dT) * (dT - dInitialTime));
-    };
+    });
 }
\ No newline at end of file
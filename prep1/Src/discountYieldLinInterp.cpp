@@ -1,4 +1,5 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 // DONE
 
@@ -13,7 +14,7 @@ vega::discountYieldLinInterp(const std::vector<double> &rTimes,
 
     std::function<double(double, double)> uYield = yield(dInitialTime);
 
-    return [rTimes, rDF, dR, dInitialTime, uYield](double dT)
+    return VEGA_TRACE_CURVE("discountYieldLinInterp", [rTimes, rDF, dR, dInitialTime, uYield](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         PRECONDITION(dT <= rTimes.back());
@@ -26,5 +27,5 @@ vega::discountYieldLinInterp(const std::vector<double> &rTimes,
         double dY1 = uYield(dX1, rDF[iI]);
 
         return exp(-(dY0 + dW * (dY1 - dY0)) * (dT - dInitialTime));
-    };
+    });
 }; // dY0 + dW * (dY1 - dY0)
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 // DONE 
 
@@ -10,7 +11,7 @@ vega::forwardCashFlow(const std::vector<double> &rPayments,
     PRECONDITION(is_sorted(rPaymentTimes.begin(), rPaymentTimes.end(), std::less_equal<double>()));
     PRECONDITION(rPayments.size() == rPaymentTimes.size());
 
-    return [rPayments, rPaymentTimes, rDiscount](double dT)
+    return VEGA_TRACE_CURVE("forwardCashFlow", [rPayments, rPaymentTimes, rDiscount](double dT)
     {
         PRECONDITION(dT <= rPaymentTimes.back());
 
@@ -25,5 +26,5 @@ vega::forwardCashFlow(const std::vector<double> &rPayments,
                                   });
         double dF = dSum / rDiscount(dT);
         return dF;
-    };
+    });
 }
\ No newline at end of file
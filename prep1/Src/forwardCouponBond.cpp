@@ -1,4 +1,5 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 
 
@@ -7,7 +8,7 @@ vega::forwardCouponBond(double dRate, double dPeriod, double dMaturity,
                         const std::function<double(double)> &rDiscount,
                         bool bClean) // Forward price curve for a coupon bond
 {
-    return [dRate, dPeriod, dMaturity, rDiscount, bClean](double dT)
+    return VEGA_TRACE_CURVE("forwardCouponBond", [dRate, dPeriod, dMaturity, rDiscount, bClean](double dT)
     {
         double dPayTime = dMaturity;
         double dSum = 0;
@@ -25,5 +26,5 @@ vega::forwardCouponBond(double dRate, double dPeriod, double dMaturity,
             dF -= dRate * (dT - dPayTime);
         }
         return dF;
-    };
+    });
 }
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 std::function<double(double, double)>
 vega::forwardFX(double dSpotFX) // Forward exchange rate from domestic and foreign discount factors
 {
-  return [dSpotFX](double dDom, double dFor)
+  return VEGA_TRACE_CURVE("forwardFX", [dSpotFX](double dDom, double dFor)
   {
     PRECONDITION(dDom > vega::EPS);
     return dSpotFX * dFor / dDom;
-  };
+  });
 }
\ No newline at end of file
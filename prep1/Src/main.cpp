@@ -0,0 +1,10 @@
+#include "test/Main.hpp"
+#include "prep1/Output.hpp"
+
+std::function<void()> test_prep1();
+
+int main()
+{
+  test::project(test_prep1(), PROJECT_NAME, PROJECT_NAME,
+                "Set 1");
+}
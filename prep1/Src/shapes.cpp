@@ -1,15 +1,14 @@
 #include "prep1/prep1.hpp"
+#include "vega/shapes.hpp"
 
 double vega::shape1(double dX)
 {
   PRECONDITION(dX >= 0);
-  double dY = (dX > vega::EPS) ? (1 - std::exp(-dX)) / dX : (1. - dX / 2. + dX * dX / 6.);
-  return dY;
+  return Shapes::shape1(dX);
 }
 
 double vega::shape2(double dX)
 {
   PRECONDITION(dX >= 0);
-  double dY = (dX > vega::EPS) ? (1 - std::exp(-dX) * (1. + dX)) / dX : (dX / 2. - dX * dX / 3.);
-  return dY;
+  return Shapes::shape2(dX);
 }
@@ -9,7 +9,7 @@ using namespace std;
 
 const double c_dYield = 0.07;
 
-std::function<double(double)> DF(double dRate, double dInitialTime)
+static std::function<double(double)> DF(double dRate, double dInitialTime)
 {
   return [dRate, dInitialTime](double dT)
   {
@@ -17,14 +17,6 @@ std::function<double(double)> DF(double dRate, double dInitialTime)
   };
 }
 
-std::function<double(double)> DF(double dRate1, double dRate2, double dInitialTime)
-{
-  return [dRate1, dRate2, dInitialTime](double dT)
-  {
-    return 0.5 * (exp(-dRate1 * (dT - dInitialTime)) + exp(-dRate2 * (dT - dInitialTime)));
-  };
-}
-
 void discountNelsonSiegel()
 {
   test::print("NELSON-SIEGEL DISCOUNT CURVE");
@@ -249,9 +241,3 @@ std::function<void()> test_prep1()
     forwardCouponBond();
   };
 }
-
-int main()
-{
-  project(test_prep1(), PROJECT_NAME, PROJECT_NAME,
-          "Set 1");
-}
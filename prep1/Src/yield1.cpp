@@ -1,13 +1,14 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 // DONE
 
 std::function<double(double, double)>
 vega::yield(double dInitialTime) // Yield from maturity and discount factor
 {
-    return [dInitialTime](double T, double dT)
+    return VEGA_TRACE_CURVE("yield", [dInitialTime](double T, double dT)
     {
         PRECONDITION(T > dInitialTime + vega::EPS);
         return -std::log(dT) / (T - dInitialTime);
-    };
+    });
 }
\ No newline at end of file
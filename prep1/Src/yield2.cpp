@@ -1,10 +1,11 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 std::function<double(double)>
 vega::yield(const std::function<double(double)> &rDiscount,
             double dInitialTime) // Yield curve computed from discount curve
 {
-  return [rDiscount, dInitialTime](double dT)
+  return VEGA_TRACE_CURVE("yield", [rDiscount, dInitialTime](double dT)
   {
     PRECONDITION(dT >= dInitialTime);
     if (dT < dInitialTime + vega::EPS)
@@ -15,5 +16,5 @@ vega::yield(const std::function<double(double)> &rDiscount,
     {
       return -std::log(rDiscount(dT)) / (dT - dInitialTime);
     }
-  };
+  });
 }
\ No newline at end of file
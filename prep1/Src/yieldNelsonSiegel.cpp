@@ -1,4 +1,6 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
+#include "vega/shapes.hpp"
 
 // DONE
 
@@ -8,12 +10,13 @@ vega::yieldNelsonSiegel(double dC0, double dC1, double dC2,
 {
   PRECONDITION(dLambda >= 0);
 
-  return [dC0, dC1, dC2, dLambda, dInitialTime](double dT)
+  return VEGA_TRACE_CURVE("yieldNelsonSiegel", [dC0, dC1, dC2, dLambda, dInitialTime](double dT)
   {
     PRECONDITION(dT >= dInitialTime);
 
     double dX = dLambda * (dT - dInitialTime);
-    double dY = dC0 + dC1 * shape1(dX) + dC2 * shape2(dX);
+    ShapeValues uShapes = Shapes::values(dX);
+    double dY = dC0 + dC1 * uShapes.shape1 + dC2 * uShapes.shape2;
     return dY;
-  };
+  });
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 std::function<double(double)>
 vega::yieldShape1(double dLambda, double dInitialTime) // Yield shape curve 1
 {
-    return [dLambda, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("yieldShape1", [dLambda, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
 
         double dX = dLambda * (dT - dInitialTime);
         return shape1(dX);
-    };
+    });
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
 
 
 std::function<double(double)>
 vega::yieldShape2(double dLambda, double dInitialTime) // Yield shape curve 2
 {
-    return [dLambda, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("yieldShape2", [dLambda, dInitialTime](double dT)
     {
         double dX = dLambda * (dT - dInitialTime);
         return shape2(dX);
-    };
+    });
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
+#include "vega/shapes.hpp"
 #include "header.hpp"
 // DONE
 
@@ -9,13 +11,15 @@ vega::carryBlack(double dTheta, double dLambda, double dSigma,
   PRECONDITION(dLambda >= 0);
   PRECONDITION(dSigma >= 0);
 
-  return [dTheta, dSigma, dLambda, dInitialTime](double dT)
+  double dSigmato2over2 = std::pow(dSigma, 2) / 2;
+
+  return VEGA_TRACE_CURVE("carryBlack", [dTheta, dSigmato2over2, dLambda, dInitialTime](double dT)
   {
     PRECONDITION(dT >= dInitialTime);
 
     double dX = dLambda * (dT - dInitialTime);
-    double dSigmato2over2 = std::pow(dSigma, 2) / 2;
-    double dY = dTheta * shape1(dX) + dSigmato2over2 * shape1(2 * dX);
+    ShapeValues uShapes = Shapes::values(dX);
+    double dY = dTheta * uShapes.shape1 + dSigmato2over2 * uShapes.shape1Of2x;
     return dY;
-  };
-}
\ No newline at end of file
+  });
+}
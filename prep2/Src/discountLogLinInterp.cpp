@@ -1,27 +1,33 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
 std::function<double(double)>
-vega::discountLogLinInterp(const std::vector<double> &rDiscountTimes,
-                       const std::vector<double> &rDiscountFactors,
+vega::discountLogLinInterp(std::vector<double> uDiscountTimes,
+                       std::vector<double> uDiscountFactors,
                        double dInitialTime)
 {
-    PRECONDITION(std::is_sorted(rDiscountTimes.begin(), rDiscountTimes.end(), std::less_equal<double>()));
-    PRECONDITION(rDiscountTimes.size() == rDiscountFactors.size());
-    PRECONDITION(rDiscountTimes.front() > dInitialTime);
+    PRECONDITION(std::is_sorted(uDiscountTimes.begin(), uDiscountTimes.end(), std::less_equal<double>()));
+    PRECONDITION(uDiscountTimes.size() == uDiscountFactors.size());
+    PRECONDITION(uDiscountTimes.front() > dInitialTime);
 
-    return [rDiscountTimes, rDiscountFactors, dInitialTime](double dT)
+    // the logarithms of discount factors are computed once, in place;
+    // the vectors are moved into the curve
+    std::transform(uDiscountFactors.begin(), uDiscountFactors.end(), uDiscountFactors.begin(),
+                   [](double dDF) { return std::log(dDF); });
+
+    return VEGA_TRACE_CURVE("discountLogLinInterp", [uDiscountTimes = std::move(uDiscountTimes), uLogDF = std::move(uDiscountFactors), dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
-        PRECONDITION(dT <= rDiscountTimes.back());
-        unsigned iI = std::lower_bound(rDiscountTimes.begin(), rDiscountTimes.end(), dT) - rDiscountTimes.begin(); // first element after dT - sth
-        double dX0 = (iI > 0) ? rDiscountTimes[iI - 1] : dInitialTime;
-        double dX1 = rDiscountTimes[iI];
+        PRECONDITION(dT <= uDiscountTimes.back());
+        unsigned iI = std::lower_bound(uDiscountTimes.begin(), uDiscountTimes.end(), dT) - uDiscountTimes.begin(); // first element after dT - sth
+        double dX0 = (iI > 0) ? uDiscountTimes[iI - 1] : dInitialTime;
+        double dX1 = uDiscountTimes[iI];
         double dW = (dT - dX0) / (dX1 - dX0);
-        double dY0 = (iI > 0) ? std::log(rDiscountFactors[iI - 1]) : std::log(1.);
-        double dY1 = std::log(rDiscountFactors[iI]);
+        double dY0 = (iI > 0) ? uLogDF[iI - 1] : 0.;
+        double dY1 = uLogDF[iI];
 
         return std::exp(dY0 + dW * (dY1 - dY0));
-    };
-}
\ No newline at end of file
+    });
+}
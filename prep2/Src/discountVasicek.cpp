@@ -1,4 +1,5 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
@@ -11,9 +12,9 @@ vega::discountVasicek(double dTheta, double dLambda, double dSigma,
 
     std::function<double(double)> uYieldVasicek =
         yieldVasicek(dTheta, dLambda, dSigma, dR0, dInitialTime);
-    return [uYieldVasicek, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("discountVasicek", [uYieldVasicek, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         return std::exp(-uYieldVasicek(dT) * (dT - dInitialTime));
-    };
+    });
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
@@ -7,7 +8,7 @@ vega::forwardAnnuity(double dRate, double dPeriod, double dMaturity,
                  const std::function<double(double)> &rDiscount,
                  bool bClean)
 {
-    return [dRate, dPeriod, dMaturity, rDiscount, bClean](double dT)
+    return VEGA_TRACE_CURVE("forwardAnnuity", [dRate, dPeriod, dMaturity, rDiscount, bClean](double dT)
     {
         double dPayTime = dMaturity;
         double dSum = 0;
@@ -24,5 +25,5 @@ vega::forwardAnnuity(double dRate, double dPeriod, double dMaturity,
             dF -= dRate * (dT - dPayTime);
         }
         return dF;
-    };
+    });
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
@@ -11,7 +12,7 @@ vega::forwardStockDividends(double dSpot,
     PRECONDITION(is_sorted(rDividendsTimes.begin(), rDividendsTimes.end(), std::less_equal<double>()));
     PRECONDITION(rDividends.size() == rDividendsTimes.size());
 
-    return [dSpot, rDividendsTimes, rDividends, rDiscount](double dT)
+    return VEGA_TRACE_CURVE("forwardStockDividends", [dSpot, rDividendsTimes, rDividends, rDiscount](double dT)
     {
         PRECONDITION(dT <= rDividendsTimes.back());
         unsigned iTime = std::upper_bound(rDividendsTimes.begin(), rDividendsTimes.end(), dT) - rDividendsTimes.begin(); // 1st elem before dT
@@ -25,5 +26,5 @@ vega::forwardStockDividends(double dSpot,
                                   });
         double dF = dSpot / rDiscount(dT) - dSum;
         return dF;
-    };
+    });
 }
\ No newline at end of file
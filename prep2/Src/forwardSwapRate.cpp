@@ -1,11 +1,12 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 std::function<double(double)>
 vega::forwardSwapRate(double dPeriod, unsigned iNumberOfPayments,
                   const std::function<double(double)> &rDiscount)
 {
-    return [dPeriod, iNumberOfPayments, rDiscount](double dT)
+    return VEGA_TRACE_CURVE("forwardSwapRate", [dPeriod, iNumberOfPayments, rDiscount](double dT)
     {
         double dSum = 0.;
         for (unsigned i = 0; i < iNumberOfPayments; ++i)
@@ -14,5 +15,5 @@ vega::forwardSwapRate(double dPeriod, unsigned iNumberOfPayments,
         }
 
         return (rDiscount(dT) - rDiscount(dT + iNumberOfPayments*dPeriod)) / (dSum * dPeriod);
-    };
+    });
 }
\ No newline at end of file
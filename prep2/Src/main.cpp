@@ -0,0 +1,10 @@
+#include "test/Main.hpp"
+#include "prep2/Output.hpp"
+
+std::function<void()> test_prep2();
+
+int main()
+{
+  test::project(test_prep2(), PROJECT_NAME, PROJECT_NAME,
+                "Set 2");
+}
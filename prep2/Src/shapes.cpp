@@ -1,16 +1,15 @@
 #include "prep2/prep2.hpp"
 #include "header.hpp"
+#include "vega/shapes.hpp"
 
 double shape1(double dX)
 {
   PRECONDITION(dX >= 0);
-  double dY = (dX > EPS) ? (1 - std::exp(-dX)) / dX : (1. - dX / 2. + dX * dX / 6.);
-  return dY;
+  return vega::Shapes::shape1(dX);
 }
 
 double shape2(double dX, double dTminusdS)
 {
   PRECONDITION(dX >= 0);
-  double dY = (dX > EPS) ? (1 - std::exp(-dX)) / (dX / dTminusdS) : (1. - dX / 2. + dX * dX / 6.);
-  return dY;
-}
\ No newline at end of file
+  return dTminusdS * vega::Shapes::shape1(dX);
+}
@@ -7,7 +7,7 @@
 using namespace test;
 using namespace std;
 
-std::function<double(double)> DF(double dRate, double dInitialTime)
+static std::function<double(double)> DF(double dRate, double dInitialTime)
 {
   return [dRate, dInitialTime](double dT)
   {
@@ -15,7 +15,7 @@ std::function<double(double)> DF(double dRate, double dInitialTime)
   };
 }
 
-std::function<double(double)> DF(double dRate1, double dRate2, double dInitialTime)
+static std::function<double(double)> DF(double dRate1, double dRate2, double dInitialTime)
 {
   return [dRate1, dRate2, dInitialTime](double dT)
   {
@@ -277,9 +277,3 @@ std::function<void()> test_prep2()
     volatilityHullWhite();
   };
 }
-
-int main()
-{
-  project(test_prep2(), PROJECT_NAME, PROJECT_NAME,
-          "Set 2");
-}
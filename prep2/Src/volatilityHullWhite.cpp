@@ -1,4 +1,6 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
+#include "vega/shapes.hpp"
 #include "header.hpp"
 
 // DONE
@@ -9,14 +11,15 @@ vega::volatilityHullWhite(double dSigma, double dLambda,
 {
     PRECONDITION(dLambda >= 0);
     PRECONDITION(dSigma > 0);
-    return [dSigma, dLambda, dInitialTime](double dS, double dT)
+
+    return VEGA_TRACE_CURVE("volatilityHullWhite", [dSigma, dLambda, dInitialTime](double dS, double dT)
     {
         PRECONDITION(dS >= dInitialTime && dS < dT);
 
         double dX = dLambda * (dS - dInitialTime);
         double dZ = dLambda * (dT - dS);
-        double dTminusdS = dT - dS;
-        double dY = (dLambda != 0) ? (dSigma * ((1 - std::exp(-dZ)) / dLambda) * std::sqrt(shape1(2 * dX))) : (dSigma * (dTminusdS - std::pow(dTminusdS, 2) * dLambda / 2 + std::pow(dTminusdS, 3) * std::pow(dLambda, 2) / 6 - std::pow(dTminusdS, 4) * std::pow(dLambda, 3) / 24) * std::sqrt(shape1(2 * dX)));
+        // (1 - exp(-z)) / lambda = (t - s) shape1(z) also for lambda = 0
+        double dY = dSigma * (dT - dS) * Shapes::shape1(dZ) * std::sqrt(Shapes::shape1Of2x(dX));
         return dY;
-    };
-}
\ No newline at end of file
+    });
+}
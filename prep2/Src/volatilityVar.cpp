@@ -1,4 +1,5 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
@@ -6,7 +7,7 @@ std::function<double(double)>
 vega::volatilityVar(const std::function<double(double)> &rVar, double dInitialTime)
 
 {
-    return [rVar, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("volatilityVar", [rVar, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         double dY;
@@ -17,5 +18,5 @@ vega::volatilityVar(const std::function<double(double)> &rVar, double dInitialTi
             dY = dSigma;
         }
         return dY;
-    };
+    });
 }
\ No newline at end of file
@@ -1,33 +1,34 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
 #include "header.hpp"
 // DONE
 
 std::function<double(double)>
-vega::volatilityVarLinInterp(const std::vector<double> &rTimes,
-                         const std::vector<double> &rVols,
+vega::volatilityVarLinInterp(std::vector<double> uTimes,
+                         std::vector<double> uVols,
                          double dInitialTime)
 {
-    PRECONDITION(rTimes.size() == rVols.size());
-    PRECONDITION(rTimes.front() > dInitialTime);
-    PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+    PRECONDITION(uTimes.size() == uVols.size());
+    PRECONDITION(uTimes.front() > dInitialTime);
+    PRECONDITION(std::is_sorted(uTimes.begin(), uTimes.end(), std::less_equal<double>()));
 
-    return [rTimes, rVols, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("volatilityVarLinInterp", [uTimes = std::move(uTimes), uVols = std::move(uVols), dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
-        PRECONDITION(dT <= rTimes.back());
-        if (dT <= rTimes[1] && dT >= dInitialTime)
+        PRECONDITION(dT <= uTimes.back());
+        if (dT <= uTimes[1] && dT >= dInitialTime)
         {
-            return rVols[1];
+            return uVols[1];
         }
         else {
-            unsigned iI = std::lower_bound(rTimes.begin(), rTimes.end(), dT) - rTimes.begin();
-            double dX0 = (iI > 0) ? rTimes[iI - 1] : dInitialTime;
-            double dX1 = rTimes[iI];
+            unsigned iI = std::lower_bound(uTimes.begin(), uTimes.end(), dT) - uTimes.begin();
+            double dX0 = (iI > 0) ? uTimes[iI - 1] : dInitialTime;
+            double dX1 = uTimes[iI];
             double dW = (dT - dX0) / (dX1 - dX0);
-            double dY0 = rVols[iI-1];
-            double dY1 = rVols[iI];
+            double dY0 = uVols[iI-1];
+            double dY1 = uVols[iI];
 
             return dY0 + dW * (dY1 - dY0);
         }
-    };
+    });
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "prep2/prep2.hpp"
+#include "vega/trace.hpp"
+#include "vega/shapes.hpp"
 #include "header.hpp"
 // DONE
 
@@ -9,15 +11,18 @@ vega::yieldVasicek(double dTheta, double dLambda, double dSigma,
     PRECONDITION(dLambda > 0);
     PRECONDITION(dSigma > 0);
 
-    return [dTheta, dSigma, dLambda, dInitialTime, dR0](double dT)
+    double dSigmato2over2 = std::pow(dSigma, 2) / 2;
+    double dLambdato2 = std::pow(dLambda, 2);
+    double dVariance = dSigmato2over2 / dLambdato2;
+
+    return VEGA_TRACE_CURVE("yieldVasicek", [dTheta, dVariance, dLambda, dInitialTime, dR0](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
 
         double dX = dLambda * (dT - dInitialTime);
-        double dSigmato2over2 = std::pow(dSigma, 2) / 2;
-        double dLambdato2 = std::pow(dLambda, 2);
-        double dY = dR0 * shape1(dX) + (dTheta / dLambda) * (1 - shape1(dX)) -
-                    (dSigmato2over2 / dLambdato2) * (1 - 2 * shape1(dX) + shape1(2 * dX));
+        ShapeValues uShapes = Shapes::values(dX);
+        double dY = dR0 * uShapes.shape1 + (dTheta / dLambda) * (1 - uShapes.shape1) -
+                    dVariance * (1 - 2 * uShapes.shape1 + uShapes.shape1Of2x);
         return dY;
-    };
-}
\ No newline at end of file
+    });
+}
@@ -62,19 +62,21 @@ namespace vega
   
   /**
    * Computes the discount curve by the log-linear interpolation of a
-   * given collection of market discount factors.
+   * given collection of market discount factors. The vectors are
+   * taken by value and moved into the curve, so a temporary is not
+   * copied.
    *
-   * @param rDiscountTimes The maturities of the market discount
+   * @param uDiscountTimes The maturities of the market discount
    * factors.
-   * @param rDiscountFactors The market discount factors.
+   * @param uDiscountFactors The market discount factors.
    * @param dInitialTime The initial time.
    *
    * @return The discount curve obtained from the market discount
    * factors by the log-linear interpolation.
    */
   std::function<double(double)>
-  discountLogLinInterp(const std::vector<double> &rDiscountTimes,
-                       const std::vector<double> &rDiscountFactors,
+  discountLogLinInterp(std::vector<double> uDiscountTimes,
+                       std::vector<double> uDiscountFactors,
                        double dInitialTime);
 
   /**
@@ -212,19 +214,20 @@ namespace vega
    * \f[
    *      V(t) = \Sigma^2(t)(t - t_0), \quad t\geq t_0.
    * \f]
-   * The resulting volatility curve is constant on \f$[t_0,t_1]\f$.
+   * The resulting volatility curve is constant on \f$[t_0,t_1]\f$. The
+   * vectors are taken by value and moved into the curve.
    *
-   * @param rTimes \f$(t_i)_{i=1,\dots,M}\f$ The maturities of the
+   * @param uTimes \f$(t_i)_{i=1,\dots,M}\f$ The maturities of the
    * market implied volatilities, \f$t_1>t_0\f$.
-   * @param rVols The vector of market volatilities.
+   * @param uVols The vector of market volatilities.
    * @param dInitialTime (\f$t_0\f$) The initial time.
    *
    * @return The volatility curve obtained by linear interpolation
    * of market variances.
    */
   std::function<double(double)>
-  volatilityVarLinInterp(const std::vector<double> &rTimes,
-                         const std::vector<double> &rVols,
+  volatilityVarLinInterp(std::vector<double> uTimes,
+                         std::vector<double> uVols,
                          double dInitialTime);
   
   /**
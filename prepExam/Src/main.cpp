@@ -0,0 +1,10 @@
+#include "test/Main.hpp"
+#include "prepExam/Output.hpp"
+
+std::function<void()> test_prepExam();
+
+int main()
+{
+  test::project(test_prepExam(), PROJECT_NAME, PROJECT_NAME,
+                "Exam for Vega-Prep");
+}
@@ -1,4 +1,6 @@
 #include "prepExam/prepExam.hpp"
+#include "vega/trace.hpp"
+#include "vega/shapes.hpp"
 
 #include <cassert>
 #include <cmath>
@@ -11,24 +13,10 @@
 
 const double EPS = 1E-10;
 
-double shape1(double dX)
-{
-    PRECONDITION(dX >= 0);
-    double dY = (dX > EPS) ? (1 - std::exp(-dX)) / dX : (1. - dX / 2. + dX * dX / 6.);
-    return dY;
-}
-
-double shape2(double dX)
-{
-    PRECONDITION(dX >= 0);
-    double dY = (dX > EPS) ? (1 - std::exp(-dX) * (1. + dX)) / dX : (dX / 2. - dX * dX / 3.);
-    return dY;
-}
-
 std::function<double(double, double)>
 vega::costOfCarry(double dSpot, double dInitialTime)
 {
-    return [dSpot, dInitialTime](double dFofT, double dT)
+    return VEGA_TRACE_CURVE("costOfCarry", [dSpot, dInitialTime](double dFofT, double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         double dY;
@@ -41,7 +29,7 @@ vega::costOfCarry(double dSpot, double dInitialTime)
             dY = std::log(dFofT / dSpot) / (dT - dInitialTime);
         }
         return dY;
-    };
+    });
 }
 
 std::function<double(double)>
@@ -49,7 +37,7 @@ vega::forwardFX(double dSpotFX, const std::function<double(double)> &rDomesticDi
                 const std::function<double(double)> &rForeignDiscount)
 {
 
-    return [dSpotFX, rDomesticDiscount, rForeignDiscount](double dT)
+    return VEGA_TRACE_CURVE("forwardFX", [dSpotFX, rDomesticDiscount, rForeignDiscount](double dT)
     {
         double dY;
         if (rDomesticDiscount(dT) < EPS)
@@ -61,7 +49,7 @@ vega::forwardFX(double dSpotFX, const std::function<double(double)> &rDomesticDi
             dY = (dSpotFX * rForeignDiscount(dT)) / rDomesticDiscount(dT);
         }
         return dY;
-    };
+    });
 }
 
 std::function<double(double)>
@@ -70,14 +58,15 @@ vega::yieldSvensson(double dC0, double dC1, double dC2, double dC3,
 {
     PRECONDITION(dLambda1 != dLambda2);
 
-    return [dC0, dC1, dC2, dC3, dLambda1, dLambda2, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("yieldSvensson", [dC0, dC1, dC2, dC3, dLambda1, dLambda2, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         double dX1 = dLambda1 * (dT - dInitialTime);
         double dX2 = dLambda2 * (dT - dInitialTime);
-        double dY = dC0 + dC1 * shape1(dX1) + dC2 * shape2(dX1) + dC3 * shape2(dX2);
+        ShapeValues uShapes1 = Shapes::values(dX1);
+        double dY = dC0 + dC1 * uShapes1.shape1 + dC2 * uShapes1.shape2 + dC3 * Shapes::shape2(dX2);
         return dY;
-    };
+    });
 }
 
 std::function<double(double)>
@@ -85,20 +74,20 @@ vega::volatilityBlack(double dSigma, double dLambda, double dInitialTime)
 {
     PRECONDITION(dLambda >= 0);
     PRECONDITION(dSigma > 0);
-    return [dSigma, dLambda, dInitialTime](double dT)
+    return VEGA_TRACE_CURVE("volatilityBlack", [dSigma, dLambda, dInitialTime](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
         double dX = dLambda * (dT - dInitialTime);
-        double dY = dSigma * std::sqrt(shape1(2 * dX));
+        double dY = dSigma * std::sqrt(Shapes::shape1Of2x(dX));
         return dY;
-    };
+    });
 }
 
 std::function<double(double)>
 vega::forwardLibor(double dLiborPeriod,
                    const std::function<double(double)> &rDiscount)
 {
-    return [dLiborPeriod, rDiscount](double dT)
+    return VEGA_TRACE_CURVE("forwardLibor", [dLiborPeriod, rDiscount](double dT)
     {
         double dDicountsRatio;
         if (rDiscount(dT + dLiborPeriod) < EPS)
@@ -119,40 +108,40 @@ vega::forwardLibor(double dLiborPeriod,
             dY = (dDicountsRatio - 1) / EPS;
         }
         return dY;
-    };
+    });
 }
 
 std::function<double(double)>
 vega::forwardCarryLinInterp(double dSpot,
-                            const std::vector<double> &rDeliveryTimes,
-                            const std::vector<double> &rForwardPrices,
+                            std::vector<double> uDeliveryTimes,
+                            std::vector<double> uForwardPrices,
                             double dInitialTime)
 {
-    PRECONDITION(rDeliveryTimes.size() == rForwardPrices.size());
-    PRECONDITION(rDeliveryTimes.front() > dInitialTime);
-    PRECONDITION(std::is_sorted(rDeliveryTimes.begin(), rDeliveryTimes.end(), std::less_equal<double>()));
+    PRECONDITION(uDeliveryTimes.size() == uForwardPrices.size());
+    PRECONDITION(uDeliveryTimes.front() > dInitialTime);
+    PRECONDITION(std::is_sorted(uDeliveryTimes.begin(), uDeliveryTimes.end(), std::less_equal<double>()));
 
     std::function<double(double, double)> uCostOfCarry = costOfCarry(dSpot, dInitialTime);
 
-    return [dSpot, rDeliveryTimes, rForwardPrices, dInitialTime, uCostOfCarry](double dT)
+    return VEGA_TRACE_CURVE("forwardCarryLinInterp", [dSpot, uDeliveryTimes = std::move(uDeliveryTimes), uForwardPrices = std::move(uForwardPrices), dInitialTime, uCostOfCarry](double dT)
     {
         PRECONDITION(dT >= dInitialTime);
-        PRECONDITION(dT <= rDeliveryTimes.back());
+        PRECONDITION(dT <= uDeliveryTimes.back());
 
-        if (dT <= rDeliveryTimes[0] && dT >= dInitialTime)
+        if (dT <= uDeliveryTimes[0] && dT >= dInitialTime)
         {
-            return dSpot * std::exp(uCostOfCarry(rForwardPrices[0], dT) * (dT - dInitialTime));
+            return dSpot * std::exp(uCostOfCarry(uForwardPrices[0], dT) * (dT - dInitialTime));
         }
         else
         {
-            unsigned iI = std::lower_bound(rDeliveryTimes.begin(), rDeliveryTimes.end(), dT) - rDeliveryTimes.begin(); // first element after dT - sth
-            double dX0 = (iI > 0) ? rDeliveryTimes[iI - 1] : dInitialTime;
-            double dX1 = rDeliveryTimes[iI];
+            unsigned iI = std::lower_bound(uDeliveryTimes.begin(), uDeliveryTimes.end(), dT) - uDeliveryTimes.begin(); // first element after dT - sth
+            double dX0 = (iI > 0) ? uDeliveryTimes[iI - 1] : dInitialTime;
+            double dX1 = uDeliveryTimes[iI];
             double dW = (dT - dX0) / (dX1 - dX0);
-            double dY0 = uCostOfCarry(rForwardPrices[iI - 1], dX0);
-            double dY1 = uCostOfCarry(rForwardPrices[iI], dX1);
+            double dY0 = uCostOfCarry(uForwardPrices[iI - 1], dX0);
+            double dY1 = uCostOfCarry(uForwardPrices[iI], dX1);
 
             return dSpot * std::exp((dY0 + dW * (dY1 - dY0)) * (dT - dInitialTime));
         }
-    };
+    });
 }
\ No newline at end of file
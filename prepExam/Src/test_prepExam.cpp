@@ -8,7 +8,7 @@ using namespace test;
 using namespace std;
 using namespace test;
 
-std::function<double(double)> DF(double dRate, double dInitialTime)
+static std::function<double(double)> DF(double dRate, double dInitialTime)
 {
   return [dRate, dInitialTime](double dT)
   {
@@ -16,7 +16,7 @@ std::function<double(double)> DF(double dRate, double dInitialTime)
   };
 }
 
-std::function<double(double)> DF(double dRate1, double dRate2, double dInitialTime)
+static std::function<double(double)> DF(double dRate1, double dRate2, double dInitialTime)
 {
   return [dRate1, dRate2, dInitialTime](double dT)
   {
@@ -158,9 +158,3 @@ std::function<void()> test_prepExam()
     forwardCarryLinInterp();
   };
 }
-
-int main()
-{
-  project(test_prepExam(), PROJECT_NAME, PROJECT_NAME,
-          "Exam for Vega-Prep");
-}
@@ -132,11 +132,12 @@ namespace vega
    * \f[
    * q(t) = q(t_1), \quad t\in [t_0,t_1].
    * \f]
+   * The vectors are taken by value and moved into the curve.
    *
    * @param dSpot \f$S_0\f$ The spot price of the stock.
-   * @param rDeliveryTimes \f$(t_i)_{i=1,\dots,M}\f$ The maturities
+   * @param uDeliveryTimes \f$(t_i)_{i=1,\dots,M}\f$ The maturities
    * of the market forward contracts, \f$t_0<t_1\f$.
-   * @param rForwardPrices \f$(F(t_i))_{i=1,\dots,M}\f$ The market
+   * @param uForwardPrices \f$(F(t_i))_{i=1,\dots,M}\f$ The market
    * forward prices.
    * @param dInitialTime \f$t_0\f$ The initial time.
    *
@@ -145,8 +146,8 @@ namespace vega
    */
   std::function<double(double)>
   forwardCarryLinInterp(double dSpot,
-                        const std::vector<double> &rDeliveryTimes,
-                        const std::vector<double> &rForwardPrices,
+                        std::vector<double> uDeliveryTimes,
+                        std::vector<double> uForwardPrices,
                         double dInitialTime);
   /** @} */
 } // namespace vega
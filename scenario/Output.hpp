@@ -0,0 +1,11 @@
+#ifndef __scenario_Output_hpp__
+#define __scenario_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "scenario"
+} // namespace test
+
+#endif // of __scenario_Output_hpp
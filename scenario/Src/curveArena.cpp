@@ -0,0 +1,164 @@
+#include "scenario/scenario.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "vega/shapes.hpp"
+
+namespace curveArena
+{
+  // the states are arrays of doubles; the formulas repeat the
+  // builders operation by operation, so the values are identical
+
+  // t0, M, t_1..t_M, log d_1..log d_M
+  double discountLogLinInterp(const void *pState, double dT)
+  {
+    const double *pS = static_cast<const double *>(pState);
+    double dInitialTime = pS[0];
+    std::size_t iM = std::size_t(pS[1]);
+    const double *pTimes = pS + 2;
+    const double *pLogDF = pTimes + iM;
+    PRECONDITION(dT >= dInitialTime);
+    PRECONDITION(dT <= pTimes[iM - 1]);
+
+    unsigned iI = std::lower_bound(pTimes, pTimes + iM, dT) - pTimes;
+    double dX0 = (iI > 0) ? pTimes[iI - 1] : dInitialTime;
+    double dX1 = pTimes[iI];
+    double dW = (dT - dX0) / (dX1 - dX0);
+    double dY0 = (iI > 0) ? pLogDF[iI - 1] : std::log(1.);
+    double dY1 = pLogDF[iI];
+
+    return std::exp(dY0 + dW * (dY1 - dY0));
+  }
+
+  // c0, c1, c2, lambda, t0
+  double discountNelsonSiegel(const void *pState, double dT)
+  {
+    const double *pS = static_cast<const double *>(pState);
+    PRECONDITION(dT >= pS[4]);
+
+    double dX = pS[3] * (dT - pS[4]);
+    vega::ShapeValues uShapes = vega::Shapes::values(dX);
+    double dY = pS[0] + pS[1] * uShapes.shape1 + pS[2] * uShapes.shape2;
+    return std::exp(-dY * (dT - pS[4]));
+  }
+
+  // c0, c1, c2, c3, lambda1, lambda2, t0
+  double yieldSvensson(const void *pState, double dT)
+  {
+    const double *pS = static_cast<const double *>(pState);
+    PRECONDITION(dT >= pS[6]);
+
+    double dX1 = pS[4] * (dT - pS[6]);
+    double dX2 = pS[5] * (dT - pS[6]);
+    vega::ShapeValues uShapes1 = vega::Shapes::values(dX1);
+    return pS[0] + pS[1] * uShapes1.shape1 + pS[2] * uShapes1.shape2 +
+           pS[3] * vega::Shapes::shape2(dX2);
+  }
+
+  // r0, theta/lambda, sigma^2/2/lambda^2, lambda, t0
+  double discountVasicek(const void *pState, double dT)
+  {
+    const double *pS = static_cast<const double *>(pState);
+    PRECONDITION(dT >= pS[4]);
+
+    double dX = pS[3] * (dT - pS[4]);
+    vega::ShapeValues uShapes = vega::Shapes::values(dX);
+    double dY = pS[0] * uShapes.shape1 + pS[1] * (1 - uShapes.shape1) -
+                pS[2] * (1 - 2 * uShapes.shape1 + uShapes.shape1Of2x);
+    return std::exp(-dY * (dT - pS[4]));
+  }
+} // namespace curveArena
+
+vega::ArenaCurve::ArenaCurve(const void *pState, double (*pEval)(const void *, double))
+    : m_pState(pState), m_pEval(pEval)
+{
+}
+
+double vega::ArenaCurve::operator()(double dT) const
+{
+  return m_pEval(m_pState, dT);
+}
+
+vega::CurveArena::CurveArena(std::size_t iBlockBytes)
+    : m_uResource(iBlockBytes), m_iBytes(0)
+{
+}
+
+double *vega::CurveArena::allocate(std::size_t iDoubles)
+{
+  m_iBytes += iDoubles * sizeof(double);
+  return static_cast<double *>(m_uResource.allocate(iDoubles * sizeof(double), alignof(double)));
+}
+
+vega::ArenaCurve
+vega::CurveArena::discountLogLinInterp(const std::vector<double> &rDiscountTimes,
+                                       const std::vector<double> &rDiscountFactors,
+                                       double dInitialTime)
+{
+  PRECONDITION(std::is_sorted(rDiscountTimes.begin(), rDiscountTimes.end(), std::less_equal<double>()));
+  PRECONDITION(rDiscountTimes.size() == rDiscountFactors.size());
+  PRECONDITION(rDiscountTimes.front() > dInitialTime);
+
+  std::size_t iM = rDiscountTimes.size();
+  double *pS = allocate(2 + 2 * iM);
+  pS[0] = dInitialTime;
+  pS[1] = double(iM);
+  std::copy(rDiscountTimes.begin(), rDiscountTimes.end(), pS + 2);
+  std::transform(rDiscountFactors.begin(), rDiscountFactors.end(), pS + 2 + iM,
+                 [](double dDF)
+                 { return std::log(dDF); });
+  return ArenaCurve(pS, curveArena::discountLogLinInterp);
+}
+
+vega::ArenaCurve
+vega::CurveArena::discountNelsonSiegel(double dC0, double dC1, double dC2,
+                                       double dLambda, double dInitialTime)
+{
+  PRECONDITION(dLambda >= 0);
+
+  double *pS = allocate(5);
+  pS[0] = dC0;
+  pS[1] = dC1;
+  pS[2] = dC2;
+  pS[3] = dLambda;
+  pS[4] = dInitialTime;
+  return ArenaCurve(pS, curveArena::discountNelsonSiegel);
+}
+
+vega::ArenaCurve
+vega::CurveArena::yieldSvensson(double dC0, double dC1, double dC2, double dC3,
+                                double dLambda1, double dLambda2, double dInitialTime)
+{
+  PRECONDITION(dLambda1 != dLambda2);
+
+  double *pS = allocate(7);
+  double uS[7] = {dC0, dC1, dC2, dC3, dLambda1, dLambda2, dInitialTime};
+  std::copy(uS, uS + 7, pS);
+  return ArenaCurve(pS, curveArena::yieldSvensson);
+}
+
+vega::ArenaCurve
+vega::CurveArena::discountVasicek(double dTheta, double dLambda, double dSigma,
+                                  double dR0, double dInitialTime)
+{
+  PRECONDITION(dLambda > 0);
+  PRECONDITION(dSigma > 0);
+
+  double *pS = allocate(5);
+  pS[0] = dR0;
+  pS[1] = dTheta / dLambda;
+  pS[2] = (std::pow(dSigma, 2) / 2) / std::pow(dLambda, 2);
+  pS[3] = dLambda;
+  pS[4] = dInitialTime;
+  return ArenaCurve(pS, curveArena::discountVasicek);
+}
+
+std::size_t vega::CurveArena::bytes() const
+{
+  return m_iBytes;
+}
+
+void vega::CurveArena::release()
+{
+  m_uResource.release();
+  m_iBytes = 0;
+}
@@ -0,0 +1,80 @@
+#include "scenario/scenario.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+
+vega::DiscountLogLinInterpCurves::DiscountLogLinInterpCurves(const std::vector<double> &rDiscountTimes,
+                                                             double dInitialTime)
+    : m_uTimes(1, dInitialTime), m_uLogDF(rDiscountTimes.size() + 1)
+{
+  PRECONDITION(!rDiscountTimes.empty());
+  PRECONDITION(std::is_sorted(rDiscountTimes.begin(), rDiscountTimes.end(), std::less_equal<double>()));
+  PRECONDITION(rDiscountTimes.front() > dInitialTime);
+
+  m_uTimes.insert(m_uTimes.end(), rDiscountTimes.begin(), rDiscountTimes.end());
+}
+
+void vega::DiscountLogLinInterpCurves::push_back(const std::vector<double> &rDiscountFactors)
+{
+  PRECONDITION(rDiscountFactors.size() + 1 == m_uTimes.size());
+
+  // the discount factor at the initial time is 1
+  m_uLogDF.front().push_back(0.);
+  for (unsigned i = 0; i < rDiscountFactors.size(); i++)
+  {
+    PRECONDITION(rDiscountFactors[i] > 0);
+    m_uLogDF[i + 1].push_back(std::log(rDiscountFactors[i]));
+  }
+}
+
+unsigned vega::DiscountLogLinInterpCurves::size() const
+{
+  return m_uLogDF.front().size();
+}
+
+void vega::DiscountLogLinInterpCurves::discount(double dT, double *pDiscount) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end(), dT) - m_uTimes.begin();
+  double dW = (dT - m_uTimes[iI - 1]) / (m_uTimes[iI] - m_uTimes[iI - 1]);
+  const double *pY0 = m_uLogDF[iI - 1].data();
+  const double *pY1 = m_uLogDF[iI].data();
+  unsigned iSize = size();
+  for (unsigned n = 0; n < iSize; n++)
+  {
+    pDiscount[n] = std::exp(pY0[n] + dW * (pY1[n] - pY0[n]));
+  }
+}
+
+std::vector<double> vega::DiscountLogLinInterpCurves::discount(double dT) const
+{
+  std::vector<double> uDiscount(size());
+  discount(dT, uDiscount.data());
+  return uDiscount;
+}
+
+std::vector<double>
+vega::DiscountLogLinInterpCurves::discount(const std::vector<double> &rTimes) const
+{
+  unsigned iSize = size();
+  std::vector<double> uDiscount(rTimes.size() * iSize);
+  for (unsigned j = 0; j < rTimes.size(); j++)
+  {
+    discount(rTimes[j], uDiscount.data() + j * iSize);
+  }
+  return uDiscount;
+}
+
+std::function<double(double)> vega::DiscountLogLinInterpCurves::curve(unsigned iCurve) const
+{
+  PRECONDITION(iCurve < size());
+
+  std::vector<double> uTimes(m_uTimes.begin() + 1, m_uTimes.end());
+  std::vector<double> uDF(uTimes.size());
+  for (unsigned i = 0; i < uDF.size(); i++)
+  {
+    uDF[i] = std::exp(m_uLogDF[i + 1][iCurve]);
+  }
+  return discountLogLinInterp(uTimes, uDF, m_uTimes.front());
+}
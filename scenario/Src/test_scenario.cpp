@@ -0,0 +1,500 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Columns.hpp"
+#include "test/Market.hpp"
+#include "test/History.hpp"
+#include "test/Bench.hpp"
+#include "test/Allocations.hpp"
+#include "scenario/Output.hpp"
+#include "scenario/scenario.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+#include <cstdio>
+
+using namespace test;
+using namespace std;
+
+// row-major matrix of coefficients: the base coefficients plus parallel shifts
+std::vector<double> scenarios(const std::vector<double> &rBase, unsigned iScenarios)
+{
+  std::valarray<double> uShift = getRandArg(-0.01, 0.01, iScenarios * rBase.size());
+  std::vector<double> uCoeff(iScenarios * rBase.size());
+  for (unsigned i = 0; i < uCoeff.size(); i++)
+  {
+    uCoeff[i] = rBase[i % rBase.size()] + uShift[i];
+  }
+  return uCoeff;
+}
+
+void nelsonSiegelScenarios()
+{
+  test::print("NELSON-SIEGEL CURVES FOR MANY SCENARIOS");
+
+  double dLambda = 0.05;
+  double dInitialTime = 1.5;
+  double dMaturity = dInitialTime + 10.;
+  unsigned iTimes = 40;
+  unsigned iScenarios = 1000;
+  std::vector<double> uBase = {0.02, 0.04, 0.06};
+
+  print(dLambda, "lambda");
+  print(dInitialTime, "initial time");
+  print(dMaturity, "last time");
+  print(iTimes, "number of times");
+  print(iScenarios, "number of scenarios", true);
+
+  std::vector<double> uTimes = getTimes(dInitialTime, dMaturity, iTimes);
+  std::vector<double> uCoeff = scenarios(uBase, iScenarios);
+
+  std::vector<double> uYield =
+      vega::yieldNelsonSiegelScenarios(uTimes, dLambda, dInitialTime)(uCoeff);
+  std::vector<double> uDiscount =
+      vega::discountNelsonSiegelScenarios(uTimes, dLambda, dInitialTime)(uCoeff);
+
+  std::valarray<double> uExactYield(uYield.size());
+  std::valarray<double> uExactDiscount(uDiscount.size());
+  for (unsigned n = 0; n < iScenarios; n++)
+  {
+    const double *pC = uCoeff.data() + 3 * n;
+    std::function<double(double)> uY =
+        vega::yieldNelsonSiegel(pC[0], pC[1], pC[2], dLambda, dInitialTime);
+    std::function<double(double)> uD =
+        vega::discountNelsonSiegel(pC[0], pC[1], pC[2], dLambda, dInitialTime);
+    for (unsigned j = 0; j < iTimes; j++)
+    {
+      uExactYield[n * iTimes + j] = uY(uTimes[j]);
+      uExactDiscount[n * iTimes + j] = uD(uTimes[j]);
+    }
+  }
+
+  compare(uExactYield, std::valarray<double>(uYield.data(), uYield.size()),
+          "yields: closures versus matrix product");
+  compare(uExactDiscount, std::valarray<double>(uDiscount.data(), uDiscount.size()),
+          "discount factors: closures versus matrix product");
+}
+
+void svenssonScenarios()
+{
+  test::print("SVENSSON CURVES FOR MANY SCENARIOS");
+
+  double dLambda1 = 0.05;
+  double dLambda2 = 0.07;
+  double dInitialTime = 1.5;
+  double dMaturity = dInitialTime + 10.;
+  unsigned iTimes = 40;
+  unsigned iScenarios = 1000;
+  std::vector<double> uBase = {0.02, 0.04, 0.06, 0.03};
+
+  print(dLambda1, "lambda 1");
+  print(dLambda2, "lambda 2");
+  print(dInitialTime, "initial time");
+  print(dMaturity, "last time");
+  print(iTimes, "number of times");
+  print(iScenarios, "number of scenarios", true);
+
+  std::vector<double> uTimes = getTimes(dInitialTime, dMaturity, iTimes);
+  std::vector<double> uCoeff = scenarios(uBase, iScenarios);
+
+  std::vector<double> uYield =
+      vega::yieldSvenssonScenarios(uTimes, dLambda1, dLambda2, dInitialTime)(uCoeff);
+  std::vector<double> uDiscount =
+      vega::discountSvenssonScenarios(uTimes, dLambda1, dLambda2, dInitialTime)(uCoeff);
+
+  std::valarray<double> uExactYield(uYield.size());
+  std::valarray<double> uExactDiscount(uDiscount.size());
+  for (unsigned n = 0; n < iScenarios; n++)
+  {
+    const double *pC = uCoeff.data() + 4 * n;
+    std::function<double(double)> uY =
+        vega::yieldSvensson(pC[0], pC[1], pC[2], pC[3], dLambda1, dLambda2, dInitialTime);
+    for (unsigned j = 0; j < iTimes; j++)
+    {
+      double dY = uY(uTimes[j]);
+      uExactYield[n * iTimes + j] = dY;
+      uExactDiscount[n * iTimes + j] = std::exp(-dY * (uTimes[j] - dInitialTime));
+    }
+  }
+
+  compare(uExactYield, std::valarray<double>(uYield.data(), uYield.size()),
+          "yields: closures versus matrix product");
+  compare(uExactDiscount, std::valarray<double>(uDiscount.data(), uDiscount.size()),
+          "discount factors: closures versus matrix product");
+}
+
+void discountLogLinInterpCurves()
+{
+  test::print("LOG-LINEAR DISCOUNT CURVES FOR MANY DAYS");
+
+  double dInitialTime = 1.;
+  unsigned iDays = 2000;
+  unsigned iDates = 25;
+
+  auto uDF = test::getDiscount(dInitialTime);
+  print(iDays, "number of days");
+  print(iDates, "number of dates", true);
+
+  // every day the market yields move in parallel
+  std::valarray<double> uShift = getRandArg(-0.02, 0.02, iDays);
+  vega::DiscountLogLinInterpCurves uCurves(uDF.first, dInitialTime);
+  std::vector<std::vector<double>> uDays(iDays, uDF.second);
+  for (unsigned n = 0; n < iDays; n++)
+  {
+    for (unsigned i = 0; i < uDF.first.size(); i++)
+    {
+      uDays[n][i] *= std::exp(-uShift[n] * (uDF.first[i] - dInitialTime));
+    }
+    uCurves.push_back(uDays[n]);
+  }
+
+  std::valarray<double> uArg = getRandArg(dInitialTime, uDF.first.back(), iDates);
+  std::vector<double> uDates(std::begin(uArg), std::end(uArg));
+  std::vector<double> uResult = uCurves.discount(uDates);
+
+  std::valarray<double> uExact(uResult.size());
+  for (unsigned n = 0; n < iDays; n++)
+  {
+    std::function<double(double)> uDiscount =
+        vega::discountLogLinInterp(uDF.first, uDays[n], dInitialTime);
+    for (unsigned j = 0; j < iDates; j++)
+    {
+      uExact[j * iDays + n] = uDiscount(uDates[j]);
+    }
+  }
+  compare(uExact, std::valarray<double>(uResult.data(), uResult.size()),
+          "discount factors: closures versus SoA curves");
+
+  print("curve of the last day:");
+  test::print(uCurves.curve(iDays - 1), dInitialTime, uDF.first.back() - dInitialTime);
+}
+
+void columnarOutput()
+{
+  test::print("BINARY COLUMNAR FILE OF SCENARIO CURVES");
+
+  double dLambda = 0.05;
+  double dInitialTime = 1.5;
+  double dMaturity = dInitialTime + 30.;
+  unsigned iTimes = 120;
+  unsigned iScenarios = 10000;
+  std::vector<double> uBase = {0.02, 0.04, 0.06};
+
+  print(iTimes, "number of times (columns)");
+  print(iScenarios, "number of scenarios (rows)", true);
+
+  std::vector<double> uTimes = getTimes(dInitialTime, dMaturity, iTimes);
+  std::vector<double> uDiscount =
+      vega::discountNelsonSiegelScenarios(uTimes, dLambda, dInitialTime)(scenarios(uBase, iScenarios));
+
+  // one column per time
+  std::vector<std::vector<double>> uColumns(iTimes, std::vector<double>(iScenarios));
+  std::vector<std::string> uNames(iTimes);
+  for (unsigned j = 0; j < iTimes; j++)
+  {
+    uNames[j] = "t=" + std::to_string(uTimes[j]);
+    for (unsigned n = 0; n < iScenarios; n++)
+    {
+      uColumns[j][n] = uDiscount[n * iTimes + j];
+    }
+  }
+  std::string sFile = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME + "/discountNelsonSiegel.col";
+  writeColumns(sFile, uColumns, uNames);
+
+  ColumnFile uFile(sFile);
+  print(uFile.rows(), "rows in the file");
+  print(uFile.names().size(), "columns in the file", true);
+  std::valarray<double> uExact(iTimes), uMapped(iTimes);
+  for (unsigned j = 0; j < iTimes; j++)
+  {
+    ColumnView uColumn = uFile.column(uNames[j]);
+    uExact[j] = uColumns[j][iScenarios - 1];
+    uMapped[j] = uColumn[iScenarios - 1];
+  }
+  compare(uExact, uMapped, "discount factors of the last scenario: memory versus mapped file");
+}
+
+void marketDataLoader()
+{
+  test::print("LOADING OF MARKET CURVES FROM CSV AND BINARY FILES");
+
+  double dInitialTime = 1.;
+  unsigned iCurves = 50000;
+
+  // every curve is the market discount curve with a parallel shift
+  auto uDF = test::getDiscount(dInitialTime);
+  std::valarray<double> uShift = getRandArg(-0.02, 0.02, iCurves);
+  MarketData uData;
+  std::vector<double> uValues(uDF.second.size());
+  for (unsigned n = 0; n < iCurves; n++)
+  {
+    for (unsigned i = 0; i < uValues.size(); i++)
+    {
+      uValues[i] = uDF.second[i] * std::exp(-uShift[n] * (uDF.first[i] - dInitialTime));
+    }
+    uData.push_back("discount" + std::to_string(n), uDF.first, uValues);
+  }
+  print(iCurves, "number of curves");
+  print(uDF.first.size(), "number of quotes in a curve", true);
+
+  std::string sFile = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME + "/discount";
+  writeMarketCsv(sFile + ".csv", uData);
+  writeMarket(sFile + ".mkt", uData);
+
+  double dStart = seconds();
+  MarketData uCsv = readMarketCsv(sFile + ".csv");
+  double dCsv = seconds() - dStart;
+  dStart = seconds();
+  MarketFile uBinary(sFile + ".mkt");
+  double dBinary = seconds() - dStart;
+  print(dCsv, "seconds to read the CSV file");
+  print(dBinary, "seconds to map the binary file", true);
+
+  // the views are copied once into the vectors moved into the curves
+  unsigned iLast = iCurves - 1;
+  print(uCsv.size(), "curves in the CSV file");
+  print(uBinary.size(), "curves in the binary file", true);
+  print("last curve: " + std::string(uBinary.curve(iLast).name));
+  std::function<double(double)> uExact =
+      vega::discountLogLinInterp(std::vector<double>(uData.curve(iLast).times),
+                                 std::vector<double>(uData.curve(iLast).values), dInitialTime);
+  std::function<double(double)> uFromCsv =
+      vega::discountLogLinInterp(std::vector<double>(uCsv.curve(iLast).times),
+                                 std::vector<double>(uCsv.curve(iLast).values), dInitialTime);
+  std::function<double(double)> uFromBinary =
+      vega::discountLogLinInterp(std::vector<double>(uBinary.curve(iLast).times),
+                                 std::vector<double>(uBinary.curve(iLast).values), dInitialTime);
+
+  std::valarray<double> uArg = getRandArg(dInitialTime, uDF.first.back(), 10);
+  std::valarray<double> uMemory(uArg.size()), uCsvValues(uArg.size()),
+      uBinaryValues(uArg.size());
+  for (unsigned j = 0; j < uArg.size(); j++)
+  {
+    uMemory[j] = uExact(uArg[j]);
+    uCsvValues[j] = uFromCsv(uArg[j]);
+    uBinaryValues[j] = uFromBinary(uArg[j]);
+  }
+  compare(uMemory, uCsvValues, "discount factors of the last curve: memory versus CSV file");
+  compare(uMemory, uBinaryValues, "discount factors of the last curve: memory versus binary file");
+}
+
+namespace NHistory
+{
+  // the quotes of iDays days: every day a quote is refreshed with
+  // probability 1/2 by a random relative move, otherwise it is stale
+  std::vector<std::vector<double>> days(const std::vector<double> &rQuotes, unsigned iDays,
+                                        double dMove)
+  {
+    std::valarray<double> uMove = getRandArg(-dMove, dMove, iDays * rQuotes.size());
+    std::valarray<double> uFresh = getRandArg(0., 1., iDays * rQuotes.size());
+    std::vector<std::vector<double>> uDays(iDays, rQuotes);
+    for (unsigned n = 1; n < iDays; n++)
+    {
+      for (unsigned i = 0; i < rQuotes.size(); i++)
+      {
+        unsigned k = n * rQuotes.size() + i;
+        uDays[n][i] = (uFresh[k] < 0.5) ? uDays[n - 1][i] * (1. + uMove[k]) : uDays[n - 1][i];
+      }
+    }
+    return uDays;
+  }
+
+  // writes the history in two runs, reads it back and returns the
+  // numbers of the table: bytes of raw doubles, bytes of the file,
+  // nanoseconds to decode a day and the number of wrong days
+  std::vector<double> archive(const std::string &sFile, const std::vector<double> &rTimes,
+                              const std::vector<std::vector<double>> &rDays)
+  {
+    std::remove(sFile.c_str());
+    // the second run rewrites the incomplete block of the first one
+    std::size_t iHalf = rDays.size() / 2;
+    for (std::size_t iBegin : {std::size_t(0), iHalf})
+    {
+      HistoryWriter uWriter(sFile, rTimes);
+      std::size_t iEnd = (iBegin == 0) ? iHalf : rDays.size();
+      for (std::size_t n = iBegin; n < iEnd; n++)
+      {
+        uWriter.append(rDays[n]);
+      }
+    }
+    HistoryFile uFile(sFile);
+    std::ifstream fIn(sFile.c_str(), std::ios::binary | std::ios::ate);
+    double dBytes = double(fIn.tellg());
+
+    double dWrong = 0.;
+    double dStart = seconds();
+    uFile.values(0, uFile.days(), [&rDays, &dWrong](std::size_t iDay, const std::vector<double> &rValues)
+                 { dWrong += (rValues != rDays[iDay]); });
+    double dDecode = 1e9 * (seconds() - dStart) / uFile.days();
+    return {double(rDays.size() * rTimes.size() * sizeof(double)), dBytes, dDecode, dWrong};
+  }
+} // namespace NHistory
+
+void compressedHistory()
+{
+  test::print("COMPRESSED HISTORY OF DAILY CURVES");
+
+  double dInitialTime = 1.;
+  unsigned iDays = 2500;
+  print(iDays, "number of days", true);
+
+  auto uDF = test::getDiscount(dInitialTime);
+  auto uF = test::getForward(100., dInitialTime);
+  auto uVol = test::getVol(dInitialTime);
+  std::vector<std::vector<double>> uDiscountDays = NHistory::days(uDF.second, iDays, 1e-4);
+  std::vector<std::vector<double>> uForwardDays = NHistory::days(uF.second, iDays, 1e-3);
+  std::vector<std::vector<double>> uVolDays = NHistory::days(uVol.second, iDays, 1e-2);
+
+  std::string sDir = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME;
+  std::vector<std::vector<double>> uColumns(4);
+  std::vector<std::vector<double>> uRows = {
+      NHistory::archive(sDir + "/discount.hst", uDF.first, uDiscountDays),
+      NHistory::archive(sDir + "/forward.hst", uF.first, uForwardDays),
+      NHistory::archive(sDir + "/volatility.hst", uVol.first, uVolDays)};
+  for (const std::vector<double> &rRow : uRows)
+  {
+    for (unsigned j = 0; j < uColumns.size(); j++)
+    {
+      uColumns[j].push_back(rRow[j]);
+    }
+  }
+  // the times of decoding depend on the machine
+  printTable(uColumns, {"raw bytes", "file bytes", "ns/day", "wrong days"},
+             "sizes of histories and times of decoding", 14, 3, uRows.size());
+  print("row 0: discount factors");
+  print("row 1: forward prices");
+  print("row 2: volatilities");
+  out() << endl;
+
+  // random access to one day and the curves of this day
+  unsigned iDay = 1234;
+  HistoryFile uDiscount(sDir + "/discount.hst");
+  HistoryFile uForward(sDir + "/forward.hst");
+  HistoryFile uVolatility(sDir + "/volatility.hst");
+  std::function<double(double)> uCurves[3] = {
+      vega::discountLogLinInterp(std::vector<double>(uDiscount.times()), uDiscount.values(iDay), dInitialTime),
+      vega::forwardCarryLinInterp(100., std::vector<double>(uForward.times()), uForward.values(iDay), dInitialTime),
+      vega::volatilityVarLinInterp(std::vector<double>(uVolatility.times()), uVolatility.values(iDay), dInitialTime)};
+  std::function<double(double)> uExact[3] = {
+      vega::discountLogLinInterp(uDF.first, uDiscountDays[iDay], dInitialTime),
+      vega::forwardCarryLinInterp(100., uF.first, uForwardDays[iDay], dInitialTime),
+      vega::volatilityVarLinInterp(uVol.first, uVolDays[iDay], dInitialTime)};
+  std::string uNames[3] = {"discount", "forward", "volatility"};
+  print(iDay, "day of random access", true);
+  std::valarray<double> uArg = getRandArg(dInitialTime, uVol.first.back(), 10);
+  for (unsigned k = 0; k < 3; k++)
+  {
+    std::valarray<double> uX(uArg.size()), uY(uArg.size());
+    for (unsigned j = 0; j < uArg.size(); j++)
+    {
+      uX[j] = uExact[k](uArg[j]);
+      uY[j] = uCurves[k](uArg[j]);
+    }
+    compare(uX, uY, uNames[k] + " curve of the day: quotes versus history");
+  }
+}
+
+void arenaCurves()
+{
+  test::print("CURVES OF MANY SCENARIOS IN AN ARENA");
+
+  double dInitialTime = 1.;
+  unsigned iScenarios = 100000;
+  print(iScenarios, "number of scenarios");
+  print("every scenario has 4 curves: discountLogLinInterp, discountNelsonSiegel,");
+  print("yieldSvensson and discountVasicek");
+  out() << endl;
+
+  auto uDF = test::getDiscount(dInitialTime);
+  std::valarray<double> uShift = getRandArg(-0.02, 0.02, iScenarios);
+  std::vector<std::vector<double>> uDays(iScenarios, uDF.second);
+  for (unsigned n = 0; n < iScenarios; n++)
+  {
+    for (unsigned i = 0; i < uDF.first.size(); i++)
+    {
+      uDays[n][i] *= std::exp(-uShift[n] * (uDF.first[i] - dInitialTime));
+    }
+  }
+
+  std::vector<std::function<double(double)>> uBuilt;
+  uBuilt.reserve(4 * iScenarios);
+  std::size_t iBefore = allocations();
+  double dStart = seconds();
+  for (unsigned n = 0; n < iScenarios; n++)
+  {
+    double dS = uShift[n];
+    uBuilt.push_back(vega::discountLogLinInterp(uDF.first, uDays[n], dInitialTime));
+    uBuilt.push_back(vega::discountNelsonSiegel(0.05 + dS, 0.02, 0.01, 0.2, dInitialTime));
+    uBuilt.push_back(vega::yieldSvensson(0.05 + dS, 0.02, 0.01, 0.015, 0.2, 0.7, dInitialTime));
+    uBuilt.push_back(vega::discountVasicek(0.01, 0.3, 0.01, 0.04 + dS, dInitialTime));
+  }
+  double dBuilders = seconds() - dStart;
+  std::size_t iBuilders = allocations() - iBefore;
+
+  vega::CurveArena uArena;
+  std::vector<std::function<double(double)>> uArenaCurves;
+  uArenaCurves.reserve(4 * iScenarios);
+  iBefore = allocations();
+  dStart = seconds();
+  for (unsigned n = 0; n < iScenarios; n++)
+  {
+    double dS = uShift[n];
+    uArenaCurves.push_back(uArena.discountLogLinInterp(uDF.first, uDays[n], dInitialTime));
+    uArenaCurves.push_back(uArena.discountNelsonSiegel(0.05 + dS, 0.02, 0.01, 0.2, dInitialTime));
+    uArenaCurves.push_back(uArena.yieldSvensson(0.05 + dS, 0.02, 0.01, 0.015, 0.2, 0.7, dInitialTime));
+    uArenaCurves.push_back(uArena.discountVasicek(0.01, 0.3, 0.01, 0.04 + dS, dInitialTime));
+  }
+  double dArena = seconds() - dStart;
+  std::size_t iArena = allocations() - iBefore;
+
+  std::vector<std::vector<double>> uColumns = {
+      {double(iBuilders), double(iArena)},
+      {double(iBuilders) / iScenarios, double(iArena) / iScenarios},
+      {1e9 * dBuilders / iScenarios, 1e9 * dArena / iScenarios}};
+  // the times depend on the machine
+  printTable(uColumns, {"allocations", "per scenario", "ns/scenario"},
+             "construction of curves", 14, 3, 2);
+  print("row 0: builders of Vega");
+  print("row 1: arena of curves");
+  out() << endl;
+  print(uArena.bytes(), "bytes of states in the arena", true);
+
+  std::valarray<double> uArg = getRandArg(dInitialTime, uDF.first.back(), 10);
+  double dDifferent = 0.;
+  for (unsigned k = 0; k < uBuilt.size(); k++)
+  {
+    for (double dT : uArg)
+    {
+      dDifferent += (uBuilt[k](dT) != uArenaCurves[k](dT));
+    }
+  }
+  print(dDifferent, "values of arena curves that differ from the builders", true);
+
+  uArenaCurves.clear();
+  iBefore = allocations();
+  uArena.release();
+  std::size_t iRelease = allocations() - iBefore;
+  print(iRelease, "allocations to release the arena", true);
+}
+
+std::function<void()> test_scenario()
+{
+  return []()
+  {
+    print("CURVES FOR MANY MARKET SCENARIOS");
+
+    nelsonSiegelScenarios();
+    svenssonScenarios();
+    discountLogLinInterpCurves();
+    columnarOutput();
+    marketDataLoader();
+    compressedHistory();
+    arenaCurves();
+  };
+}
+
+int main()
+{
+  project(test_scenario(), PROJECT_NAME, PROJECT_NAME,
+          "Scenario curves");
+}
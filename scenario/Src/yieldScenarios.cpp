@@ -0,0 +1,122 @@
+#include "scenario/scenario.hpp"
+#include "prep1/prep1.hpp"
+#include "vega/shapes.hpp"
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+
+namespace scenarioBasis
+{
+  // row-major K x M matrix, the row k contains the shape k on the grid;
+  // for discount factors every column is multiplied by -(t_j - t_0)
+  std::vector<double>
+  basis(const std::vector<double> &rTimes, double dInitialTime,
+        const std::vector<std::function<double(double)>> &rShapes,
+        bool bDiscount)
+  {
+    PRECONDITION(std::all_of(rTimes.begin(), rTimes.end(), [dInitialTime](double dT)
+                             { return dT >= dInitialTime; }));
+
+    unsigned iM = rTimes.size();
+    std::vector<double> uBasis(rShapes.size() * iM);
+    for (unsigned k = 0; k < rShapes.size(); k++)
+    {
+      for (unsigned j = 0; j < iM; j++)
+      {
+        double dT = rTimes[j] - dInitialTime;
+        double dB = rShapes[k](dT);
+        uBasis[k * iM + j] = (bDiscount) ? -dT * dB : dB;
+      }
+    }
+    return uBasis;
+  }
+
+  std::function<std::vector<double>(const std::vector<double> &)>
+  product(const std::vector<double> &rBasis, unsigned iFactors, bool bDiscount)
+  {
+    unsigned iM = rBasis.size() / iFactors;
+    return [rBasis, iFactors, iM, bDiscount](const std::vector<double> &rCoeff)
+    {
+      PRECONDITION(rCoeff.size() % iFactors == 0);
+
+      unsigned iN = rCoeff.size() / iFactors;
+      std::vector<double> uResult(iN * iM);
+      if (uResult.empty())
+      {
+        return uResult;
+      }
+
+      gsl_matrix_const_view uC = gsl_matrix_const_view_array(rCoeff.data(), iN, iFactors);
+      gsl_matrix_const_view uB = gsl_matrix_const_view_array(rBasis.data(), iFactors, iM);
+      gsl_matrix_view uY = gsl_matrix_view_array(uResult.data(), iN, iM);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1., &uC.matrix, &uB.matrix, 0., &uY.matrix);
+
+      if (bDiscount)
+      {
+        // the exponents are already -gamma(t)(t-t0)
+        double *pY = uResult.data();
+        std::size_t iSize = uResult.size();
+        for (std::size_t i = 0; i < iSize; i++)
+        {
+          pY[i] = std::exp(pY[i]);
+        }
+      }
+      return uResult;
+    };
+  }
+
+  std::vector<std::function<double(double)>>
+  nelsonSiegel(double dLambda)
+  {
+    PRECONDITION(dLambda >= 0);
+
+    return {[](double dT)
+            { return 1.; },
+            [dLambda](double dT)
+            { return vega::Shapes::shape1(dLambda * dT); },
+            [dLambda](double dT)
+            { return vega::Shapes::shape2(dLambda * dT); }};
+  }
+
+  std::vector<std::function<double(double)>>
+  svensson(double dLambda1, double dLambda2)
+  {
+    PRECONDITION(dLambda2 >= 0);
+
+    std::vector<std::function<double(double)>> uShapes = nelsonSiegel(dLambda1);
+    uShapes.push_back([dLambda2](double dT)
+                      { return vega::Shapes::shape2(dLambda2 * dT); });
+    return uShapes;
+  }
+} // namespace scenarioBasis
+
+using namespace scenarioBasis;
+
+std::function<std::vector<double>(const std::vector<double> &)>
+vega::yieldNelsonSiegelScenarios(const std::vector<double> &rTimes,
+                                 double dLambda, double dInitialTime)
+{
+  return product(basis(rTimes, dInitialTime, nelsonSiegel(dLambda), false), 3, false);
+}
+
+std::function<std::vector<double>(const std::vector<double> &)>
+vega::discountNelsonSiegelScenarios(const std::vector<double> &rTimes,
+                                    double dLambda, double dInitialTime)
+{
+  return product(basis(rTimes, dInitialTime, nelsonSiegel(dLambda), true), 3, true);
+}
+
+std::function<std::vector<double>(const std::vector<double> &)>
+vega::yieldSvenssonScenarios(const std::vector<double> &rTimes,
+                             double dLambda1, double dLambda2,
+                             double dInitialTime)
+{
+  return product(basis(rTimes, dInitialTime, svensson(dLambda1, dLambda2), false), 4, false);
+}
+
+std::function<std::vector<double>(const std::vector<double> &)>
+vega::discountSvenssonScenarios(const std::vector<double> &rTimes,
+                                double dLambda1, double dLambda2,
+                                double dInitialTime)
+{
+  return product(basis(rTimes, dInitialTime, svensson(dLambda1, dLambda2), true), 4, true);
+}
@@ -0,0 +1,343 @@
+#ifndef __vega_scenario_hpp__
+#define __vega_scenario_hpp__
+
+/**
+ * @file scenario.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Curves for many market scenarios
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <memory_resource>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaScenario Curves for many market scenarios.
+   *
+   * This module evaluates families of curves, one for every market
+   * scenario, on a common grid of times.
+   *
+   * @{
+   */
+
+  /**
+   * Computes the Nelson-Siegel yield curves for many scenarios on a
+   * fixed grid of times \f$(t_j)_{j=1,\dots,M}\f$. For given
+   * \f$\lambda\f$ the yield is linear in the coefficients:
+   * \f[
+   *  \gamma_n(t_j) = \sum_{k=0}^{2} c_{n,k} B_k(t_j),
+   * \f]
+   * where \f$B_0 = 1\f$, \f$B_1\f$ and \f$B_2\f$ are the shapes
+   * from yieldShape1() and yieldShape2(). The basis matrix \f$B\f$ is
+   * computed once and the curves for all scenarios are obtained as
+   * one matrix product \f$C B\f$ by GSL CBLAS.
+   *
+   * @param rTimes \f$(t_j)_{j=1,\dots,M}\f$ The grid of times,
+   * \f$t_j\geq t_0\f$.
+   * @param dLambda \f$\lambda\geq 0\f$ The mean-reversion rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   *
+   * @return The function that maps the row-major \f$N\times 3\f$
+   * matrix of coefficients \f$(c_{n,0},c_{n,1},c_{n,2})\f$ to the
+   * row-major \f$N\times M\f$ matrix of yields \f$\gamma_n(t_j)\f$.
+   */
+  std::function<std::vector<double>(const std::vector<double> &)>
+  yieldNelsonSiegelScenarios(const std::vector<double> &rTimes,
+                             double dLambda, double dInitialTime);
+
+  /**
+   * Computes the Nelson-Siegel discount curves for many scenarios
+   * on a fixed grid of times:
+   * \f[
+   *  d_n(t_j) = e^{-\gamma_n(t_j)(t_j-t_0)},
+   * \f]
+   * where \f$\gamma_n\f$ are given by yieldNelsonSiegelScenarios().
+   * The factors \f$-(t_j-t_0)\f$ are absorbed into the basis matrix,
+   * so the discount factors are computed by one matrix product
+   * followed by a single vectorized pass of exponentials.
+   *
+   * @param rTimes \f$(t_j)_{j=1,\dots,M}\f$ The grid of times,
+   * \f$t_j\geq t_0\f$.
+   * @param dLambda \f$\lambda\geq 0\f$ The mean-reversion rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   *
+   * @return The function that maps the row-major \f$N\times 3\f$
+   * matrix of coefficients to the row-major \f$N\times M\f$ matrix
+   * of discount factors \f$d_n(t_j)\f$.
+   */
+  std::function<std::vector<double>(const std::vector<double> &)>
+  discountNelsonSiegelScenarios(const std::vector<double> &rTimes,
+                                double dLambda, double dInitialTime);
+
+  /**
+   * Computes the Svensson yield curves for many scenarios on a fixed
+   * grid of times \f$(t_j)_{j=1,\dots,M}\f$:
+   * \f[
+   *  \gamma_n(t_j) = c_{n,0} + c_{n,1} \Gamma_1(\lambda_1(t_j-t_0)) +
+   *  c_{n,2} \Gamma_2(\lambda_1(t_j-t_0)) +
+   *  c_{n,3} \Gamma_2(\lambda_2(t_j-t_0)),
+   * \f]
+   * where \f$\Gamma_1\f$ and \f$\Gamma_2\f$ are the shapes from
+   * yieldShape1() and yieldShape2(). The curves for all scenarios are
+   * obtained as one matrix product by GSL CBLAS.
+   *
+   * @param rTimes \f$(t_j)_{j=1,\dots,M}\f$ The grid of times,
+   * \f$t_j\geq t_0\f$.
+   * @param dLambda1 \f$\lambda_1\geq 0\f$ The first mean-reversion rate.
+   * @param dLambda2 \f$\lambda_2\geq 0\f$ The second mean-reversion rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   *
+   * @return The function that maps the row-major \f$N\times 4\f$
+   * matrix of coefficients \f$(c_{n,0},\dots,c_{n,3})\f$ to the
+   * row-major \f$N\times M\f$ matrix of yields \f$\gamma_n(t_j)\f$.
+   */
+  std::function<std::vector<double>(const std::vector<double> &)>
+  yieldSvenssonScenarios(const std::vector<double> &rTimes,
+                         double dLambda1, double dLambda2,
+                         double dInitialTime);
+
+  /**
+   * Computes the Svensson discount curves for many scenarios on a
+   * fixed grid of times:
+   * \f[
+   *  d_n(t_j) = e^{-\gamma_n(t_j)(t_j-t_0)},
+   * \f]
+   * where \f$\gamma_n\f$ are given by yieldSvenssonScenarios().
+   *
+   * @param rTimes \f$(t_j)_{j=1,\dots,M}\f$ The grid of times,
+   * \f$t_j\geq t_0\f$.
+   * @param dLambda1 \f$\lambda_1\geq 0\f$ The first mean-reversion rate.
+   * @param dLambda2 \f$\lambda_2\geq 0\f$ The second mean-reversion rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   *
+   * @return The function that maps the row-major \f$N\times 4\f$
+   * matrix of coefficients to the row-major \f$N\times M\f$ matrix
+   * of discount factors \f$d_n(t_j)\f$.
+   */
+  std::function<std::vector<double>(const std::vector<double> &)>
+  discountSvenssonScenarios(const std::vector<double> &rTimes,
+                            double dLambda1, double dLambda2,
+                            double dInitialTime);
+
+  /**
+   * @brief Many discount curves obtained by the log-linear
+   * interpolation of market discount factors at common maturities.
+   *
+   * The class holds one discount curve per day (scenario) and
+   * reproduces discountLogLinInterp() for each of them. The logarithms
+   * of discount factors are kept in the structure-of-arrays layout:
+   * for every maturity \f$t_i\f$ the values of all curves are stored
+   * contiguously. The evaluation of all curves at time \f$t\f$ needs
+   * one binary search for the interval \f$[t_{i-1},t_i]\f$ followed
+   * by a vectorized loop over the curves.
+   */
+  class DiscountLogLinInterpCurves
+  {
+  public:
+    /**
+     * Constructs the empty collection of discount curves.
+     *
+     * @param rDiscountTimes The maturities of the market discount
+     * factors, common for all curves.
+     * @param dInitialTime The initial time.
+     */
+    DiscountLogLinInterpCurves(const std::vector<double> &rDiscountTimes,
+                               double dInitialTime);
+
+    /**
+     * Adds the discount curve for the next day.
+     *
+     * @param rDiscountFactors The market discount factors at the
+     * maturities given in the constructor.
+     */
+    void push_back(const std::vector<double> &rDiscountFactors);
+
+    /**
+     * Returns the number of curves.
+     *
+     * @return The number of curves in the collection.
+     */
+    unsigned size() const;
+
+    /**
+     * Computes the discount factors of all curves at time \p dT.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @param pDiscount The output array of size size().
+     */
+    void discount(double dT, double *pDiscount) const;
+
+    /**
+     * Computes the discount factors of all curves at time \p dT.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The discount factors of all curves.
+     */
+    std::vector<double> discount(double dT) const;
+
+    /**
+     * Computes the discount factors of all curves at given times.
+     *
+     * @param rTimes The maturities.
+     * @return The row-major matrix of discount factors with one row
+     * per maturity and one column per curve.
+     */
+    std::vector<double> discount(const std::vector<double> &rTimes) const;
+
+    /**
+     * Returns the discount curve for a single day as a function.
+     *
+     * @param iCurve The index of the curve.
+     * @return The discount curve with index \p iCurve.
+     */
+    std::function<double(double)> curve(unsigned iCurve) const;
+
+  private:
+    /** The initial time followed by the market maturities. */
+    std::vector<double> m_uTimes;
+    /** The logarithms of discount factors; one row per maturity. */
+    std::vector<std::vector<double>> m_uLogDF;
+  };
+
+  /**
+   * @brief A curve whose state lives in a CurveArena.
+   *
+   * The curve is a pointer to its state and a pointer to the function
+   * that evaluates it. It is trivially copyable and small enough for
+   * the local buffer of std::function, so it converts to
+   * std::function<double(double)> without an allocation. The curve is
+   * valid until the arena is released.
+   */
+  class ArenaCurve
+  {
+  public:
+    /**
+     * Constructs the curve.
+     *
+     * @param pState The state of the curve.
+     * @param pEval The function of the state and time.
+     */
+    ArenaCurve(const void *pState, double (*pEval)(const void *, double));
+
+    /**
+     * Evaluates the curve.
+     *
+     * @param dT The time.
+     * @return The value of the curve at \p dT.
+     */
+    double operator()(double dT) const;
+
+  private:
+    const void *m_pState;
+    double (*m_pEval)(const void *, double);
+  };
+
+  /**
+   * @brief The factory of curves for many scenarios with the states
+   * in a monotonic arena.
+   *
+   * The builders of Vega allocate the storage of std::function and
+   * copy the vectors of knots into the closures; nested curves add
+   * more allocations. The factory places the parameters and the
+   * tables of knots of every curve contiguously into large blocks of
+   * memory obtained from std::pmr::monotonic_buffer_resource and
+   * releases all of them at once. The curves evaluate bit-identically
+   * to the curves of the corresponding builders.
+   */
+  class CurveArena
+  {
+  public:
+    /**
+     * Constructs the empty arena.
+     *
+     * @param iBlockBytes The size of the first block of memory.
+     */
+    explicit CurveArena(std::size_t iBlockBytes = 1 << 16);
+
+    CurveArena(const CurveArena &) = delete;
+    CurveArena &operator=(const CurveArena &) = delete;
+
+    /**
+     * Builds the curve of discountLogLinInterp(). The logarithms of
+     * discount factors are computed once.
+     *
+     * @param rDiscountTimes The maturities of market discount factors.
+     * @param rDiscountFactors The market discount factors.
+     * @param dInitialTime The initial time.
+     * @return The discount curve.
+     */
+    ArenaCurve discountLogLinInterp(const std::vector<double> &rDiscountTimes,
+                                    const std::vector<double> &rDiscountFactors,
+                                    double dInitialTime);
+
+    /**
+     * Builds the curve of discountNelsonSiegel().
+     *
+     * @param dC0 The first constant.
+     * @param dC1 The second constant.
+     * @param dC2 The third constant.
+     * @param dLambda The mean-reversion rate.
+     * @param dInitialTime The initial time.
+     * @return The discount curve.
+     */
+    ArenaCurve discountNelsonSiegel(double dC0, double dC1, double dC2,
+                                    double dLambda, double dInitialTime);
+
+    /**
+     * Builds the curve of yieldSvensson().
+     *
+     * @param dC0 The first constant.
+     * @param dC1 The second constant.
+     * @param dC2 The third constant.
+     * @param dC3 The fourth constant.
+     * @param dLambda1 The first mean-reversion rate.
+     * @param dLambda2 The second mean-reversion rate.
+     * @param dInitialTime The initial time.
+     * @return The yield curve.
+     */
+    ArenaCurve yieldSvensson(double dC0, double dC1, double dC2, double dC3,
+                             double dLambda1, double dLambda2, double dInitialTime);
+
+    /**
+     * Builds the curve of discountVasicek().
+     *
+     * @param dTheta The drift.
+     * @param dLambda The mean-reversion rate.
+     * @param dSigma The volatility.
+     * @param dR0 The initial short-term interest rate.
+     * @param dInitialTime The initial time.
+     * @return The discount curve.
+     */
+    ArenaCurve discountVasicek(double dTheta, double dLambda, double dSigma,
+                               double dR0, double dInitialTime);
+
+    /**
+     * Returns the number of bytes taken by the curves.
+     *
+     * @return The bytes of states of the curves.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * Releases all curves at once.
+     */
+    void release();
+
+  private:
+    double *allocate(std::size_t iDoubles);
+
+    std::pmr::monotonic_buffer_resource m_uResource;
+    std::size_t m_iBytes;
+  };
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_scenario_hpp__
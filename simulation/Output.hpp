@@ -0,0 +1,11 @@
+#ifndef __simulation_Output_hpp__
+#define __simulation_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "simulation"
+} // namespace test
+
+#endif // of __simulation_Output_hpp
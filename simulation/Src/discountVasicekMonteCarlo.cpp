@@ -0,0 +1,16 @@
+#include "engine.hpp"
+
+std::pair<std::vector<double>, std::vector<double>>
+vega::discountVasicekMonteCarlo(double dTheta, double dLambda, double dSigma,
+                                double dR0, double dInitialTime,
+                                const std::vector<double> &rTimes,
+                                const MonteCarlo &rMC)
+{
+  auto uMoments = simulationEngine::moments(
+      pathsVasicek(dTheta, dLambda, dSigma, dR0, dInitialTime, rTimes),
+      rMC, rTimes.size(),
+      [](const PathBlock &rBlock, unsigned k, unsigned p)
+      { return std::exp(-rBlock.integral[k * rBlock.size + p]); });
+
+  return {uMoments.first, simulationEngine::errors(uMoments.second, rMC.paths)};
+}
@@ -0,0 +1,152 @@
+#include "engine.hpp"
+#include <thread>
+#include <gsl/gsl_qrng.h>
+
+using namespace simulationEngine;
+
+double simulationEngine::invNormal(double dU)
+{
+  PRECONDITION(dU > 0 && dU < 1);
+
+  const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                      -2.759285104469687e+02, 1.383577518672690e+02,
+                      -3.066479806614716e+01, 2.506628277459239e+00};
+  const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                      -1.556989798598866e+02, 6.680131188771972e+01,
+                      -1.328068155288572e+01};
+  const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                      -2.400758277161838e+00, -2.549732539343734e+00,
+                      4.374664141464968e+00, 2.938163982698783e+00};
+  const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                      2.445134137142996e+00, 3.754408661907416e+00};
+  const double c_dLow = 0.02425;
+
+  if (dU < c_dLow || dU > 1. - c_dLow)
+  {
+    // tails
+    double dQ = std::sqrt(-2. * std::log(std::min(dU, 1. - dU)));
+    double dX = (((((c[0] * dQ + c[1]) * dQ + c[2]) * dQ + c[3]) * dQ + c[4]) * dQ + c[5]) /
+                ((((d[0] * dQ + d[1]) * dQ + d[2]) * dQ + d[3]) * dQ + 1.);
+    return (dU < c_dLow) ? dX : -dX;
+  }
+  double dQ = dU - 0.5;
+  double dR = dQ * dQ;
+  return (((((a[0] * dR + a[1]) * dR + a[2]) * dR + a[3]) * dR + a[4]) * dR + a[5]) * dQ /
+         (((((b[0] * dR + b[1]) * dR + b[2]) * dR + b[3]) * dR + b[4]) * dR + 1.);
+}
+
+std::vector<double> simulationEngine::errors(const std::vector<double> &rVar, unsigned long iPaths)
+{
+  std::vector<double> uError(rVar.size());
+  std::transform(rVar.begin(), rVar.end(), uError.begin(), [iPaths](double dVar)
+                 { return std::sqrt(dVar / iPaths); });
+  return uError;
+}
+
+namespace simulationEngine
+{
+  // pseudo-random normals for the paths [iFirst, iFirst + iSize)
+  void philoxNormals(unsigned long iFirst, unsigned iSize, unsigned iDim,
+                     unsigned long iSeed, std::vector<double> &rNormals)
+  {
+    uint32_t iKey0 = uint32_t(iSeed);
+    uint32_t iKey1 = uint32_t(iSeed >> 32);
+    for (unsigned j = 0; 2 * j < iDim; j++)
+    {
+      double *pU0 = rNormals.data() + 2 * j * iSize;
+      double *pU1 = (2 * j + 1 < iDim) ? pU0 + iSize : nullptr;
+      for (unsigned p = 0; p < iSize; p++)
+      {
+        unsigned long iPath = iFirst + p;
+        uint32_t uC[4] = {uint32_t(iPath), uint32_t(iPath >> 32), j, 0};
+        philox(uC, iKey0, iKey1);
+        pU0[p] = uniform(uC[0], uC[1]);
+        if (pU1)
+        {
+          pU1[p] = uniform(uC[2], uC[3]);
+        }
+      }
+    }
+    for (double &dX : rNormals)
+    {
+      dX = invNormal(dX);
+    }
+  }
+
+  // quasi-random normals; the generator is positioned at the first path
+  void sobolNormals(gsl_qrng *pSobol, unsigned iSize, unsigned iDim,
+                    std::vector<double> &rNormals)
+  {
+    std::vector<double> uPoint(iDim);
+    for (unsigned p = 0; p < iSize; p++)
+    {
+      gsl_qrng_get(pSobol, uPoint.data());
+      for (unsigned d = 0; d < iDim; d++)
+      {
+        rNormals[d * iSize + p] = invNormal(uPoint[d]);
+      }
+    }
+  }
+} // namespace simulationEngine
+
+void simulationEngine::run(const vega::MonteCarlo &rMC, unsigned iDim,
+                           const std::function<void(unsigned long, unsigned, const std::vector<double> &)> &rKernel)
+{
+  PRECONDITION(rMC.block > 0);
+  PRECONDITION(iDim > 0);
+  PRECONDITION(!rMC.sobol || iDim <= 40);
+
+  unsigned long iBlocks = (rMC.paths + rMC.block - 1) / rMC.block;
+  unsigned long iGroups = (iBlocks + c_iGroup - 1) / c_iGroup;
+  unsigned iThreads = (rMC.threads > 0) ? rMC.threads : std::thread::hardware_concurrency();
+  iThreads = std::max(1ul, std::min<unsigned long>(std::max(iThreads, 1u), iGroups));
+
+  // every thread runs a contiguous range of groups of blocks
+  auto uWork = [&rMC, iDim, iBlocks, iGroups, iThreads, &rKernel](unsigned iThread)
+  {
+    unsigned long iB0 = std::min(iBlocks, iGroups * iThread / iThreads * c_iGroup);
+    unsigned long iB1 = std::min(iBlocks, iGroups * (iThread + 1) / iThreads * c_iGroup);
+    std::vector<double> uNormals;
+    gsl_qrng *pSobol = nullptr;
+    if (rMC.sobol)
+    {
+      // the first point of the sequence (zero) is not used
+      pSobol = gsl_qrng_alloc(gsl_qrng_sobol, iDim);
+      std::vector<double> uPoint(iDim);
+      for (unsigned long i = 0; i <= iB0 * rMC.block; i++)
+      {
+        gsl_qrng_get(pSobol, uPoint.data());
+      }
+    }
+    for (unsigned long b = iB0; b < iB1; b++)
+    {
+      unsigned long iFirst = b * rMC.block;
+      unsigned iSize = std::min<unsigned long>(rMC.block, rMC.paths - iFirst);
+      uNormals.resize(iDim * iSize);
+      if (pSobol)
+      {
+        sobolNormals(pSobol, iSize, iDim, uNormals);
+      }
+      else
+      {
+        philoxNormals(iFirst, iSize, iDim, rMC.seed, uNormals);
+      }
+      rKernel(iFirst, iSize, uNormals);
+    }
+    if (pSobol)
+    {
+      gsl_qrng_free(pSobol);
+    }
+  };
+
+  std::vector<std::thread> uThreads;
+  for (unsigned t = 1; t < iThreads; t++)
+  {
+    uThreads.emplace_back(uWork, t);
+  }
+  uWork(0);
+  for (std::thread &rThread : uThreads)
+  {
+    rThread.join();
+  }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "simulation/simulation.hpp"
+#include "prep1/prep1.hpp"
+#include "vega/shapes.hpp"
+#include <cstdint>
+
+namespace simulationEngine
+{
+  /**
+   * Philox4x32-10 counter-based generator of Salmon et al.
+   * It transforms the counter \p pC in place. The function is inline,
+   * so the loops over paths can be vectorized.
+   */
+  inline void philox(uint32_t pC[4], uint32_t iKey0, uint32_t iKey1)
+  {
+    const uint32_t c_iM0 = 0xD2511F53;
+    const uint32_t c_iM1 = 0xCD9E8D57;
+    for (unsigned r = 0; r < 10; r++)
+    {
+      uint64_t iP0 = uint64_t(c_iM0) * pC[0];
+      uint64_t iP1 = uint64_t(c_iM1) * pC[2];
+      uint32_t iC0 = uint32_t(iP1 >> 32) ^ pC[1] ^ iKey0;
+      uint32_t iC2 = uint32_t(iP0 >> 32) ^ pC[3] ^ iKey1;
+      pC[0] = iC0;
+      pC[1] = uint32_t(iP1);
+      pC[2] = iC2;
+      pC[3] = uint32_t(iP0);
+      iKey0 += 0x9E3779B9;
+      iKey1 += 0xBB67AE85;
+    }
+  }
+
+  /**
+   * Uniform random number on \f$(0,1)\f$ from two 32-bit words.
+   */
+  inline double uniform(uint32_t iHi, uint32_t iLo)
+  {
+    uint64_t iX = (uint64_t(iHi) << 21) | (iLo >> 11);
+    return (iX + 0.5) * (1. / 9007199254740992.);
+  }
+
+  /**
+   * Inverse of the standard normal distribution function (Acklam),
+   * relative error below 1.2e-9.
+   */
+  double invNormal(double dU);
+
+  /**
+   * The number of consecutive blocks in a group. The blocks of a group
+   * are run in order by one thread.
+   */
+  const unsigned c_iGroup = 16;
+
+  /**
+   * Runs the blocks of Monte Carlo on several threads. For every block
+   * the kernel receives the global index of its first path, the number
+   * of paths and the standard normal random numbers for \p iDim
+   * factors: factor \p d of path \p p is at position
+   * <code>d * size + p</code>. The threads run contiguous ranges of
+   * groups of c_iGroup blocks.
+   */
+  void run(const vega::MonteCarlo &rMC, unsigned iDim,
+           const std::function<void(unsigned long, unsigned, const std::vector<double> &)> &rKernel);
+
+  /**
+   * Computes the sample means and variances of \p fValue at every
+   * simulation time. \p fValue(block, k, p) is the value for time
+   * \p k and path \p p of the block. The sums of a group of blocks
+   * are accumulated in the order of blocks by the thread that runs the
+   * group, and the sums of groups are added in the order of groups,
+   * so the result does not depend on the number of threads. Only the
+   * sums of groups are stored: for \f$10^6\f$ paths in blocks of 256
+   * and 500 times, 245 groups take 2 MB.
+   */
+  template <class F>
+  std::pair<std::vector<double>, std::vector<double>>
+  moments(const std::function<void(const vega::MonteCarlo &, const std::function<void(const vega::PathBlock &)> &)> &rPaths,
+          const vega::MonteCarlo &rMC, unsigned iSteps, F fValue)
+  {
+    PRECONDITION(rMC.paths > 1);
+
+    unsigned long iBlocks = (rMC.paths + rMC.block - 1) / rMC.block;
+    unsigned long iGroups = (iBlocks + c_iGroup - 1) / c_iGroup;
+    std::vector<double> uSum(iGroups * iSteps, 0.);
+    std::vector<double> uSum2(iGroups * iSteps, 0.);
+    unsigned long iGroup = (unsigned long)rMC.block * c_iGroup;
+    rPaths(rMC, [&uSum, &uSum2, iSteps, iGroup, &fValue](const vega::PathBlock &rBlock)
+           {
+             double *pSum = uSum.data() + (rBlock.first / iGroup) * iSteps;
+             double *pSum2 = uSum2.data() + (rBlock.first / iGroup) * iSteps;
+             for (unsigned k = 0; k < iSteps; k++)
+             {
+               double dS = 0.;
+               double dS2 = 0.;
+               for (unsigned p = 0; p < rBlock.size; p++)
+               {
+                 double dX = fValue(rBlock, k, p);
+                 dS += dX;
+                 dS2 += dX * dX;
+               }
+               pSum[k] += dS;
+               pSum2[k] += dS2;
+             } });
+
+    std::vector<double> uMean(iSteps, 0.);
+    std::vector<double> uVar(iSteps, 0.);
+    for (unsigned long g = 0; g < iGroups; g++)
+    {
+      for (unsigned k = 0; k < iSteps; k++)
+      {
+        uMean[k] += uSum[g * iSteps + k];
+        uVar[k] += uSum2[g * iSteps + k];
+      }
+    }
+    double dN = rMC.paths;
+    for (unsigned k = 0; k < iSteps; k++)
+    {
+      uMean[k] /= dN;
+      uVar[k] = std::max(uVar[k] / dN - uMean[k] * uMean[k], 0.) * dN / (dN - 1.);
+    }
+    return {uMean, uVar};
+  }
+
+  /**
+   * Returns the standard errors of the means from the sample variances.
+   */
+  std::vector<double> errors(const std::vector<double> &rVar, unsigned long iPaths);
+} // namespace simulationEngine
@@ -0,0 +1,16 @@
+#include "engine.hpp"
+
+std::pair<std::vector<double>, std::vector<double>>
+vega::forwardBlackMonteCarlo(double dSpot, double dTheta, double dLambda,
+                             double dSigma, double dInitialTime,
+                             const std::vector<double> &rTimes,
+                             const MonteCarlo &rMC)
+{
+  auto uMoments = simulationEngine::moments(
+      pathsBlack(dSpot, dTheta, dLambda, dSigma, dInitialTime, rTimes),
+      rMC, rTimes.size(),
+      [](const PathBlock &rBlock, unsigned k, unsigned p)
+      { return std::exp(rBlock.state[k * rBlock.size + p]); });
+
+  return {uMoments.first, simulationEngine::errors(uMoments.second, rMC.paths)};
+}
@@ -0,0 +1,57 @@
+#include "engine.hpp"
+
+std::function<void(const vega::MonteCarlo &, const std::function<void(const vega::PathBlock &)> &)>
+vega::pathsBlack(double dSpot, double dTheta, double dLambda, double dSigma,
+                 double dInitialTime, const std::vector<double> &rTimes)
+{
+  PRECONDITION(dSpot > 0);
+  PRECONDITION(dLambda >= 0);
+  PRECONDITION(dSigma >= 0);
+  PRECONDITION(!rTimes.empty() && rTimes.front() > dInitialTime);
+  PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+
+  // X(t+h) = e^{-lambda h} X(t) + mean + std * Z
+  unsigned iSteps = rTimes.size();
+  std::vector<double> uDecay(iSteps), uMean(iSteps), uStd(iSteps);
+  double dT = dInitialTime;
+  for (unsigned k = 0; k < iSteps; k++)
+  {
+    double dH = rTimes[k] - dT;
+    double dX = dLambda * dH;
+    ShapeValues uShapes = Shapes::values(dX);
+    uDecay[k] = std::exp(-dX);
+    uMean[k] = dTheta * dH * uShapes.shape1;
+    uStd[k] = dSigma * std::sqrt(dH * uShapes.shape1Of2x);
+    dT = rTimes[k];
+  }
+  double dLogSpot = std::log(dSpot);
+
+  return [uDecay, uMean, uStd, dLogSpot](const MonteCarlo &rMC, const std::function<void(const PathBlock &)> &rConsumer)
+  {
+    unsigned iSteps = uDecay.size();
+    simulationEngine::run(rMC, iSteps,
+                          [&uDecay, &uMean, &uStd, dLogSpot, iSteps, &rConsumer](unsigned long iFirst, unsigned iSize,
+                                                                                 const std::vector<double> &rNormals)
+                          {
+                            PathBlock uBlock;
+                            uBlock.first = iFirst;
+                            uBlock.size = iSize;
+                            uBlock.state.resize(iSteps * iSize);
+                            std::vector<double> uX(iSize, 0.);
+                            for (unsigned k = 0; k < iSteps; k++)
+                            {
+                              double dDecay = uDecay[k];
+                              double dMean = uMean[k];
+                              double dStd = uStd[k];
+                              const double *pZ = rNormals.data() + k * iSize;
+                              double *pS = uBlock.state.data() + k * iSize;
+                              for (unsigned p = 0; p < iSize; p++)
+                              {
+                                uX[p] = dDecay * uX[p] + dMean + dStd * pZ[p];
+                                pS[p] = dLogSpot + uX[p];
+                              }
+                            }
+                            rConsumer(uBlock);
+                          });
+  };
+}
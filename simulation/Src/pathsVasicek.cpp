@@ -0,0 +1,107 @@
+#include "engine.hpp"
+
+namespace simulationVasicek
+{
+  // lambda (h - 2(1-e^{-x})/lambda + (1-e^{-2x})/(2 lambda)) for x = lambda h;
+  // the variance of the integral of r over the step is sigma^2/lambda^3
+  // times this factor
+  double varianceFactor(double dX)
+  {
+    if (dX < 1E-3)
+    {
+      return dX * dX * dX * (1. / 3. - dX * (0.25 - dX * 7. / 60.));
+    }
+    double dE = -std::expm1(-dX);
+    return dX - 2. * dE + 0.5 * dE * (2. - dE);
+  }
+
+  // the coefficients of the exact Gaussian transition over one step
+  class Step
+  {
+  public:
+    double decay;         // e^{-lambda h}
+    double rateMean;      // theta/lambda (1 - e^{-lambda h})
+    double rateStd;       // standard deviation of r
+    double integralRate;  // (1 - e^{-lambda h})/lambda
+    double integralMean;  // theta/lambda (h - (1 - e^{-lambda h})/lambda)
+    double integralStd1;  // loading of the integral on the first factor
+    double integralStd2;  // loading of the integral on the second factor
+  };
+
+  Step step(double dTheta, double dLambda, double dSigma, double dH)
+  {
+    PRECONDITION(dH > 0);
+
+    double dX = dLambda * dH;
+    double dOneMinusE = -std::expm1(-dX);
+    Step uStep;
+    uStep.decay = 1. - dOneMinusE;
+    uStep.rateMean = dTheta / dLambda * dOneMinusE;
+    uStep.rateStd = dSigma * std::sqrt(dH * vega::Shapes::shape1Of2x(dX));
+    uStep.integralRate = dOneMinusE / dLambda;
+    uStep.integralMean = dTheta / dLambda * (dH - uStep.integralRate);
+    double dIntegralStd = dSigma * std::sqrt(varianceFactor(dX) / dLambda) / dLambda;
+    double dCov = 0.5 * dSigma * dSigma * dOneMinusE * dOneMinusE / (dLambda * dLambda);
+    double dRho = (dIntegralStd > 0 && uStep.rateStd > 0) ? dCov / (dIntegralStd * uStep.rateStd) : 0.;
+    dRho = std::min(1., std::max(-1., dRho));
+    uStep.integralStd1 = dIntegralStd * dRho;
+    uStep.integralStd2 = dIntegralStd * std::sqrt(1. - dRho * dRho);
+    return uStep;
+  }
+} // namespace simulationVasicek
+
+using namespace simulationVasicek;
+
+std::function<void(const vega::MonteCarlo &, const std::function<void(const vega::PathBlock &)> &)>
+vega::pathsVasicek(double dTheta, double dLambda, double dSigma,
+                   double dR0, double dInitialTime,
+                   const std::vector<double> &rTimes)
+{
+  PRECONDITION(dLambda > 0);
+  PRECONDITION(dSigma > 0);
+  PRECONDITION(!rTimes.empty() && rTimes.front() > dInitialTime);
+  PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+
+  std::vector<Step> uSteps(rTimes.size());
+  double dT = dInitialTime;
+  for (unsigned k = 0; k < rTimes.size(); k++)
+  {
+    uSteps[k] = step(dTheta, dLambda, dSigma, rTimes[k] - dT);
+    dT = rTimes[k];
+  }
+
+  return [uSteps, dR0](const MonteCarlo &rMC, const std::function<void(const PathBlock &)> &rConsumer)
+  {
+    unsigned iSteps = uSteps.size();
+    simulationEngine::run(rMC, 2 * iSteps,
+                          [&uSteps, dR0, iSteps, &rConsumer](unsigned long iFirst, unsigned iSize,
+                                                             const std::vector<double> &rNormals)
+                          {
+                            PathBlock uBlock;
+                            uBlock.first = iFirst;
+                            uBlock.size = iSize;
+                            uBlock.state.resize(iSteps * iSize);
+                            uBlock.integral.resize(iSteps * iSize);
+                            std::vector<double> uR(iSize, dR0);
+                            std::vector<double> uI(iSize, 0.);
+                            for (unsigned k = 0; k < iSteps; k++)
+                            {
+                              const Step &rS = uSteps[k];
+                              const double *pZ1 = rNormals.data() + 2 * k * iSize;
+                              const double *pZ2 = pZ1 + iSize;
+                              double *pR = uBlock.state.data() + k * iSize;
+                              double *pI = uBlock.integral.data() + k * iSize;
+                              for (unsigned p = 0; p < iSize; p++)
+                              {
+                                double dR = uR[p];
+                                uI[p] += dR * rS.integralRate + rS.integralMean +
+                                         rS.integralStd1 * pZ1[p] + rS.integralStd2 * pZ2[p];
+                                uR[p] = dR * rS.decay + rS.rateMean + rS.rateStd * pZ1[p];
+                                pR[p] = uR[p];
+                                pI[p] = uI[p];
+                              }
+                            }
+                            rConsumer(uBlock);
+                          });
+  };
+}
@@ -0,0 +1,121 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "simulation/Output.hpp"
+#include "simulation/simulation.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+
+using namespace test;
+using namespace std;
+
+void discountVasicekMonteCarlo(bool bSobol)
+{
+  if (bSobol)
+  {
+    test::print("DISCOUNT CURVE IN VASICEK MODEL BY QUASI MONTE CARLO");
+  }
+  else
+  {
+    test::print("DISCOUNT CURVE IN VASICEK MODEL BY MONTE CARLO");
+  }
+
+  double dLambda = 0.05;
+  double dTheta = 0.02;
+  double dR0 = 0.04;
+  double dSigma = 0.01;
+  double dInitialTime = 1.5;
+  double dMaturity = dInitialTime + 5.;
+  unsigned iTimes = 20;
+
+  vega::MonteCarlo uMC;
+  uMC.paths = (bSobol) ? 1 << 16 : 100000;
+  uMC.sobol = bSobol;
+
+  print(dTheta, "theta");
+  print(dLambda, "lambda");
+  print(dSigma, "sigma");
+  print(dR0, "r_0");
+  print(dInitialTime, "initial time");
+  print(uMC.paths, "number of paths", true);
+
+  std::vector<double> uTimes = getTimes(dInitialTime, dMaturity, iTimes);
+  auto uMonteCarlo = vega::discountVasicekMonteCarlo(dTheta, dLambda, dSigma, dR0,
+                                                     dInitialTime, uTimes, uMC);
+  std::function<double(double)> uDiscount =
+      vega::discountVasicek(dTheta, dLambda, dSigma, dR0, dInitialTime);
+
+  std::vector<double> uExact(iTimes);
+  std::transform(uTimes.begin(), uTimes.end(), uExact.begin(), uDiscount);
+  std::vector<double> uError(iTimes);
+  std::transform(uExact.begin(), uExact.end(), uMonteCarlo.first.begin(), uError.begin(),
+                 [](double dX, double dY)
+                 { return std::abs(dX - dY); });
+
+  printTable({uTimes, uExact, uMonteCarlo.first, uError, uMonteCarlo.second},
+             {"time", "exact", "estimate", "error", "std error"},
+             "discount factors: closed form versus Monte Carlo", 10, 4, iTimes);
+}
+
+void blackMonteCarlo()
+{
+  test::print("FORWARD PRICES AND VOLATILITIES IN BLACK MODEL BY MONTE CARLO");
+
+  double dSpot = 100;
+  double dTheta = 0.03;
+  double dLambda = 0.05;
+  double dSigma = 0.2;
+  double dInitialTime = 0.75;
+  double dMaturity = dInitialTime + 2.;
+  unsigned iTimes = 200;
+
+  vega::MonteCarlo uMC;
+
+  print(dSpot, "spot");
+  print(dTheta, "theta");
+  print(dLambda, "lambda");
+  print(dSigma, "sigma");
+  print(dInitialTime, "initial time");
+  print(iTimes, "number of times");
+  print(uMC.paths, "number of paths", true);
+
+  std::vector<double> uTimes = getTimes(dInitialTime, dMaturity, iTimes);
+  auto uForward = vega::forwardBlackMonteCarlo(dSpot, dTheta, dLambda, dSigma,
+                                               dInitialTime, uTimes, uMC);
+  std::vector<double> uVol = vega::volatilityBlackMonteCarlo(dTheta, dLambda, dSigma,
+                                                             dInitialTime, uTimes, uMC);
+
+  std::function<double(double)> uCarry = vega::carryBlack(dTheta, dLambda, dSigma, dInitialTime);
+  std::function<double(double)> uBlackVol = vega::volatilityBlack(dSigma, dLambda, dInitialTime);
+  std::vector<double> uExactForward(iTimes), uExactVol(iTimes);
+  for (unsigned k = 0; k < iTimes; k++)
+  {
+    uExactForward[k] = dSpot * std::exp(uCarry(uTimes[k]) * (uTimes[k] - dInitialTime));
+    uExactVol[k] = uBlackVol(uTimes[k]);
+  }
+
+  printTable({uTimes, uExactForward, uForward.first, uForward.second},
+             {"time", "exact", "estimate", "std error"},
+             "forward prices: carryBlack versus Monte Carlo", 10, 4, 10);
+  printTable({uTimes, uExactVol, uVol},
+             {"time", "exact", "estimate"},
+             "implied volatilities: volatilityBlack versus Monte Carlo", 10, 4, 10);
+}
+
+std::function<void()> test_simulation()
+{
+  return []()
+  {
+    print("MONTE CARLO SIMULATION OF FINANCIAL MODELS");
+
+    discountVasicekMonteCarlo(false);
+    discountVasicekMonteCarlo(true);
+    blackMonteCarlo();
+  };
+}
+
+int main()
+{
+  project(test_simulation(), PROJECT_NAME, PROJECT_NAME,
+          "Monte Carlo simulation");
+}
@@ -0,0 +1,22 @@
+#include "engine.hpp"
+
+std::vector<double>
+vega::volatilityBlackMonteCarlo(double dTheta, double dLambda, double dSigma,
+                                double dInitialTime,
+                                const std::vector<double> &rTimes,
+                                const MonteCarlo &rMC)
+{
+  // the spot price does not change the variance of its log
+  auto uMoments = simulationEngine::moments(
+      pathsBlack(1., dTheta, dLambda, dSigma, dInitialTime, rTimes),
+      rMC, rTimes.size(),
+      [](const PathBlock &rBlock, unsigned k, unsigned p)
+      { return rBlock.state[k * rBlock.size + p]; });
+
+  std::vector<double> uVol(rTimes.size());
+  for (unsigned k = 0; k < rTimes.size(); k++)
+  {
+    uVol[k] = std::sqrt(uMoments.second[k] / (rTimes[k] - dInitialTime));
+  }
+  return uVol;
+}
@@ -0,0 +1,244 @@
+#ifndef __vega_simulation_hpp__
+#define __vega_simulation_hpp__
+
+/**
+ * @file simulation.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Monte Carlo simulation of financial models
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaSimulation Monte Carlo simulation of financial models.
+   *
+   * This module simulates the paths of the models behind the
+   * analytical data curves. The paths are generated in blocks on
+   * several threads. Every block stores its paths in the
+   * structure-of-arrays layout: for every time all paths of the block
+   * are contiguous.
+   *
+   * @{
+   */
+
+  /**
+   * @brief Parameters of Monte Carlo simulation.
+   *
+   * The random numbers are given by the counter-based generator
+   * Philox4x32-10, where the counter is the global index of the path
+   * and the key is the seed. Hence the simulated paths do not depend
+   * on the number of threads or the size of the blocks. The sample
+   * moments are summed per block and per group of blocks, so they do
+   * not depend on the number of threads, but their rounding depends
+   * on the size of the blocks.
+   */
+  class MonteCarlo
+  {
+  public:
+    /**
+     * The total number of paths.
+     */
+    unsigned long paths = 100000;
+
+    /**
+     * The number of paths in a block.
+     */
+    unsigned block = 256;
+
+    /**
+     * The seed of the random number generator.
+     */
+    unsigned long seed = 1;
+
+    /**
+     * If \p true, then the Sobol sequence of GSL is used instead of
+     * pseudo-random numbers. The number of random factors (usually,
+     * twice the number of times) can not exceed 40.
+     */
+    bool sobol = false;
+
+    /**
+     * The number of threads. If \p 0, then all hardware threads are used.
+     */
+    unsigned threads = 0;
+  };
+
+  /**
+   * @brief Block of simulated paths.
+   *
+   * The values for time with index \p k and path with index \p p are
+   * stored at position <code>k * size + p</code>.
+   */
+  class PathBlock
+  {
+  public:
+    /**
+     * The global index of the first path in the block.
+     */
+    unsigned long first;
+
+    /**
+     * The number of paths in the block.
+     */
+    unsigned size;
+
+    /**
+     * The state process (short-term rate, log of spot price, ...)
+     * at the simulation times.
+     */
+    std::vector<double> state;
+
+    /**
+     * The integral of the state process from the initial time. It is
+     * empty if the model does not need it.
+     */
+    std::vector<double> integral;
+  };
+
+  /**
+   * Simulates the short-term interest rate \f$r=(r_t)\f$ in the
+   * Vasicek model:
+   * \f[
+   *   dr_t=  (\theta - \lambda r_t) dt + \sigma dB_t,
+   *  \quad t\geq t_0,
+   * \f]
+   * together with its integral \f$\int_{t_0}^t r_s ds\f$. The pair
+   * \f$(r_t, \int r_s ds)\f$ is Gaussian, so the transition between
+   * two simulation times is exact for any time step.
+   *
+   * @param dTheta \f$\theta\f$ The drift.
+   * @param dLambda \f$\lambda> 0\f$ The mean-reversion rate.
+   * @param dSigma \f$\sigma> 0\f$ The volatility.
+   * @param dR0 \f$r(t_0)\f$ The initial short-term interest rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   * @param rTimes The simulation times, \f$t_0<t_1<\dots<t_M\f$.
+   *
+   * @return The function that simulates the paths with given
+   * parameters of Monte Carlo and passes every block of paths to the
+   * consumer. The consumer is called concurrently from several
+   * threads.
+   */
+  std::function<void(const MonteCarlo &, const std::function<void(const PathBlock &)> &)>
+  pathsVasicek(double dTheta, double dLambda, double dSigma,
+               double dR0, double dInitialTime,
+               const std::vector<double> &rTimes);
+
+  /**
+   * Computes Monte Carlo estimates of the discount factors
+   * \f[
+   * D(t_i) = \mathbb{E}(e^{-\int_{t_0}^{t_i} r_s ds})
+   * \f]
+   * in the Vasicek model. The estimates converge to the closed form
+   * of discountVasicek().
+   *
+   * @param dTheta \f$\theta\f$ The drift.
+   * @param dLambda \f$\lambda> 0\f$ The mean-reversion rate.
+   * @param dSigma \f$\sigma> 0\f$ The volatility.
+   * @param dR0 \f$r(t_0)\f$ The initial short-term interest rate.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   * @param rTimes The maturities, \f$t_0<t_1<\dots<t_M\f$.
+   * @param rMC The parameters of Monte Carlo.
+   *
+   * @return The pair of vectors of estimates of discount factors and
+   * their standard errors.
+   */
+  std::pair<std::vector<double>, std::vector<double>>
+  discountVasicekMonteCarlo(double dTheta, double dLambda, double dSigma,
+                            double dR0, double dInitialTime,
+                            const std::vector<double> &rTimes,
+                            const MonteCarlo &rMC);
+
+  /**
+   * Simulates the log of spot price in the Black model:
+   * \f[
+   * \log S_t = \log S(t_0) + X_t, \quad t\geq t_0,
+   * \f]
+   * where \f$X=(X_t)\f$ is an OU (Ornstein-Uhlenbeck) process
+   * driven by Brownian motion \f$B=(B_t)\f$:
+   * \f[
+   *    dX_t =  (\theta - \lambda X_t) dt + \sigma dB_t,
+   *    \quad X(t_0) = 0.
+   * \f]
+   * The transition between two simulation times is exact. The model
+   * is the one behind carryBlack() and volatilityBlack(). The paths are
+   * kept only block by block, so the memory does not grow with the
+   * number of paths.
+   *
+   * @param dSpot \f$S(t_0)\f$ The spot price.
+   * @param dTheta \f$\theta\f$ The drift term.
+   * @param dLambda \f$\lambda\geq 0\f$ The mean reversion rate.
+   * @param dSigma  \f$\sigma\geq 0\f$ The volatility.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   * @param rTimes The simulation times, \f$t_0<t_1<\dots<t_M\f$.
+   *
+   * @return The function that simulates the paths of \f$\log S_t\f$
+   * with given parameters of Monte Carlo and passes every block of
+   * paths to the consumer. The consumer is called concurrently from
+   * several threads.
+   */
+  std::function<void(const MonteCarlo &, const std::function<void(const PathBlock &)> &)>
+  pathsBlack(double dSpot, double dTheta, double dLambda, double dSigma,
+             double dInitialTime, const std::vector<double> &rTimes);
+
+  /**
+   * Computes Monte Carlo estimates of the forward prices
+   * \f$F(t_i) = \mathbb{E}(S(t_i))\f$ in the Black model. The
+   * estimates converge to
+   * \f[
+   * F(t) = S(t_0) \exp(c(t)(t-t_0)),
+   * \f]
+   * where \f$c\f$ is the cost-of-carry rate from carryBlack().
+   *
+   * @param dSpot \f$S(t_0)\f$ The spot price.
+   * @param dTheta \f$\theta\f$ The drift term.
+   * @param dLambda \f$\lambda\geq 0\f$ The mean reversion rate.
+   * @param dSigma  \f$\sigma\geq 0\f$ The volatility.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   * @param rTimes The maturities, \f$t_0<t_1<\dots<t_M\f$.
+   * @param rMC The parameters of Monte Carlo.
+   *
+   * @return The pair of vectors of estimates of forward prices and
+   * their standard errors.
+   */
+  std::pair<std::vector<double>, std::vector<double>>
+  forwardBlackMonteCarlo(double dSpot, double dTheta, double dLambda,
+                         double dSigma, double dInitialTime,
+                         const std::vector<double> &rTimes,
+                         const MonteCarlo &rMC);
+
+  /**
+   * Computes Monte Carlo estimates of the implied volatilities
+   * \f[
+   * \Sigma(t_i) = \sqrt{\frac{\mathrm{Var}(\log S(t_i))}{t_i-t_0}}
+   * \f]
+   * in the Black model. As \f$\log S(t)\f$ is Gaussian, these are the
+   * implied volatilities of all European options with maturity
+   * \f$t\f$. The estimates converge to volatilityBlack().
+   *
+   * @param dTheta \f$\theta\f$ The drift term.
+   * @param dLambda \f$\lambda\geq 0\f$ The mean reversion rate.
+   * @param dSigma  \f$\sigma\geq 0\f$ The volatility.
+   * @param dInitialTime \f$t_0\f$ The initial time.
+   * @param rTimes The maturities, \f$t_0<t_1<\dots<t_M\f$.
+   * @param rMC The parameters of Monte Carlo.
+   *
+   * @return The vector of estimates of implied volatilities.
+   */
+  std::vector<double>
+  volatilityBlackMonteCarlo(double dTheta, double dLambda, double dSigma,
+                            double dInitialTime,
+                            const std::vector<double> &rTimes,
+                            const MonteCarlo &rMC);
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_simulation_hpp__
@@ -0,0 +1,11 @@
+#ifndef __snapshot_Output_hpp__
+#define __snapshot_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "snapshot"
+} // namespace test
+
+#endif // of __snapshot_Output_hpp
@@ -0,0 +1,120 @@
+#include "snapshot/snapshot.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+#include <stdexcept>
+
+namespace curveRecipe
+{
+  // checks the numbers of arguments of the builder; the two tables of
+  // a builder are the knots and the values at them
+  void check(const vega::CurveRecipe &rRecipe, std::size_t iParameters, std::size_t iTables,
+             std::size_t iCurves)
+  {
+    std::string sBuilder = std::to_string(rRecipe.builder);
+    if (rRecipe.parameters.size() != iParameters || rRecipe.tables.size() != iTables ||
+        rRecipe.curves.size() != iCurves)
+    {
+      throw std::runtime_error("the recipe of builder " + sBuilder + " has " +
+                               std::to_string(rRecipe.parameters.size()) + " parameters, " +
+                               std::to_string(rRecipe.tables.size()) + " tables and " +
+                               std::to_string(rRecipe.curves.size()) + " curves instead of " +
+                               std::to_string(iParameters) + ", " + std::to_string(iTables) +
+                               " and " + std::to_string(iCurves));
+    }
+    if (iTables == 2 &&
+        (rRecipe.tables[0].empty() || rRecipe.tables[0].size() != rRecipe.tables[1].size()))
+    {
+      throw std::runtime_error("the tables of the recipe of builder " + sBuilder +
+                               " are empty or have different sizes");
+    }
+  }
+} // namespace curveRecipe
+
+std::function<double(double)> vega::CurveRecipe::build() const
+{
+  return build(0);
+}
+
+std::function<double(double)> vega::CurveRecipe::build(unsigned iDepth) const
+{
+  if (iDepth >= maxDepth)
+  {
+    throw std::runtime_error("the recipes of curves are nested deeper than " +
+                             std::to_string(maxDepth) + " levels");
+  }
+  const std::vector<double> &rP = parameters;
+  const std::vector<std::vector<double>> &rT = tables;
+  const std::vector<CurveRecipe> &rC = curves;
+
+  switch (builder)
+  {
+  case discountNelsonSiegel:
+    curveRecipe::check(*this, 5, 0, 0);
+    return vega::discountNelsonSiegel(rP[0], rP[1], rP[2], rP[3], rP[4]);
+  case discountYieldLinInterp:
+    curveRecipe::check(*this, 2, 2, 0);
+    return vega::discountYieldLinInterp(rT[0], rT[1], rP[0], rP[1]);
+  case forwardCashFlow:
+    curveRecipe::check(*this, 0, 2, 1);
+    return vega::forwardCashFlow(rT[0], rT[1], rC[0].build(iDepth + 1));
+  case forwardCouponBond:
+    curveRecipe::check(*this, 4, 0, 1);
+    return vega::forwardCouponBond(rP[0], rP[1], rP[2], rC[0].build(iDepth + 1), rP[3] != 0.);
+  case yield:
+    curveRecipe::check(*this, 1, 0, 1);
+    return vega::yield(rC[0].build(iDepth + 1), rP[0]);
+  case yieldNelsonSiegel:
+    curveRecipe::check(*this, 5, 0, 0);
+    return vega::yieldNelsonSiegel(rP[0], rP[1], rP[2], rP[3], rP[4]);
+  case yieldShape1:
+    curveRecipe::check(*this, 2, 0, 0);
+    return vega::yieldShape1(rP[0], rP[1]);
+  case yieldShape2:
+    curveRecipe::check(*this, 2, 0, 0);
+    return vega::yieldShape2(rP[0], rP[1]);
+  case carryBlack:
+    curveRecipe::check(*this, 4, 0, 0);
+    return vega::carryBlack(rP[0], rP[1], rP[2], rP[3]);
+  case discountLogLinInterp:
+    curveRecipe::check(*this, 1, 2, 0);
+    return vega::discountLogLinInterp(rT[0], rT[1], rP[0]);
+  case discountVasicek:
+    curveRecipe::check(*this, 5, 0, 0);
+    return vega::discountVasicek(rP[0], rP[1], rP[2], rP[3], rP[4]);
+  case forwardAnnuity:
+    curveRecipe::check(*this, 4, 0, 1);
+    return vega::forwardAnnuity(rP[0], rP[1], rP[2], rC[0].build(iDepth + 1), rP[3] != 0.);
+  case forwardStockDividends:
+    curveRecipe::check(*this, 1, 2, 1);
+    return vega::forwardStockDividends(rP[0], rT[0], rT[1], rC[0].build(iDepth + 1));
+  case forwardSwapRate:
+    curveRecipe::check(*this, 2, 0, 1);
+    return vega::forwardSwapRate(rP[0], unsigned(rP[1]), rC[0].build(iDepth + 1));
+  case volatilityVar:
+    curveRecipe::check(*this, 1, 0, 1);
+    return vega::volatilityVar(rC[0].build(iDepth + 1), rP[0]);
+  case volatilityVarLinInterp:
+    curveRecipe::check(*this, 1, 2, 0);
+    return vega::volatilityVarLinInterp(rT[0], rT[1], rP[0]);
+  case yieldVasicek:
+    curveRecipe::check(*this, 5, 0, 0);
+    return vega::yieldVasicek(rP[0], rP[1], rP[2], rP[3], rP[4]);
+  case forwardFX:
+    curveRecipe::check(*this, 1, 0, 2);
+    return vega::forwardFX(rP[0], rC[0].build(iDepth + 1), rC[1].build(iDepth + 1));
+  case yieldSvensson:
+    curveRecipe::check(*this, 7, 0, 0);
+    return vega::yieldSvensson(rP[0], rP[1], rP[2], rP[3], rP[4], rP[5], rP[6]);
+  case volatilityBlack:
+    curveRecipe::check(*this, 3, 0, 0);
+    return vega::volatilityBlack(rP[0], rP[1], rP[2]);
+  case forwardLibor:
+    curveRecipe::check(*this, 1, 0, 1);
+    return vega::forwardLibor(rP[0], rC[0].build(iDepth + 1));
+  case forwardCarryLinInterp:
+    curveRecipe::check(*this, 2, 2, 0);
+    return vega::forwardCarryLinInterp(rP[0], rT[0], rT[1], rP[1]);
+  }
+  throw std::runtime_error("unknown builder " + std::to_string(builder) + " of a recipe");
+}
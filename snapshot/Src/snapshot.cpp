@@ -0,0 +1,225 @@
+#include "snapshot/snapshot.hpp"
+#include "prep1/prep1.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "the snapshots are read without conversion on little-endian hosts");
+
+namespace snapshotFile
+{
+  const char c_sMagic[8] = {'V', 'E', 'G', 'A', 'S', 'N', 'P', '\0'};
+  const std::uint32_t c_iVersion = 1;
+  const std::size_t c_iHeader = 32;
+
+  // 64-bit FNV-1a hash
+  std::uint64_t checksum(const char *pData, std::size_t iSize)
+  {
+    std::uint64_t iHash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < iSize; i++)
+    {
+      iHash = (iHash ^ (unsigned char)pData[i]) * 1099511628211ull;
+    }
+    return iHash;
+  }
+
+  template <class T>
+  void put(std::string &rBytes, T uValue)
+  {
+    rBytes.append(reinterpret_cast<const char *>(&uValue), sizeof(T));
+  }
+
+  void put(std::string &rBytes, const std::vector<double> &rValues)
+  {
+    rBytes.append(reinterpret_cast<const char *>(rValues.data()), rValues.size() * sizeof(double));
+  }
+
+  void put(std::string &rBytes, const vega::CurveRecipe &rRecipe)
+  {
+    put<std::uint32_t>(rBytes, rRecipe.builder);
+    put<std::uint32_t>(rBytes, rRecipe.parameters.size());
+    put<std::uint32_t>(rBytes, rRecipe.tables.size());
+    put<std::uint32_t>(rBytes, rRecipe.curves.size());
+    put(rBytes, rRecipe.parameters);
+    for (const std::vector<double> &rTable : rRecipe.tables)
+    {
+      put<std::uint64_t>(rBytes, rTable.size());
+      put(rBytes, rTable);
+    }
+    for (const vega::CurveRecipe &rCurve : rRecipe.curves)
+    {
+      put(rBytes, rCurve);
+    }
+  }
+
+  // reads the payload and checks its bounds
+  class Reader
+  {
+  public:
+    Reader(const char *pBegin, const char *pEnd)
+        : m_pNext(pBegin), m_pEnd(pEnd)
+    {
+    }
+
+    template <class T>
+    T get()
+    {
+      T uValue;
+      std::memcpy(&uValue, take(sizeof(T)), sizeof(T));
+      return uValue;
+    }
+
+    void get(std::vector<double> &rValues, std::size_t iSize)
+    {
+      if (iSize > std::size_t(m_pEnd - m_pNext) / sizeof(double))
+      {
+        throw std::runtime_error("the snapshot is truncated");
+      }
+      rValues.resize(iSize);
+      std::memcpy(rValues.data(), take(iSize * sizeof(double)), iSize * sizeof(double));
+    }
+
+    void get(vega::CurveRecipe &rRecipe, unsigned iDepth = 0)
+    {
+      if (iDepth >= vega::CurveRecipe::maxDepth)
+      {
+        throw std::runtime_error("the recipes of the snapshot are nested deeper than " +
+                                 std::to_string(vega::CurveRecipe::maxDepth) + " levels");
+      }
+      std::uint32_t iBuilder = get<std::uint32_t>();
+      if (iBuilder < vega::CurveRecipe::discountNelsonSiegel ||
+          iBuilder > vega::CurveRecipe::forwardCarryLinInterp)
+      {
+        throw std::runtime_error("unknown builder " + std::to_string(iBuilder) + " in the snapshot");
+      }
+      rRecipe.builder = vega::CurveRecipe::Builder(iBuilder);
+      std::uint32_t iParameters = get<std::uint32_t>();
+      std::uint32_t iTables = get<std::uint32_t>();
+      std::uint32_t iCurves = get<std::uint32_t>();
+      // a table takes at least its size and a recipe its four counts
+      if (std::size_t(iTables) * 8 + std::size_t(iCurves) * 16 > std::size_t(m_pEnd - m_pNext))
+      {
+        throw std::runtime_error("the snapshot is truncated");
+      }
+      get(rRecipe.parameters, iParameters);
+      rRecipe.tables.resize(iTables);
+      for (std::vector<double> &rTable : rRecipe.tables)
+      {
+        get(rTable, get<std::uint64_t>());
+      }
+      rRecipe.curves.resize(iCurves);
+      for (vega::CurveRecipe &rCurve : rRecipe.curves)
+      {
+        get(rCurve, iDepth + 1);
+      }
+    }
+
+  private:
+    const char *take(std::size_t iSize)
+    {
+      if (iSize > std::size_t(m_pEnd - m_pNext))
+      {
+        throw std::runtime_error("the snapshot is truncated");
+      }
+      const char *pData = m_pNext;
+      m_pNext += iSize;
+      return pData;
+    }
+
+    const char *m_pNext;
+    const char *m_pEnd;
+  };
+} // namespace snapshotFile
+
+void vega::writeSnapshot(const std::string &sFile,
+                         const std::vector<CurveRecipe> &rRecipes)
+{
+  using namespace snapshotFile;
+
+  std::string sPayload;
+  for (const CurveRecipe &rRecipe : rRecipes)
+  {
+    put(sPayload, rRecipe);
+  }
+  std::string sHeader(c_sMagic, 8);
+  put<std::uint32_t>(sHeader, c_iVersion);
+  put<std::uint32_t>(sHeader, rRecipes.size());
+  put<std::uint64_t>(sHeader, sPayload.size());
+  put<std::uint64_t>(sHeader, checksum(sPayload.data(), sPayload.size()));
+
+  std::ofstream fOut(sFile.c_str(), std::ios::binary);
+  if (!fOut)
+  {
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  fOut.write(sHeader.data(), sHeader.size());
+  fOut.write(sPayload.data(), sPayload.size());
+}
+
+namespace snapshotFile
+{
+  // reads the file, checks the header and the checksum and calls rF
+  // for every recipe; the same recipe is reused, so the vectors are
+  // allocated only when they grow
+  void read(const std::string &sFile,
+            const std::function<void(std::uint32_t, const vega::CurveRecipe &)> &rF)
+  {
+    std::ifstream fIn(sFile.c_str(), std::ios::binary | std::ios::ate);
+    if (!fIn)
+    {
+      throw std::runtime_error("cannot open the file " + sFile);
+    }
+    std::vector<char> uBytes(std::size_t(fIn.tellg()));
+    fIn.seekg(0);
+    fIn.read(uBytes.data(), uBytes.size());
+    if (!fIn || uBytes.size() < c_iHeader || std::memcmp(uBytes.data(), c_sMagic, 8) != 0)
+    {
+      throw std::runtime_error("the file " + sFile + " is not a snapshot of curves");
+    }
+    Reader uHeader(uBytes.data() + 8, uBytes.data() + c_iHeader);
+    std::uint32_t iVersion = uHeader.get<std::uint32_t>();
+    std::uint32_t iCurves = uHeader.get<std::uint32_t>();
+    std::uint64_t iPayload = uHeader.get<std::uint64_t>();
+    std::uint64_t iChecksum = uHeader.get<std::uint64_t>();
+    if (iVersion != c_iVersion)
+    {
+      throw std::runtime_error("the snapshot " + sFile + " has version " +
+                               std::to_string(iVersion) + " instead of 1");
+    }
+    if (iPayload != uBytes.size() - c_iHeader ||
+        checksum(uBytes.data() + c_iHeader, iPayload) != iChecksum)
+    {
+      throw std::runtime_error("wrong checksum of the snapshot " + sFile);
+    }
+
+    Reader uPayload(uBytes.data() + c_iHeader, uBytes.data() + uBytes.size());
+    vega::CurveRecipe uRecipe;
+    for (std::uint32_t i = 0; i < iCurves; i++)
+    {
+      uPayload.get(uRecipe);
+      rF(iCurves, uRecipe);
+    }
+  }
+} // namespace snapshotFile
+
+std::vector<vega::CurveRecipe> vega::readSnapshot(const std::string &sFile)
+{
+  std::vector<CurveRecipe> uRecipes;
+  snapshotFile::read(sFile, [&uRecipes](std::uint32_t iCurves, const CurveRecipe &rRecipe)
+                     {
+                       uRecipes.reserve(iCurves);
+                       uRecipes.push_back(rRecipe); });
+  return uRecipes;
+}
+
+std::vector<std::function<double(double)>>
+vega::restoreSnapshot(const std::string &sFile)
+{
+  std::vector<std::function<double(double)>> uCurves;
+  snapshotFile::read(sFile, [&uCurves](std::uint32_t iCurves, const CurveRecipe &rRecipe)
+                     {
+                       uCurves.reserve(iCurves);
+                       uCurves.push_back(rRecipe.build()); });
+  return uCurves;
+}
@@ -0,0 +1,246 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "test/Market.hpp"
+#include "snapshot/Output.hpp"
+#include "snapshot/snapshot.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+#include "prepExam/prepExam.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace test;
+using namespace std;
+
+namespace NSnapshot
+{
+  // a curve built directly and its recipe
+  class Curve
+  {
+  public:
+    std::string name;
+    std::function<double(double)> curve;
+    vega::CurveRecipe recipe;
+  };
+
+  std::vector<Curve> curves(double dInitialTime)
+  {
+    typedef vega::CurveRecipe R;
+
+    auto uDF = getDiscount(dInitialTime);
+    auto uF = getForward(100., dInitialTime);
+    auto uVol = getVol(dInitialTime);
+    double dSpot = 100.;
+    std::vector<double> uPayments = {3., 3., 3., 103.};
+    std::vector<double> uPaymentTimes = {dInitialTime + 1., dInitialTime + 2.,
+                                         dInitialTime + 3., dInitialTime + 4.5};
+    std::vector<double> uDividends = {1., 1.5, 2.};
+    std::vector<double> uDividendTimes = {dInitialTime + 0.5, dInitialTime + 2.,
+                                          dInitialTime + 4.5};
+
+    R uNS{R::discountNelsonSiegel, {0.05, 0.02, 0.01, 0.2, dInitialTime}, {}, {}};
+    R uLogLin{R::discountLogLinInterp, {dInitialTime}, {uDF.first, uDF.second}, {}};
+    R uVasicek{R::discountVasicek, {0.05, 0.3, 0.01, 0.04, dInitialTime}, {}, {}};
+    std::function<double(double)> uNSCurve =
+        vega::discountNelsonSiegel(0.05, 0.02, 0.01, 0.2, dInitialTime);
+    std::function<double(double)> uLogLinCurve =
+        vega::discountLogLinInterp(uDF.first, uDF.second, dInitialTime);
+    std::function<double(double)> uVasicekCurve =
+        vega::discountVasicek(0.05, 0.3, 0.01, 0.04, dInitialTime);
+
+    return {
+        {"discountNelsonSiegel", uNSCurve, uNS},
+        {"discountYieldLinInterp", vega::discountYieldLinInterp(uDF.first, uDF.second, 0.04, dInitialTime),
+         R{R::discountYieldLinInterp, {0.04, dInitialTime}, {uDF.first, uDF.second}, {}}},
+        {"forwardCashFlow", vega::forwardCashFlow(uPayments, uPaymentTimes, uLogLinCurve),
+         R{R::forwardCashFlow, {}, {uPayments, uPaymentTimes}, {uLogLin}}},
+        {"forwardCouponBond", vega::forwardCouponBond(0.06, 0.5, dInitialTime + 10., uNSCurve, true),
+         R{R::forwardCouponBond, {0.06, 0.5, dInitialTime + 10., 1.}, {}, {uNS}}},
+        {"yield", vega::yield(uVasicekCurve, dInitialTime),
+         R{R::yield, {dInitialTime}, {}, {uVasicek}}},
+        {"yieldNelsonSiegel", vega::yieldNelsonSiegel(0.05, 0.02, 0.01, 0.2, dInitialTime),
+         R{R::yieldNelsonSiegel, {0.05, 0.02, 0.01, 0.2, dInitialTime}, {}, {}}},
+        {"yieldShape1", vega::yieldShape1(0.2, dInitialTime),
+         R{R::yieldShape1, {0.2, dInitialTime}, {}, {}}},
+        {"yieldShape2", vega::yieldShape2(0.2, dInitialTime),
+         R{R::yieldShape2, {0.2, dInitialTime}, {}, {}}},
+        {"carryBlack", vega::carryBlack(0.03, 0.2, 0.1, dInitialTime),
+         R{R::carryBlack, {0.03, 0.2, 0.1, dInitialTime}, {}, {}}},
+        {"discountLogLinInterp", uLogLinCurve, uLogLin},
+        {"discountVasicek", uVasicekCurve, uVasicek},
+        {"forwardAnnuity", vega::forwardAnnuity(0.06, 0.5, dInitialTime + 10., uNSCurve, false),
+         R{R::forwardAnnuity, {0.06, 0.5, dInitialTime + 10., 0.}, {}, {uNS}}},
+        {"forwardStockDividends",
+         vega::forwardStockDividends(dSpot, uDividendTimes, uDividends, uLogLinCurve),
+         R{R::forwardStockDividends, {dSpot}, {uDividendTimes, uDividends}, {uLogLin}}},
+        {"forwardSwapRate", vega::forwardSwapRate(0.5, 10, uNSCurve),
+         R{R::forwardSwapRate, {0.5, 10.}, {}, {uNS}}},
+        {"volatilityVar", vega::volatilityVar(vega::yieldShape2(0.2, dInitialTime), dInitialTime),
+         R{R::volatilityVar, {dInitialTime}, {}, {R{R::yieldShape2, {0.2, dInitialTime}, {}, {}}}}},
+        {"volatilityVarLinInterp", vega::volatilityVarLinInterp(uVol.first, uVol.second, dInitialTime),
+         R{R::volatilityVarLinInterp, {dInitialTime}, {uVol.first, uVol.second}, {}}},
+        {"yieldVasicek", vega::yieldVasicek(0.05, 0.3, 0.01, 0.04, dInitialTime),
+         R{R::yieldVasicek, {0.05, 0.3, 0.01, 0.04, dInitialTime}, {}, {}}},
+        {"forwardFX", vega::forwardFX(1.2, uNSCurve, uVasicekCurve),
+         R{R::forwardFX, {1.2}, {}, {uNS, uVasicek}}},
+        {"yieldSvensson", vega::yieldSvensson(0.05, 0.02, 0.01, 0.015, 0.2, 0.7, dInitialTime),
+         R{R::yieldSvensson, {0.05, 0.02, 0.01, 0.015, 0.2, 0.7, dInitialTime}, {}, {}}},
+        {"volatilityBlack", vega::volatilityBlack(0.2, 0.1, dInitialTime),
+         R{R::volatilityBlack, {0.2, 0.1, dInitialTime}, {}, {}}},
+        {"forwardLibor", vega::forwardLibor(0.25, uNSCurve),
+         R{R::forwardLibor, {0.25}, {}, {uNS}}},
+        {"forwardCarryLinInterp", vega::forwardCarryLinInterp(dSpot, uF.first, uF.second, dInitialTime),
+         R{R::forwardCarryLinInterp, {dSpot, dInitialTime}, {uF.first, uF.second}, {}}}};
+  }
+
+  // the number of points where the values differ in at least one bit
+  double differences(const std::function<double(double)> &rOriginal,
+                     const std::function<double(double)> &rRestored,
+                     const std::valarray<double> &rArg)
+  {
+    unsigned iDifferent = 0;
+    for (double dT : rArg)
+    {
+      double dX = rOriginal(dT), dY = rRestored(dT);
+      iDifferent += (std::memcmp(&dX, &dY, sizeof(double)) != 0);
+    }
+    return iDifferent;
+  }
+} // namespace NSnapshot
+
+void restoreAllCurves()
+{
+  print("SNAPSHOT AND RESTORE OF ALL CURVES");
+
+  double dInitialTime = 1.;
+  unsigned iPoints = 1000;
+  std::vector<NSnapshot::Curve> uCurves = NSnapshot::curves(dInitialTime);
+  std::vector<vega::CurveRecipe> uRecipes;
+  for (const NSnapshot::Curve &rCurve : uCurves)
+  {
+    uRecipes.push_back(rCurve.recipe);
+  }
+
+  std::string sFile = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME + "/curves.snp";
+  vega::writeSnapshot(sFile, uRecipes);
+  std::vector<std::function<double(double)>> uRestored = vega::restoreSnapshot(sFile);
+  print(uRestored.size(), "restored curves");
+  print(iPoints, "points in every comparison", true);
+
+  // the domains of the interpolated curves end at the last quote
+  std::valarray<double> uArg = getRandArg(dInitialTime, dInitialTime + 4.5, iPoints);
+  std::vector<std::vector<double>> uColumns(3);
+  for (unsigned i = 0; i < uCurves.size(); i++)
+  {
+    uColumns[0].push_back(i);
+    uColumns[1].push_back(NSnapshot::differences(uCurves[i].curve, uRestored[i], uArg));
+    uColumns[2].push_back(uCurves[i].curve(dInitialTime + 2.));
+  }
+  printTable(uColumns, {"curve", "different", "value(t0+2)"},
+             "restored versus original curves", 14, 3, uCurves.size());
+  for (unsigned i = 0; i < uCurves.size(); i++)
+  {
+    out() << "curve " << i << ": " << uCurves[i].name << endl;
+  }
+  out() << endl;
+
+  // a damaged snapshot is rejected
+  std::string sDamaged = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME + "/damaged.snp";
+  {
+    std::ifstream fIn(sFile.c_str(), std::ios::binary);
+    std::string sBytes((std::istreambuf_iterator<char>(fIn)), std::istreambuf_iterator<char>());
+    sBytes[sBytes.size() / 2] ^= 1;
+    std::ofstream(sDamaged.c_str(), std::ios::binary) << sBytes;
+  }
+  try
+  {
+    vega::readSnapshot(sDamaged);
+    print("the damaged snapshot is accepted");
+  }
+  catch (const std::runtime_error &)
+  {
+    print("the damaged snapshot is rejected");
+  }
+  out() << endl;
+}
+
+void rebuildVersusRestore()
+{
+  print("COLD REBUILD VERSUS RESTORE");
+
+  double dInitialTime = 1.;
+  unsigned iCurves = 20000;
+
+  // half of the curves are interpolated from market quotes and half
+  // are Svensson curves
+  auto uDF = getDiscount(dInitialTime);
+  std::valarray<double> uShift = getRandArg(-0.02, 0.02, iCurves);
+  MarketData uData;
+  std::vector<vega::CurveRecipe> uRecipes;
+  std::vector<double> uValues(uDF.second.size());
+  for (unsigned n = 0; n < iCurves; n += 2)
+  {
+    for (unsigned i = 0; i < uValues.size(); i++)
+    {
+      uValues[i] = uDF.second[i] * std::exp(-uShift[n] * (uDF.first[i] - dInitialTime));
+    }
+    uData.push_back("discount" + std::to_string(n), uDF.first, uValues);
+    uRecipes.push_back({vega::CurveRecipe::discountLogLinInterp, {dInitialTime}, {uDF.first, uValues}, {}});
+    uRecipes.push_back({vega::CurveRecipe::yieldSvensson,
+                        {0.05 + uShift[n + 1], 0.02, 0.01, 0.015, 0.2, 0.7, dInitialTime}, {}, {}});
+  }
+  std::string sDir = std::string(OUTPUT_DIR) + "/" + PROJECT_NAME;
+  writeMarketCsv(sDir + "/quotes.csv", uData);
+  vega::writeSnapshot(sDir + "/rebuild.snp", uRecipes);
+  print(iCurves, "number of curves", true);
+
+  // cold rebuild: parse the market quotes and build the curves
+  double dStart = seconds();
+  MarketData uQuotes = readMarketCsv(sDir + "/quotes.csv");
+  std::vector<std::function<double(double)>> uRebuilt;
+  uRebuilt.reserve(iCurves);
+  for (unsigned n = 0; n < iCurves; n += 2)
+  {
+    MarketCurve uCurve = uQuotes.curve(n / 2);
+    uRebuilt.push_back(vega::discountLogLinInterp(std::vector<double>(uCurve.times),
+                                                  std::vector<double>(uCurve.values), dInitialTime));
+    uRebuilt.push_back(vega::yieldSvensson(0.05 + uShift[n + 1], 0.02, 0.01, 0.015,
+                                           0.2, 0.7, dInitialTime));
+  }
+  double dRebuild = seconds() - dStart;
+
+  dStart = seconds();
+  std::vector<std::function<double(double)>> uRestored = vega::restoreSnapshot(sDir + "/rebuild.snp");
+  double dRestore = seconds() - dStart;
+
+  print(1e6 * dRebuild / iCurves, "microseconds per curve: cold rebuild");
+  print(1e6 * dRestore / iCurves, "microseconds per curve: restore", true);
+
+  std::valarray<double> uArg = getRandArg(dInitialTime, uDF.first.back(), 10);
+  double dDifferent = 0.;
+  for (unsigned n = 0; n < iCurves; n++)
+  {
+    dDifferent += NSnapshot::differences(uRebuilt[n], uRestored[n], uArg);
+  }
+  print(dDifferent, "values of restored curves that differ from rebuilt ones", true);
+}
+
+std::function<void()> test_snapshot()
+{
+  return []()
+  {
+    print("BINARY SNAPSHOTS OF CURVES");
+
+    restoreAllCurves();
+    rebuildVersusRestore();
+  };
+}
+
+int main()
+{
+  project(test_snapshot(), PROJECT_NAME, PROJECT_NAME,
+          "Snapshots of curves");
+}
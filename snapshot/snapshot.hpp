@@ -0,0 +1,168 @@
+#ifndef __vega_snapshot_hpp__
+#define __vega_snapshot_hpp__
+
+/**
+ * @file snapshot.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Binary snapshots of curves
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaSnapshot Binary snapshots of curves.
+   *
+   * The curves of Vega are closures and cannot be written to a file.
+   * Instead, a curve is described by a recipe: the name of its
+   * builder, the numerical arguments (parameters of a parametric
+   * model), the vectors of arguments (tables of knots of an
+   * interpolated curve) and the recipes of the curves passed as
+   * arguments. The recipe rebuilds the curve by the same builder from
+   * the same numbers, so the restored curve evaluates bit-identically
+   * to the original one.
+   *
+   * The recipes are saved in a versioned binary file protected by a
+   * checksum. All numbers are little-endian:
+   * \code
+   * offset 0   "VEGASNP\0"              magic
+   * offset 8   uint32 version           (1)
+   * offset 12  uint32 curves            K
+   * offset 16  uint64 payload size      B
+   * offset 24  uint64 checksum          FNV-1a hash of the payload
+   * offset 32  K recipes of B bytes; a recipe is
+   *            uint32 builder, uint32 parameters P, uint32 tables T,
+   *            uint32 curves C, P doubles, T tables (uint64 size
+   *            followed by the doubles), C recipes
+   * \endcode
+   *
+   * @{
+   */
+
+  /**
+   * @brief The recipe of a curve of one variable.
+   *
+   * The parameters, tables and curves are the arguments of the
+   * builder in the order of its declaration: doubles, integers and
+   * flags go to the parameters, vectors to the tables and functions
+   * to the curves. For example, the recipe
+   * \code
+   * CurveRecipe{CurveRecipe::forwardCouponBond, {dRate, dPeriod, dMaturity, 1.},
+   *             {}, {uDiscount}}
+   * \endcode
+   * builds forwardCouponBond(dRate, dPeriod, dMaturity, uDiscount.build(), true).
+   */
+  class CurveRecipe
+  {
+  public:
+    /**
+     * The builders of curves of one variable. The values are stored
+     * in the files and must not change.
+     */
+    enum Builder : std::uint32_t
+    {
+      discountNelsonSiegel = 1,
+      discountYieldLinInterp = 2,
+      forwardCashFlow = 3,
+      forwardCouponBond = 4,
+      yield = 5,
+      yieldNelsonSiegel = 6,
+      yieldShape1 = 7,
+      yieldShape2 = 8,
+      carryBlack = 9,
+      discountLogLinInterp = 10,
+      discountVasicek = 11,
+      forwardAnnuity = 12,
+      forwardStockDividends = 13,
+      forwardSwapRate = 14,
+      volatilityVar = 15,
+      volatilityVarLinInterp = 16,
+      yieldVasicek = 17,
+      forwardFX = 18,
+      yieldSvensson = 19,
+      volatilityBlack = 20,
+      forwardLibor = 21,
+      forwardCarryLinInterp = 22
+    };
+
+    /**
+     * The builder of the curve.
+     */
+    Builder builder;
+
+    /**
+     * The numerical arguments of the builder.
+     */
+    std::vector<double> parameters;
+
+    /**
+     * The vector arguments of the builder.
+     */
+    std::vector<std::vector<double>> tables;
+
+    /**
+     * The recipes of the curves passed to the builder.
+     */
+    std::vector<CurveRecipe> curves;
+
+    /**
+     * The maximal depth of nested recipes.
+     */
+    static const unsigned maxDepth = 64;
+
+    /**
+     * Builds the curve. A recipe whose numbers of parameters, tables
+     * or curves do not match the builder, or whose recipes are nested
+     * deeper than maxDepth, throws std::runtime_error.
+     *
+     * @return The curve given by the recipe.
+     */
+    std::function<double(double)> build() const;
+
+  private:
+    std::function<double(double)> build(unsigned iDepth) const;
+  };
+
+  /**
+   * Writes the recipes of curves to a snapshot file.
+   *
+   * @param sFile The name of the file.
+   * @param rRecipes The recipes of curves.
+   */
+  void writeSnapshot(const std::string &sFile,
+                     const std::vector<CurveRecipe> &rRecipes);
+
+  /**
+   * Reads the recipes of curves from a snapshot file. Throws
+   * std::runtime_error if the file cannot be read, has another
+   * version, its checksum is wrong or its recipes are nested deeper
+   * than CurveRecipe::maxDepth.
+   *
+   * @param sFile The name of the file written by writeSnapshot().
+   * @return The recipes of curves.
+   */
+  std::vector<CurveRecipe> readSnapshot(const std::string &sFile);
+
+  /**
+   * Restores the curves from a snapshot file. Throws
+   * std::runtime_error as readSnapshot() and CurveRecipe::build().
+   *
+   * @param sFile The name of the file written by writeSnapshot().
+   * @return The curves in the order of the recipes.
+   */
+  std::vector<std::function<double(double)>>
+  restoreSnapshot(const std::string &sFile);
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_snapshot_hpp__
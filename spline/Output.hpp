@@ -0,0 +1,11 @@
+#ifndef __spline_Output_hpp__
+#define __spline_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "spline"
+} // namespace test
+
+#endif // of __spline_Output_hpp
@@ -0,0 +1,180 @@
+#include "spline/spline.hpp"
+#include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
+#include "header.hpp"
+
+vega::DiscountMonotoneConvex::DiscountMonotoneConvex(const std::vector<double> &rTimes,
+                                                     const std::vector<double> &rDF,
+                                                     double dInitialTime)
+    : m_uTimes(1, dInitialTime)
+{
+  PRECONDITION(rTimes.size() == rDF.size());
+  PRECONDITION(!rTimes.empty());
+  PRECONDITION(rTimes.front() > dInitialTime);
+  PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+
+  m_uTimes.insert(m_uTimes.end(), rTimes.begin(), rTimes.end());
+  unsigned iM = rTimes.size();
+
+  // the discrete forward rates of the segments
+  m_uSegments.resize(iM);
+  double dLogDF = 0.;
+  for (unsigned i = 0; i < iM; i++)
+  {
+    PRECONDITION(rDF[i] > 0);
+    Segment &rS = m_uSegments[i];
+    rS.logDF = dLogDF;
+    rS.length = m_uTimes[i + 1] - m_uTimes[i];
+    dLogDF = std::log(rDF[i]);
+    rS.forward = (rS.logDF - dLogDF) / rS.length;
+  }
+
+  // the instantaneous forward rates at the knots
+  std::vector<double> uF(iM + 1, m_uSegments.front().forward);
+  if (iM > 1)
+  {
+    for (unsigned i = 1; i < iM; i++)
+    {
+      const Segment &rLeft = m_uSegments[i - 1];
+      const Segment &rRight = m_uSegments[i];
+      uF[i] = (rLeft.length * rRight.forward + rRight.length * rLeft.forward) /
+              (rLeft.length + rRight.length);
+    }
+    uF[0] = m_uSegments.front().forward - 0.5 * (uF[1] - m_uSegments.front().forward);
+    uF[iM] = m_uSegments.back().forward - 0.5 * (uF[iM - 1] - m_uSegments.back().forward);
+  }
+
+  // the regions of Hagan and West for the function g
+  for (unsigned i = 0; i < iM; i++)
+  {
+    Segment &rS = m_uSegments[i];
+    double dG0 = uF[i] - rS.forward;
+    double dG1 = uF[i + 1] - rS.forward;
+    rS.g0 = dG0;
+    rS.g1 = dG1;
+    rS.eta = 0.;
+    rS.level = 0.;
+    rS.quadratic = false;
+    if ((dG0 == 0. && dG1 == 0.) ||
+        (dG0 < 0. && -0.5 * dG0 <= dG1 && dG1 <= -2. * dG0) ||
+        (dG0 > 0. && -0.5 * dG0 >= dG1 && dG1 >= -2. * dG0))
+    {
+      rS.quadratic = true;
+    }
+    else if ((dG0 < 0. && dG1 > -2. * dG0) || (dG0 > 0. && dG1 < -2. * dG0))
+    {
+      // g = g0 on [0, eta], then quadratic
+      rS.eta = (dG1 + 2. * dG0) / (dG1 - dG0);
+      rS.level = dG0;
+    }
+    else if ((dG0 > 0. && 0. > dG1 && dG1 > -0.5 * dG0) || (dG0 < 0. && 0. < dG1 && dG1 < -0.5 * dG0))
+    {
+      // quadratic on [0, eta], then g = g1
+      rS.eta = 3. * dG1 / (dG1 - dG0);
+      rS.level = dG1;
+    }
+    else
+    {
+      // two quadratics meeting at the level A with zero slope
+      rS.eta = dG1 / (dG1 + dG0);
+      rS.level = -dG0 * dG1 / (dG0 + dG1);
+    }
+  }
+}
+
+double vega::DiscountMonotoneConvex::exponent(double dT, unsigned iI) const
+{
+  // log d(t) = log d_{i-1} - h (f^d x + G(x)), where G is the integral of g
+  const Segment &rS = m_uSegments[iI - 1];
+  double dX = (dT - m_uTimes[iI - 1]) / rS.length;
+  double dG;
+  if (rS.quadratic)
+  {
+    dG = dX * (rS.g0 * (1. - dX) * (1. - dX) - rS.g1 * dX * (1. - dX));
+  }
+  else
+  {
+    double dA = rS.level;
+    double dEta = rS.eta;
+    dG = dA * dX;
+    if (dX < dEta)
+    {
+      double dY = (dEta - dX) / dEta;
+      dG += (rS.g0 - dA) * dEta / 3. * (1. - dY * dY * dY);
+    }
+    else
+    {
+      dG += (rS.g0 - dA) * dEta / 3.;
+      if (dEta < 1.)
+      {
+        double dY = dX - dEta;
+        dG += (rS.g1 - dA) * dY * dY * dY / (3. * (1. - dEta) * (1. - dEta));
+      }
+    }
+  }
+  return rS.logDF - rS.length * (rS.forward * dX + dG);
+}
+
+double vega::DiscountMonotoneConvex::operator()(double dT) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end(), dT) - m_uTimes.begin();
+  return std::exp(exponent(dT, iI));
+}
+
+void vega::DiscountMonotoneConvex::operator()(const double *pT, std::size_t iSize, double *pDiscount) const
+{
+  unsigned iI = 1;
+  for (std::size_t j = 0; j < iSize; j++)
+  {
+    PRECONDITION(pT[j] >= m_uTimes.front());
+    PRECONDITION(pT[j] <= m_uTimes.back());
+
+    iI = spline::segment(m_uTimes, pT[j], iI);
+    pDiscount[j] = exponent(pT[j], iI);
+  }
+  spline::exp(pDiscount, iSize);
+}
+
+std::vector<double> vega::DiscountMonotoneConvex::operator()(const std::vector<double> &rT) const
+{
+  std::vector<double> uDiscount(rT.size());
+  (*this)(rT.data(), rT.size(), uDiscount.data());
+  return uDiscount;
+}
+
+double vega::DiscountMonotoneConvex::forward(double dT) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end(), dT) - m_uTimes.begin();
+  const Segment &rS = m_uSegments[iI - 1];
+  double dX = (dT - m_uTimes[iI - 1]) / rS.length;
+  double dG;
+  if (rS.quadratic)
+  {
+    dG = rS.g0 * (1. - 4. * dX + 3. * dX * dX) + rS.g1 * (3. * dX * dX - 2. * dX);
+  }
+  else if (dX < rS.eta)
+  {
+    double dY = (rS.eta - dX) / rS.eta;
+    dG = rS.level + (rS.g0 - rS.level) * dY * dY;
+  }
+  else
+  {
+    double dY = (rS.eta < 1.) ? (dX - rS.eta) / (1. - rS.eta) : 0.;
+    dG = rS.level + (rS.g1 - rS.level) * dY * dY;
+  }
+  return rS.forward + dG;
+}
+
+std::function<double(double)>
+vega::discountMonotoneConvex(const std::vector<double> &rTimes,
+                             const std::vector<double> &rDF,
+                             double dInitialTime)
+{
+  return VEGA_TRACE_CURVE("discountMonotoneConvex", DiscountMonotoneConvex(rTimes, rDF, dInitialTime));
+}
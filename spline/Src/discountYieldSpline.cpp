@@ -0,0 +1,161 @@
+#include "spline/spline.hpp"
+#include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
+#include "header.hpp"
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_vector.h>
+
+namespace
+{
+  // the yields at t_0, t_1, ..., t_M
+  std::vector<double> yields(const std::vector<double> &rTimes, const std::vector<double> &rDF,
+                             double dR, double dInitialTime)
+  {
+    PRECONDITION(rTimes.size() == rDF.size());
+    PRECONDITION(!rTimes.empty());
+    PRECONDITION(rTimes.front() > dInitialTime);
+    PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+
+    std::vector<double> uYields(1, dR);
+    for (unsigned i = 0; i < rTimes.size(); i++)
+    {
+      PRECONDITION(rDF[i] > 0);
+      uYields.push_back(-std::log(rDF[i]) / (rTimes[i] - dInitialTime));
+    }
+    return uYields;
+  }
+}
+
+vega::DiscountYieldSpline::DiscountYieldSpline(const std::vector<double> &rTimes,
+                                               const std::vector<double> &rDF,
+                                               double dR, double dInitialTime)
+    : m_uTimes(1, dInitialTime)
+{
+  m_uTimes.insert(m_uTimes.end(), rTimes.begin(), rTimes.end());
+  solve(yields(rTimes, rDF, dR, dInitialTime), false, 0., 0.);
+}
+
+vega::DiscountYieldSpline::DiscountYieldSpline(const std::vector<double> &rTimes,
+                                               const std::vector<double> &rDF,
+                                               double dR, double dInitialTime,
+                                               double dFirstSlope, double dLastSlope)
+    : m_uTimes(1, dInitialTime)
+{
+  m_uTimes.insert(m_uTimes.end(), rTimes.begin(), rTimes.end());
+  solve(yields(rTimes, rDF, dR, dInitialTime), true, dFirstSlope, dLastSlope);
+}
+
+void vega::DiscountYieldSpline::solve(const std::vector<double> &rYields, bool bClamped,
+                                      double dFirstSlope, double dLastSlope)
+{
+  // the second derivatives m_0, ..., m_M at the knots solve the
+  // tridiagonal system with the rows
+  // h_{j-1} m_{j-1} + 2 (h_{j-1} + h_j) m_j + h_j m_{j+1} = 6 (s_j - s_{j-1}),
+  // where h_j and s_j are the lengths and the slopes of the segments
+  unsigned iM = m_uTimes.size() - 1;
+  std::vector<double> uH(iM), uS(iM);
+  for (unsigned j = 0; j < iM; j++)
+  {
+    uH[j] = m_uTimes[j + 1] - m_uTimes[j];
+    uS[j] = (rYields[j + 1] - rYields[j]) / uH[j];
+  }
+
+  std::vector<double> uDiag(iM + 1), uAbove(iM), uBelow(iM), uRight(iM + 1), uSecond(iM + 1);
+  for (unsigned j = 1; j < iM; j++)
+  {
+    uBelow[j - 1] = uH[j - 1];
+    uDiag[j] = 2. * (uH[j - 1] + uH[j]);
+    uAbove[j] = uH[j];
+    uRight[j] = 6. * (uS[j] - uS[j - 1]);
+  }
+  if (bClamped)
+  {
+    uDiag[0] = 2. * uH[0];
+    uAbove[0] = uH[0];
+    uRight[0] = 6. * (uS[0] - dFirstSlope);
+    uBelow[iM - 1] = uH[iM - 1];
+    uDiag[iM] = 2. * uH[iM - 1];
+    uRight[iM] = 6. * (dLastSlope - uS[iM - 1]);
+  }
+  else
+  {
+    // m_0 = m_M = 0
+    uDiag[0] = 1.;
+    uDiag[iM] = 1.;
+  }
+
+  gsl_vector_view uD = gsl_vector_view_array(uDiag.data(), uDiag.size());
+  gsl_vector_view uE = gsl_vector_view_array(uAbove.data(), uAbove.size());
+  gsl_vector_view uF = gsl_vector_view_array(uBelow.data(), uBelow.size());
+  gsl_vector_view uB = gsl_vector_view_array(uRight.data(), uRight.size());
+  gsl_vector_view uX = gsl_vector_view_array(uSecond.data(), uSecond.size());
+  int iStatus = gsl_linalg_solve_tridiag(&uD.vector, &uE.vector, &uF.vector, &uB.vector, &uX.vector);
+  ASSERT(iStatus == 0);
+
+  m_uCoeff.resize(4 * iM);
+  for (unsigned j = 0; j < iM; j++)
+  {
+    double *pC = m_uCoeff.data() + 4 * j;
+    pC[0] = rYields[j];
+    pC[1] = uS[j] - uH[j] * (2. * uSecond[j] + uSecond[j + 1]) / 6.;
+    pC[2] = uSecond[j] / 2.;
+    pC[3] = (uSecond[j + 1] - uSecond[j]) / (6. * uH[j]);
+  }
+}
+
+double vega::DiscountYieldSpline::exponent(double dT, unsigned iI) const
+{
+  const double *pC = m_uCoeff.data() + 4 * (iI - 1);
+  double dH = dT - m_uTimes[iI - 1];
+  double dY = pC[0] + dH * (pC[1] + dH * (pC[2] + dH * pC[3]));
+  return -dY * (dT - m_uTimes.front());
+}
+
+double vega::DiscountYieldSpline::operator()(double dT) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end(), dT) - m_uTimes.begin();
+  return std::exp(exponent(dT, iI));
+}
+
+void vega::DiscountYieldSpline::operator()(const double *pT, std::size_t iSize, double *pDiscount) const
+{
+  unsigned iI = 1;
+  for (std::size_t j = 0; j < iSize; j++)
+  {
+    PRECONDITION(pT[j] >= m_uTimes.front());
+    PRECONDITION(pT[j] <= m_uTimes.back());
+
+    iI = spline::segment(m_uTimes, pT[j], iI);
+    pDiscount[j] = exponent(pT[j], iI);
+  }
+  spline::exp(pDiscount, iSize);
+}
+
+std::vector<double> vega::DiscountYieldSpline::operator()(const std::vector<double> &rT) const
+{
+  std::vector<double> uDiscount(rT.size());
+  (*this)(rT.data(), rT.size(), uDiscount.data());
+  return uDiscount;
+}
+
+double vega::DiscountYieldSpline::yield(double dT) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end(), dT) - m_uTimes.begin();
+  const double *pC = m_uCoeff.data() + 4 * (iI - 1);
+  double dH = dT - m_uTimes[iI - 1];
+  return pC[0] + dH * (pC[1] + dH * (pC[2] + dH * pC[3]));
+}
+
+std::function<double(double)>
+vega::discountYieldSpline(const std::vector<double> &rTimes,
+                          const std::vector<double> &rDF,
+                          double dR, double dInitialTime)
+{
+  return VEGA_TRACE_CURVE("discountYieldSpline", DiscountYieldSpline(rTimes, rDF, dR, dInitialTime));
+}
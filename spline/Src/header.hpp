@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace spline
+{
+  // the index i of the segment [t_{i-1}, t_i] that contains dT, the same
+  // as the binary search of the scalar path; the segment iHint of the
+  // previous time and the next one are tried first
+  inline unsigned segment(const std::vector<double> &rTimes, double dT, unsigned iHint)
+  {
+    if (dT <= rTimes[iHint] && (iHint == 1 || dT > rTimes[iHint - 1]))
+    {
+      return iHint;
+    }
+    if (iHint + 1 < rTimes.size() && dT > rTimes[iHint] && dT <= rTimes[iHint + 1])
+    {
+      return iHint + 1;
+    }
+    return std::lower_bound(rTimes.begin() + 1, rTimes.end(), dT) - rTimes.begin();
+  }
+
+  // the exponentials of the exponents in place; the loop is vectorized
+  inline void exp(double *pY, std::size_t iSize)
+  {
+    for (std::size_t j = 0; j < iSize; j++)
+    {
+      pY[j] = std::exp(pY[j]);
+    }
+  }
+} // namespace spline
@@ -0,0 +1,191 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "spline/Output.hpp"
+#include "spline/spline.hpp"
+#include "prep1/prep1.hpp"
+#include "prep2/prep2.hpp"
+
+using namespace test;
+using namespace std;
+
+namespace NSpline
+{
+  // the maximal relative error of the curve at the market maturities
+  double repricing(const std::function<double(double)> &rDiscount,
+                   const std::vector<double> &rTimes, const std::vector<double> &rDF)
+  {
+    double dError = 0.;
+    for (unsigned i = 0; i < rTimes.size(); i++)
+    {
+      dError = std::max(dError, std::abs(rDiscount(rTimes[i]) / rDF[i] - 1.));
+    }
+    return dError;
+  }
+
+  // the maximal relative difference of the batch and the scalar paths
+  template <class C>
+  double batch(const C &rCurve, const std::vector<double> &rT)
+  {
+    std::vector<double> uBatch = rCurve(rT);
+    double dError = 0.;
+    for (unsigned j = 0; j < rT.size(); j++)
+    {
+      dError = std::max(dError, std::abs(uBatch[j] / rCurve(rT[j]) - 1.));
+    }
+    return dError;
+  }
+
+  // the time of the scalar path over the times
+  Measurement scalar(const std::function<double(double)> &rF, const std::vector<double> &rT,
+                     const std::string &sCurve, unsigned iKnots)
+  {
+    double dSum = 0.;
+    Measurement uM = measure([&rF, &rT, &dSum]()
+                             {
+                               for (double dT : rT)
+                               {
+                                 dSum += rF(dT);
+                               } },
+                             sCurve, "scalar", iKnots, rT.size());
+    keepAlive(dSum);
+    return uM;
+  }
+
+  // the time of the batch path over the times
+  template <class C>
+  Measurement batchTime(const C &rCurve, const std::vector<double> &rT,
+                        const std::string &sCurve, unsigned iKnots)
+  {
+    std::vector<double> uDiscount(rT.size());
+    Measurement uM = measure([&rCurve, &rT, &uDiscount]()
+                             { rCurve(rT.data(), rT.size(), uDiscount.data()); },
+                             sCurve, "batch", iKnots, rT.size());
+    keepAlive(uDiscount.front());
+    return uM;
+  }
+} // namespace NSpline
+
+void discountYieldSpline()
+{
+  print("DISCOUNT CURVES BY CUBIC SPLINES OF YIELDS");
+
+  double dInitialTime = 1.;
+
+  auto uDF = getDiscount(dInitialTime);
+  double dR = (1 / uDF.second.front() - 1.) / (uDF.first.front() - dInitialTime);
+  print(dR, "initial short-term rate", true);
+  double dInterval = uDF.first.back() - dInitialTime;
+
+  print("natural spline:");
+  std::function<double(double)> uNatural =
+      vega::discountYieldSpline(uDF.first, uDF.second, dR, dInitialTime);
+  test::print(uNatural, dInitialTime, dInterval);
+  print(NSpline::repricing(uNatural, uDF.first, uDF.second),
+        "maximal error at market maturities", true);
+
+  print("clamped spline with flat ends:");
+  vega::DiscountYieldSpline uClamped(uDF.first, uDF.second, dR, dInitialTime, 0., 0.);
+  test::print(uClamped, dInitialTime, dInterval);
+  print(NSpline::repricing(uClamped, uDF.first, uDF.second),
+        "maximal error at market maturities", true);
+
+  print("yields of the clamped spline:");
+  test::print([&uClamped](double dT)
+              { return uClamped.yield(dT); },
+              dInitialTime, dInterval);
+}
+
+void discountMonotoneConvex()
+{
+  print("DISCOUNT CURVE BY MONOTONE CONVEX INTERPOLATION OF FORWARDS");
+
+  double dInitialTime = 1.;
+
+  auto uDF = getDiscount(dInitialTime);
+  double dInterval = uDF.first.back() - dInitialTime;
+
+  vega::DiscountMonotoneConvex uDiscount(uDF.first, uDF.second, dInitialTime);
+  test::print(uDiscount, dInitialTime, dInterval);
+  print(NSpline::repricing(uDiscount, uDF.first, uDF.second),
+        "maximal error at market maturities", true);
+
+  print("forward rates:");
+  test::print([&uDiscount](double dT)
+              { return uDiscount.forward(dT); },
+              dInitialTime, dInterval);
+
+  // the forward curve is continuous at the market maturities
+  double dJump = 0.;
+  for (unsigned i = 0; i + 1 < uDF.first.size(); i++)
+  {
+    double dT = uDF.first[i];
+    double dH = 1E-9 * (uDF.first[i + 1] - dT);
+    dJump = std::max(dJump, std::abs(uDiscount.forward(dT + dH) - uDiscount.forward(dT)));
+  }
+  print(dJump, "maximal jump of forward rates at market maturities", true);
+}
+
+void speed()
+{
+  print("SPEED OF INTERPOLATION OF DISCOUNT FACTORS");
+
+  double dInitialTime = 1.;
+  unsigned iPoints = 100000;
+  auto uDF = getDiscount(dInitialTime);
+  double dR = (1 / uDF.second.front() - 1.) / (uDF.first.front() - dInitialTime);
+  unsigned iKnots = uDF.first.size();
+
+  // increasing maturities as in the pricing of a schedule
+  std::valarray<double> uRand = getRandArg(dInitialTime, uDF.first.back(), iPoints);
+  std::vector<double> uT(std::begin(uRand), std::end(uRand));
+  std::sort(uT.begin(), uT.end());
+  print(iPoints, "increasing maturities", true);
+
+  vega::DiscountYieldSpline uSpline(uDF.first, uDF.second, dR, dInitialTime);
+  vega::DiscountMonotoneConvex uConvex(uDF.first, uDF.second, dInitialTime);
+  print(NSpline::batch(uSpline, uT), "cubic spline: batch versus scalar");
+  print(NSpline::batch(uConvex, uT), "monotone convex: batch versus scalar", true);
+
+  std::vector<Measurement> uTimes;
+  uTimes.push_back(NSpline::scalar(vega::discountYieldLinInterp(uDF.first, uDF.second, dR, dInitialTime),
+                                   uT, "discountYieldLinInterp", iKnots));
+  uTimes.push_back(NSpline::scalar(vega::discountLogLinInterp(uDF.first, uDF.second, dInitialTime),
+                                   uT, "discountLogLinInterp", iKnots));
+  uTimes.push_back(NSpline::scalar(vega::discountYieldSpline(uDF.first, uDF.second, dR, dInitialTime),
+                                   uT, "discountYieldSpline", iKnots));
+  uTimes.push_back(NSpline::batchTime(uSpline, uT, "discountYieldSpline", iKnots));
+  uTimes.push_back(NSpline::scalar(vega::discountMonotoneConvex(uDF.first, uDF.second, dInitialTime),
+                                   uT, "discountMonotoneConvex", iKnots));
+  uTimes.push_back(NSpline::batchTime(uConvex, uT, "discountMonotoneConvex", iKnots));
+  // the times depend on the machine
+  std::vector<std::string> uCurves = {"discountYieldLinInterp", "discountLogLinInterp",
+                                     "discountYieldSpline", "discountMonotoneConvex"};
+  for (const std::string &sCurve : uCurves)
+  {
+    std::vector<Measurement> uCurve;
+    std::copy_if(uTimes.begin(), uTimes.end(), std::back_inserter(uCurve),
+                 [&sCurve](const Measurement &rM)
+                 { return rM.curve == sCurve; });
+    printBench(uCurve, sCurve + ": scalar" + ((uCurve.size() > 1) ? " and batch" : ""));
+  }
+}
+
+std::function<void()> test_spline()
+{
+  return []()
+  {
+    print("SMOOTH INTERPOLATION OF DISCOUNT FACTORS");
+
+    discountYieldSpline();
+    discountMonotoneConvex();
+    speed();
+  };
+}
+
+int main()
+{
+  project(test_spline(), PROJECT_NAME, PROJECT_NAME,
+          "Cubic spline and monotone convex interpolation");
+}
@@ -0,0 +1,265 @@
+#ifndef __vega_spline_hpp__
+#define __vega_spline_hpp__
+
+/**
+ * @file spline.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Smooth interpolation of market discount factors
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaSpline Smooth interpolation of discount factors.
+   *
+   * This module constructs discount curves with smooth forward rates
+   * from market discount factors \f$d_i\f$ at maturities
+   * \f$t_0<t_1<\dots<t_M\f$. The coefficients of the interpolation
+   * are computed once at construction and stored per segment
+   * \f$[t_{i-1},t_i]\f$, so a value costs one binary search, a few
+   * multiplications and one exponential. Every curve has a scalar
+   * path, which evaluates one time, and a batch path, which
+   * evaluates many times: for increasing times the segments are found
+   * by a linear walk instead of binary searches and the exponentials
+   * are computed in a separate vectorized loop.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The discount curve obtained by the cubic spline
+   * interpolation of market yields.
+   *
+   * The yields \f$\gamma_i = -\frac{\log d_i}{t_i-t_0}\f$ at the
+   * market maturities and the initial short-term rate
+   * \f$\gamma_0=r\f$ are interpolated by the cubic spline
+   * \f$\gamma(t)\f$ with continuous second derivative, and
+   * \f[
+   *   d(t) = e^{-\gamma(t)(t-t_0)}, \quad t_0\leq t\leq t_M.
+   * \f]
+   * The natural spline has \f$\gamma''(t_0)=\gamma''(t_M)=0\f$; the
+   * clamped spline has given slopes \f$\gamma'(t_0)\f$ and
+   * \f$\gamma'(t_M)\f$. The second derivatives at the knots are
+   * solved at construction from a tridiagonal system by GSL.
+   */
+  class DiscountYieldSpline
+  {
+  public:
+    /**
+     * Constructs the discount curve for the natural spline of yields.
+     *
+     * @param rTimes The maturities of market discount factors.
+     * @param rDF The market discount factors.
+     * @param dR The initial short-term interest rate.
+     * @param dInitialTime The initial time.
+     */
+    DiscountYieldSpline(const std::vector<double> &rTimes,
+                        const std::vector<double> &rDF,
+                        double dR, double dInitialTime);
+
+    /**
+     * Constructs the discount curve for the clamped spline of yields.
+     *
+     * @param rTimes The maturities of market discount factors.
+     * @param rDF The market discount factors.
+     * @param dR The initial short-term interest rate.
+     * @param dInitialTime The initial time.
+     * @param dFirstSlope The slope \f$\gamma'(t_0)\f$ of the yield
+     * curve at the initial time.
+     * @param dLastSlope The slope \f$\gamma'(t_M)\f$ of the yield
+     * curve at the last maturity.
+     */
+    DiscountYieldSpline(const std::vector<double> &rTimes,
+                        const std::vector<double> &rDF,
+                        double dR, double dInitialTime,
+                        double dFirstSlope, double dLastSlope);
+
+    /**
+     * Computes the discount factor.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The discount factor for \p dT.
+     */
+    double operator()(double dT) const;
+
+    /**
+     * Computes the discount factors for many maturities. The
+     * maturities are best given in increasing order.
+     *
+     * @param pT The array of maturities, \f$t_0\leq t\leq t_M\f$.
+     * @param iSize The number of maturities.
+     * @param pDiscount The output array of discount factors of size
+     * \p iSize.
+     */
+    void operator()(const double *pT, std::size_t iSize, double *pDiscount) const;
+
+    /**
+     * Computes the discount factors for many maturities.
+     *
+     * @param rT The maturities, \f$t_0\leq t\leq t_M\f$.
+     * @return The discount factors.
+     */
+    std::vector<double> operator()(const std::vector<double> &rT) const;
+
+    /**
+     * Computes the yield.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The value \f$\gamma(t)\f$ of the spline.
+     */
+    double yield(double dT) const;
+
+  private:
+    void solve(const std::vector<double> &rYields, bool bClamped,
+               double dFirstSlope, double dLastSlope);
+    double exponent(double dT, unsigned iI) const;
+
+    /** The initial time followed by the market maturities. */
+    std::vector<double> m_uTimes;
+    /** The coefficients a, b, c, d of the cubic a + bh + ch^2 + dh^3 on every segment. */
+    std::vector<double> m_uCoeff;
+  };
+
+  /**
+   * @brief The discount curve obtained by the monotone convex
+   * interpolation of forward rates of Hagan and West.
+   *
+   * The discrete forward rates
+   * \f[
+   *   f^d_i = \frac{\log d_{i-1} - \log d_i}{t_i - t_{i-1}}, \quad
+   *   d_0 = 1,
+   * \f]
+   * are assigned to the segments and the instantaneous forward rates
+   * \f$f_i\f$ at the knots are their weighted averages. On every
+   * segment the forward rate is \f$f(t) = f^d_i + g(x)\f$,
+   * \f$x=\frac{t-t_{i-1}}{t_i-t_{i-1}}\f$, where \f$g\f$ is the
+   * quadratic or the piecewise quadratic function of Hagan and West
+   * with \f$g(0)=f_{i-1}-f^d_i\f$, \f$g(1)=f_i-f^d_i\f$ and
+   * \f$\int_0^1 g(x)\,dx = 0\f$. The curve reproduces the market
+   * discount factors, the forward curve is continuous and it stays
+   * monotone on the segments where the discrete forwards are
+   * monotone. The forward rates are not forced to be positive.
+   *
+   * No system is solved: the functions \f$g\f$ and the values
+   * \f$\log d_i\f$ are computed at construction.
+   */
+  class DiscountMonotoneConvex
+  {
+  public:
+    /**
+     * Constructs the discount curve.
+     *
+     * @param rTimes The maturities of market discount factors.
+     * @param rDF The market discount factors.
+     * @param dInitialTime The initial time.
+     */
+    DiscountMonotoneConvex(const std::vector<double> &rTimes,
+                           const std::vector<double> &rDF,
+                           double dInitialTime);
+
+    /**
+     * Computes the discount factor.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The discount factor for \p dT.
+     */
+    double operator()(double dT) const;
+
+    /**
+     * Computes the discount factors for many maturities. The
+     * maturities are best given in increasing order.
+     *
+     * @param pT The array of maturities, \f$t_0\leq t\leq t_M\f$.
+     * @param iSize The number of maturities.
+     * @param pDiscount The output array of discount factors of size
+     * \p iSize.
+     */
+    void operator()(const double *pT, std::size_t iSize, double *pDiscount) const;
+
+    /**
+     * Computes the discount factors for many maturities.
+     *
+     * @param rT The maturities, \f$t_0\leq t\leq t_M\f$.
+     * @return The discount factors.
+     */
+    std::vector<double> operator()(const std::vector<double> &rT) const;
+
+    /**
+     * Computes the instantaneous forward rate.
+     *
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The forward rate \f$f(t)\f$.
+     */
+    double forward(double dT) const;
+
+  private:
+    /** The function g on a segment. */
+    class Segment
+    {
+    public:
+      /** The discrete forward rate and the length of the segment. */
+      double forward, length;
+      /** The value log d at the start of the segment. */
+      double logDF;
+      /** g(0) and g(1). */
+      double g0, g1;
+      /** The point of the change of the quadratic pieces; 0 for a single quadratic. */
+      double eta;
+      /** The level of g at eta. */
+      double level;
+      /** The single quadratic g0(1 - 4x + 3x^2) + g1(3x^2 - 2x). */
+      bool quadratic;
+    };
+
+    double exponent(double dT, unsigned iI) const;
+
+    /** The initial time followed by the market maturities. */
+    std::vector<double> m_uTimes;
+    std::vector<Segment> m_uSegments;
+  };
+
+  /**
+   * Computes the discount curve by the natural cubic spline
+   * interpolation of market yields, see DiscountYieldSpline.
+   *
+   * @param rTimes The maturities of market discount factors.
+   * @param rDF The market discount factors.
+   * @param dR The initial short-term interest rate.
+   * @param dInitialTime The initial time.
+   *
+   * @return The discount curve obtained from the market discount
+   * factors by the cubic spline interpolation of market yields.
+   */
+  std::function<double(double)>
+  discountYieldSpline(const std::vector<double> &rTimes,
+                      const std::vector<double> &rDF,
+                      double dR, double dInitialTime);
+
+  /**
+   * Computes the discount curve by the monotone convex interpolation
+   * of forward rates, see DiscountMonotoneConvex.
+   *
+   * @param rTimes The maturities of market discount factors.
+   * @param rDF The market discount factors.
+   * @param dInitialTime The initial time.
+   *
+   * @return The discount curve obtained from the market discount
+   * factors by the monotone convex interpolation of forward rates.
+   */
+  std::function<double(double)>
+  discountMonotoneConvex(const std::vector<double> &rTimes,
+                         const std::vector<double> &rDF,
+                         double dInitialTime);
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_spline_hpp__
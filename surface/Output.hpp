@@ -0,0 +1,11 @@
+#ifndef __surface_Output_hpp__
+#define __surface_Output_hpp__
+
+#include "test/Output.hpp"
+
+namespace test
+{
+#define PROJECT_NAME "surface"
+} // namespace test
+
+#endif // of __surface_Output_hpp
@@ -0,0 +1,139 @@
+#include "test/Main.hpp"
+#include "test/Data.hpp"
+#include "test/Print.hpp"
+#include "test/Bench.hpp"
+#include "surface/Output.hpp"
+#include "surface/surface.hpp"
+
+using namespace test;
+using namespace std;
+
+namespace NSurface
+{
+  const double c_dSpot = 100.;
+
+  // the strikes from 60 to 140
+  std::vector<double> strikes()
+  {
+    return getTimes(50., 140., 9);
+  }
+
+  // the market volatilities: the term structure of getVol() times a smile
+  std::vector<double> vols(const std::vector<double> &rStrikes, const std::vector<double> &rTermVols)
+  {
+    std::vector<double> uVols;
+    for (double dVol : rTermVols)
+    {
+      for (double dK : rStrikes)
+      {
+        double dM = std::log(dK / c_dSpot);
+        uVols.push_back(dVol * (1. - 0.5 * dM + 2. * dM * dM));
+      }
+    }
+    return uVols;
+  }
+} // namespace NSurface
+
+void surface()
+{
+  print("IMPLIED VOLATILITY SURFACE");
+
+  double dInitialTime = 1.;
+  auto uVol = getVol(dInitialTime);
+  std::vector<double> uStrikes = NSurface::strikes();
+  std::vector<double> uVols = NSurface::vols(uStrikes, uVol.second);
+  print(uStrikes.begin(), uStrikes.end(), "strikes");
+
+  for (vega::Smile eSmile : {vega::Smile::strike, vega::Smile::logStrike})
+  {
+    vega::VolatilitySurface uSurface(uStrikes, uVol.first, uVols, dInitialTime, eSmile);
+    print((eSmile == vega::Smile::strike) ? "linear variance in strike:"
+                                          : "linear variance in log-strike:");
+
+    double dError = 0.;
+    for (unsigned i = 0; i < uVol.first.size(); i++)
+    {
+      for (unsigned j = 0; j < uStrikes.size(); j++)
+      {
+        double dVol = uVols[i * uStrikes.size() + j];
+        dError = std::max(dError, std::abs(uSurface(uStrikes[j], uVol.first[i]) - dVol));
+      }
+    }
+    print(dError, "maximal error at market quotes", true);
+
+    double dMaturity = 0.5 * (uVol.first[2] + uVol.first[3]);
+    print(dMaturity, "smile at maturity");
+    test::print([&uSurface, dMaturity](double dK)
+                { return uSurface(dK, dMaturity); },
+                50., 100.);
+  }
+
+  vega::VolatilitySurface uSurface(uStrikes, uVol.first, uVols, dInitialTime);
+  print(NSurface::c_dSpot, "term structure at strike");
+  test::print(uSurface.term(NSurface::c_dSpot), dInitialTime, uVol.first.back() - dInitialTime);
+}
+
+void batchLookups()
+{
+  print("BATCH LOOKUPS IN THE SURFACE");
+
+  double dInitialTime = 1.;
+  unsigned iPoints = 1000000;
+  auto uVol = getVol(dInitialTime);
+  std::vector<double> uStrikes = NSurface::strikes();
+  std::vector<double> uVols = NSurface::vols(uStrikes, uVol.second);
+  print(iPoints, "random points", true);
+
+  std::valarray<double> uRandK = getRandArg(50., 150., iPoints);
+  std::valarray<double> uRandT = getRandArg(dInitialTime, uVol.first.back(), iPoints);
+  std::vector<double> uK(std::begin(uRandK), std::end(uRandK));
+  std::vector<double> uT(std::begin(uRandT), std::end(uRandT));
+  unsigned iKnots = uStrikes.size() * uVol.first.size();
+
+  for (vega::Smile eSmile : {vega::Smile::strike, vega::Smile::logStrike})
+  {
+    std::string sSmile = (eSmile == vega::Smile::strike) ? "strike" : "log-strike";
+    vega::VolatilitySurface uSurface(uStrikes, uVol.first, uVols, dInitialTime, eSmile);
+
+    std::vector<double> uBatch = uSurface(uK, uT);
+    double dDifference = 0.;
+    for (unsigned p = 0; p < iPoints; p++)
+    {
+      dDifference = std::max(dDifference, std::abs(uBatch[p] - uSurface(uK[p], uT[p])));
+    }
+    print(dDifference, "batch versus scalar, smile in " + sSmile);
+
+    std::vector<Measurement> uTimes;
+    double dSum = 0.;
+    uTimes.push_back(measure([&uSurface, &uK, &uT, &dSum]()
+                             {
+                               for (unsigned p = 0; p < uK.size(); p++)
+                               {
+                                 dSum += uSurface(uK[p], uT[p]);
+                               } },
+                             sSmile, "scalar", iKnots, iPoints));
+    uTimes.push_back(measure([&uSurface, &uK, &uT, &uBatch]()
+                             { uSurface(uK.data(), uT.data(), uK.size(), uBatch.data()); },
+                             sSmile, "batch", iKnots, iPoints));
+    keepAlive(dSum);
+    // the times depend on the machine
+    printBench(uTimes, "scalar and batch lookups, smile in " + sSmile);
+  }
+}
+
+std::function<void()> test_surface()
+{
+  return []()
+  {
+    print("VOLATILITY SURFACES IN STRIKE AND MATURITY");
+
+    surface();
+    batchLookups();
+  };
+}
+
+int main()
+{
+  project(test_surface(), PROJECT_NAME, PROJECT_NAME,
+          "Implied volatility surface");
+}
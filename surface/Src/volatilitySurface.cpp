@@ -0,0 +1,184 @@
+#include "surface/surface.hpp"
+#include "prep1/prep1.hpp"
+#include "vega/trace.hpp"
+#include <cfloat>
+
+namespace volatilitySurface
+{
+  // the points of a batch that are processed together; their data
+  // stays in the L1 cache
+  const std::size_t c_iChunk = 256;
+}
+
+vega::VolatilitySurface::VolatilitySurface(const std::vector<double> &rStrikes,
+                                           const std::vector<double> &rTimes,
+                                           const std::vector<double> &rVols,
+                                           double dInitialTime, Smile eSmile)
+    : m_uTimes(1, dInitialTime), m_eSmile(eSmile)
+{
+  PRECONDITION(rStrikes.size() >= 2);
+  PRECONDITION(!rTimes.empty());
+  PRECONDITION(rVols.size() == rStrikes.size() * rTimes.size());
+  PRECONDITION(rTimes.front() > dInitialTime);
+  PRECONDITION(std::is_sorted(rTimes.begin(), rTimes.end(), std::less_equal<double>()));
+  PRECONDITION(std::is_sorted(rStrikes.begin(), rStrikes.end(), std::less_equal<double>()));
+  PRECONDITION(eSmile == Smile::strike || rStrikes.front() > 0);
+
+  m_uTimes.insert(m_uTimes.end(), rTimes.begin(), rTimes.end());
+  for (double dK : rStrikes)
+  {
+    m_uX.push_back(variable(dK));
+  }
+
+  // the total variances at the maturities, the first row is t_0
+  unsigned iN = m_uX.size();
+  unsigned iM = rTimes.size();
+  std::vector<double> uV((iM + 1) * iN, 0.);
+  for (unsigned i = 1; i <= iM; i++)
+  {
+    for (unsigned j = 0; j < iN; j++)
+    {
+      double dVol = rVols[(i - 1) * iN + j];
+      uV[i * iN + j] = dVol * dVol * (m_uTimes[i] - dInitialTime);
+    }
+  }
+
+  // on the cell, V(x, t) = V_a(x) + alpha(x)(t - t_a) is linear in t and
+  // Sigma^2 = V / (t - t_0) = alpha(x) + (V_a(x) - alpha(x)(t_a - t_0)) / (t - t_0)
+  m_uCells.resize(4 * iM * (iN - 1));
+  double *pCell = m_uCells.data();
+  for (unsigned i = 0; i < iM; i++)
+  {
+    double dLength = m_uTimes[i + 1] - m_uTimes[i];
+    double dElapsed = m_uTimes[i] - dInitialTime;
+    const double *pV0 = uV.data() + i * iN;
+    const double *pV1 = pV0 + iN;
+    for (unsigned j = 0; j + 1 < iN; j++)
+    {
+      // V_a(x) = p0 + q0 x and V_b(x) = p1 + q1 x on [x_j, x_{j+1}]
+      double dWidth = m_uX[j + 1] - m_uX[j];
+      double dQ0 = (pV0[j + 1] - pV0[j]) / dWidth;
+      double dP0 = pV0[j] - dQ0 * m_uX[j];
+      double dQ1 = (pV1[j + 1] - pV1[j]) / dWidth;
+      double dP1 = pV1[j] - dQ1 * m_uX[j];
+
+      double dA = (dP1 - dP0) / dLength;
+      double dB = (dQ1 - dQ0) / dLength;
+      pCell[0] = dA;
+      pCell[1] = dB;
+      pCell[2] = dP0 - dA * dElapsed;
+      pCell[3] = dQ0 - dB * dElapsed;
+      pCell += 4;
+    }
+  }
+}
+
+double vega::VolatilitySurface::variable(double dK) const
+{
+  return (m_eSmile == Smile::logStrike) ? std::log(dK) : dK;
+}
+
+double vega::VolatilitySurface::operator()(double dK, double dT) const
+{
+  PRECONDITION(dT >= m_uTimes.front());
+  PRECONDITION(dT <= m_uTimes.back());
+
+  double dX = std::min(std::max(variable(dK), m_uX.front()), m_uX.back());
+  unsigned iJ = std::lower_bound(m_uX.begin() + 1, m_uX.end() - 1, dX) - m_uX.begin() - 1;
+  unsigned iI = std::lower_bound(m_uTimes.begin() + 1, m_uTimes.end() - 1, dT) - m_uTimes.begin() - 1;
+  const double *pCell = m_uCells.data() + 4 * (iI * (m_uX.size() - 1) + iJ);
+  double dInverse = 1. / std::max(dT - m_uTimes.front(), DBL_MIN);
+  return std::sqrt(pCell[0] + pCell[1] * dX + (pCell[2] + pCell[3] * dX) * dInverse);
+}
+
+void vega::VolatilitySurface::operator()(const double *pK, const double *pT, std::size_t iSize,
+                                         double *pVol) const
+{
+  PRECONDITION(std::all_of(pT, pT + iSize, [this](double dT)
+                           { return dT >= m_uTimes.front() && dT <= m_uTimes.back(); }));
+
+  double dInitialTime = m_uTimes.front();
+  double dFirst = m_uX.front();
+  double dLast = m_uX.back();
+  std::size_t iCells = m_uX.size() - 1;
+  const double *pX = m_uX.data();
+  const double *pTimes = m_uTimes.data();
+
+  double uX[volatilitySurface::c_iChunk];
+  double uInverse[volatilitySurface::c_iChunk];
+  // the indices of cells are counted in doubles, which SSE2 compares
+  // and adds in the same registers
+  double uJ[volatilitySurface::c_iChunk];
+  double uI[volatilitySurface::c_iChunk];
+  for (std::size_t iStart = 0; iStart < iSize; iStart += volatilitySurface::c_iChunk)
+  {
+    std::size_t iChunk = std::min(volatilitySurface::c_iChunk, iSize - iStart);
+    const double *pChunkK = pK + iStart;
+    const double *pChunkT = pT + iStart;
+    double *pChunkVol = pVol + iStart;
+
+    if (m_eSmile == Smile::logStrike)
+    {
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uX[p] = std::log(pChunkK[p]);
+      }
+    }
+    else
+    {
+      std::copy(pChunkK, pChunkK + iChunk, uX);
+    }
+    for (std::size_t p = 0; p < iChunk; p++)
+    {
+      uX[p] = std::min(std::max(uX[p], dFirst), dLast);
+      uInverse[p] = 1. / std::max(pChunkT[p] - dInitialTime, DBL_MIN);
+      uJ[p] = 0.;
+      uI[p] = 0.;
+    }
+
+    // the cell of a point is the number of interior knots below it
+    for (std::size_t k = 1; k < iCells; k++)
+    {
+      double dKnot = pX[k];
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uJ[p] += (uX[p] > dKnot) ? 1. : 0.;
+      }
+    }
+    for (std::size_t k = 1; k + 1 < m_uTimes.size(); k++)
+    {
+      double dKnot = pTimes[k];
+      for (std::size_t p = 0; p < iChunk; p++)
+      {
+        uI[p] += (pChunkT[p] > dKnot) ? 1. : 0.;
+      }
+    }
+
+    for (std::size_t p = 0; p < iChunk; p++)
+    {
+      const double *pCell = m_uCells.data() + 4 * (std::size_t(uI[p]) * iCells + std::size_t(uJ[p]));
+      pChunkVol[p] = pCell[0] + pCell[1] * uX[p] + (pCell[2] + pCell[3] * uX[p]) * uInverse[p];
+    }
+    for (std::size_t p = 0; p < iChunk; p++)
+    {
+      pChunkVol[p] = std::sqrt(pChunkVol[p]);
+    }
+  }
+}
+
+std::vector<double> vega::VolatilitySurface::operator()(const std::vector<double> &rK,
+                                                        const std::vector<double> &rT) const
+{
+  PRECONDITION(rK.size() == rT.size());
+
+  std::vector<double> uVol(rK.size());
+  (*this)(rK.data(), rT.data(), rK.size(), uVol.data());
+  return uVol;
+}
+
+std::function<double(double)> vega::VolatilitySurface::term(double dK) const
+{
+  VolatilitySurface uSurface(*this);
+  return VEGA_TRACE_CURVE("volatilitySurface", [uSurface, dK](double dT)
+                          { return uSurface(dK, dT); });
+}
@@ -0,0 +1,142 @@
+#ifndef __vega_surface_hpp__
+#define __vega_surface_hpp__
+
+/**
+ * @file surface.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Implied volatility surfaces in strike and maturity
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <vector>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaSurface Implied volatility surfaces.
+   *
+   * This module extends volatilityVarLinInterp() from maturities to
+   * strikes and maturities.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The variable in which the total variance of a smile is
+   * interpolated linearly.
+   */
+  enum class Smile
+  {
+    /** The strike \f$K\f$. */
+    strike,
+    /** The logarithm of the strike \f$\log K\f$. */
+    logStrike
+  };
+
+  /**
+   * @brief The implied volatility surface obtained by the linear
+   * interpolation of total variances in maturity and in strike.
+   *
+   * The market volatilities \f$\Sigma_{i,j}\f$ are given on the grid
+   * of maturities \f$t_0<t_1<\dots<t_M\f$ and strikes
+   * \f$K_1<\dots<K_N\f$. As in volatilityVarLinInterp(), the total
+   * variance
+   * \f[
+   *   V(K,t) = \Sigma^2(K,t)(t - t_0), \quad V(K,t_0) = 0,
+   * \f]
+   * is linear in \f$t\f$ between the maturities, so the volatility
+   * is constant on \f$[t_0,t_1]\f$. At every maturity \f$V\f$ is
+   * linear in the variable of Smile between the strikes and flat
+   * outside \f$[K_1,K_N]\f$.
+   *
+   * On the cell \f$[x_{j-1},x_j]\times[t_{i-1},t_i]\f$, where
+   * \f$x\f$ is the variable of the smile, the squared volatility has
+   * the form
+   * \f[
+   *   \Sigma^2(x,t) = a + b x + \frac{c + d x}{t-t_0},
+   * \f]
+   * and the four coefficients of every cell are computed at
+   * construction and stored contiguously. The batch evaluation finds
+   * the cells by counting the knots below the points in loops over
+   * the points, without branches, and computes the volatilities in
+   * vectorized loops.
+   */
+  class VolatilitySurface
+  {
+  public:
+    /**
+     * Constructs the surface.
+     *
+     * @param rStrikes \f$(K_j)_{j=1,\dots,N}\f$ The increasing strikes
+     * of the market volatilities, \f$N\geq 2\f$.
+     * @param rTimes \f$(t_i)_{i=1,\dots,M}\f$ The increasing maturities
+     * of the market volatilities, \f$t_1>t_0\f$.
+     * @param rVols The row-major \f$M\times N\f$ matrix of market
+     * volatilities \f$\Sigma_{i,j}\f$ with one row per maturity.
+     * @param dInitialTime \f$t_0\f$ The initial time.
+     * @param eSmile The variable of the interpolation in strike.
+     */
+    VolatilitySurface(const std::vector<double> &rStrikes,
+                      const std::vector<double> &rTimes,
+                      const std::vector<double> &rVols,
+                      double dInitialTime, Smile eSmile = Smile::strike);
+
+    /**
+     * Computes the implied volatility.
+     *
+     * @param dK The strike.
+     * @param dT The maturity, \f$t_0\leq t\leq t_M\f$.
+     * @return The volatility \f$\Sigma(K,t)\f$.
+     */
+    double operator()(double dK, double dT) const;
+
+    /**
+     * Computes the implied volatilities at many points.
+     *
+     * @param pK The array of strikes.
+     * @param pT The array of maturities, \f$t_0\leq t\leq t_M\f$.
+     * @param iSize The number of points.
+     * @param pVol The output array of volatilities of size \p iSize.
+     */
+    void operator()(const double *pK, const double *pT, std::size_t iSize,
+                    double *pVol) const;
+
+    /**
+     * Computes the implied volatilities at many points.
+     *
+     * @param rK The strikes.
+     * @param rT The maturities of the same size.
+     * @return The volatilities.
+     */
+    std::vector<double> operator()(const std::vector<double> &rK,
+                                   const std::vector<double> &rT) const;
+
+    /**
+     * Returns the volatility curve in maturity for a fixed strike.
+     *
+     * @param dK The strike.
+     * @return The volatility curve \f$t\mapsto\Sigma(K,t)\f$.
+     */
+    std::function<double(double)> term(double dK) const;
+
+  private:
+    double variable(double dK) const;
+
+    /** The variables of the smile at the strikes. */
+    std::vector<double> m_uX;
+    /** The initial time followed by the market maturities. */
+    std::vector<double> m_uTimes;
+    /** The coefficients a, b, c, d of the cells; the cells of a maturity are contiguous. */
+    std::vector<double> m_uCells;
+    Smile m_eSmile;
+  };
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_surface_hpp__
@@ -0,0 +1,43 @@
+#ifndef __test_all_Allocations_hpp__
+#define __test_all_Allocations_hpp__
+
+/**
+ * @file Allocations.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Counting of heap allocations.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstddef>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Allocations Counting of heap allocations.
+   *
+   * This module replaces the global operator new by a version that
+   * counts the calls. The replacement is not a part of the library
+   * test_all: it is the object library test_allocations, which a
+   * program links explicitly if it calls allocations(). The other
+   * programs keep the default allocator.
+   *
+   * @{
+   */
+
+  /**
+   * Returns the number of calls of the global operator new since the
+   * start of the program, in all threads.
+   *
+   * @return The number of heap allocations.
+   */
+  std::size_t allocations();
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Allocations_hpp__
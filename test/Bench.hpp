@@ -0,0 +1,247 @@
+#ifndef __test_all_Bench_hpp__
+#define __test_all_Bench_hpp__
+
+/**
+ * @file Bench.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Performance measurements of curves.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "test/Print.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Bench Benchmarks of curves.
+   *
+   * This module contains functions for measuring the speed of
+   * construction and evaluation of curves.
+   *
+   * @{
+   */
+
+  /**
+   * @brief Hardware performance counters. A counter that is not
+   * available has the value NaN.
+   */
+  class Counters
+  {
+  public:
+    /**
+     * CPU cycles.
+     */
+    double cycles;
+
+    /**
+     * Retired instructions.
+     */
+    double instructions;
+
+    /**
+     * Mispredicted branches.
+     */
+    double branchMisses;
+
+    /**
+     * Read misses of the L1 data cache.
+     */
+    double l1Misses;
+
+    /**
+     * Misses of the last level cache.
+     */
+    double llcMisses;
+
+    /**
+     * Returns true if at least one counter is available.
+     *
+     * @return true if some counter is not NaN.
+     */
+    bool available() const;
+
+    /**
+     * Returns the counters divided by \p dN.
+     *
+     * @param dN The number of operations.
+     * @return The counters per operation.
+     */
+    Counters per(double dN) const;
+  };
+
+  /**
+   * @brief The group of hardware performance counters of the calling
+   * thread opened by perf_event_open (Linux). The counters that are
+   * not permitted (for example, by kernel.perf_event_paranoid or in a
+   * container) are silently skipped; if none is permitted, the
+   * measurements return NaN.
+   */
+  class PerfCounters
+  {
+  public:
+    /**
+     * Opens the counters. They count only the user space of the
+     * calling thread.
+     */
+    PerfCounters();
+
+    /**
+     * Closes the counters.
+     */
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     * Resets and starts the counters.
+     */
+    void start();
+
+    /**
+     * Stops the counters.
+     *
+     * @return The values of the counters since the last start().
+     * The values are scaled if the kernel multiplexes the counters.
+     */
+    Counters stop();
+
+  private:
+    /** The file descriptors of the counters in the order of Counters; -1
+     * for the counters that are not available. */
+    std::vector<int> m_uFd;
+  };
+
+  /**
+   * @brief The result of one benchmark.
+   */
+  class Measurement
+  {
+  public:
+    /**
+     * The name of the curve.
+     */
+    std::string curve;
+
+    /**
+     * The kind of measurement ("construction", "latency", "throughput").
+     */
+    std::string kind;
+
+    /**
+     * The number of knots (market quotes, payments) of the curve, or
+     * 0 for parametric curves.
+     */
+    unsigned knots;
+
+    /**
+     * The number of operations (constructions or evaluated points) in
+     * one run.
+     */
+    unsigned long points;
+
+    /**
+     * The number of runs.
+     */
+    unsigned long repeats;
+
+    /**
+     * The total wall-clock time in seconds.
+     */
+    double seconds;
+
+    /**
+     * The hardware counters for all runs.
+     */
+    Counters counters;
+
+    /**
+     * Returns the average time of one operation in nanoseconds.
+     *
+     * @return The time per constructed curve or evaluated point.
+     */
+    double nanoseconds() const;
+
+    /**
+     * Returns the average hardware counters of one operation.
+     *
+     * @return The counters per constructed curve or evaluated point.
+     */
+    Counters perPoint() const;
+  };
+
+  /**
+   * Returns the wall-clock time in seconds from an arbitrary origin.
+   *
+   * @return The value of a steady clock in seconds.
+   */
+  double seconds();
+
+  /**
+   * Measures the time and the hardware counters of a run. The run is
+   * repeated until the total time exceeds \p dMinTime.
+   *
+   * @param rRun The function that performs \p iPoints operations.
+   * @param sCurve The name of the curve.
+   * @param sKind The kind of measurement.
+   * @param iKnots The number of knots of the curve.
+   * @param iPoints The number of operations in one run.
+   * @param dMinTime The minimal total time in seconds.
+   * @return The result of the benchmark.
+   */
+  Measurement measure(const std::function<void()> &rRun,
+                      const std::string &sCurve, const std::string &sKind,
+                      unsigned iKnots, unsigned long iPoints,
+                      double dMinTime = 0.05);
+
+  /**
+   * Stores the result of evaluations in a volatile variable of the
+   * calling thread, so the optimizer can not remove the evaluations.
+   * Call it with the result of the measured run instead of adding
+   * the result to the measurement.
+   *
+   * @param dValue The result of evaluations.
+   */
+  void keepAlive(double dValue);
+
+  /**
+   * Prints the table of results with columns "knots", "points" and
+   * "ns/point" followed by the hardware counters per point
+   * "cycles", "instr", "br-miss", "L1-miss" and "LLC-miss" if they
+   * are available.
+   *
+   * @param rResults The results of benchmarks.
+   * @param sTitle The title of the table.
+   */
+  void printBench(const std::vector<Measurement> &rResults,
+                  const std::string &sTitle);
+
+  /**
+   * Writes the results of benchmarks to a file in JSON format:
+   * \code
+   * {"benchmarks": [{"curve": ..., "kind": ..., "knots": ...,
+   *   "points": ..., "repeats": ..., "seconds": ...,
+   *   "ns_per_point": ..., "cycles_per_point": ...,
+   *   "instructions_per_point": ..., "branch_misses_per_point": ...,
+   *   "l1_misses_per_point": ..., "llc_misses_per_point": ...}, ...]}
+   * \endcode
+   * The counters that are not available are written as null.
+   *
+   * @param rResults The results of benchmarks.
+   * @param sFile The name of the output file.
+   */
+  void writeJson(const std::vector<Measurement> &rResults,
+                 const std::string &sFile);
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Bench_hpp__
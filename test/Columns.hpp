@@ -0,0 +1,201 @@
+#ifndef __test_all_Columns_hpp__
+#define __test_all_Columns_hpp__
+
+/**
+ * @file Columns.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Binary columnar files of tables.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <valarray>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Columns Binary columnar files.
+   *
+   * This module writes tables of doubles in a binary columnar format
+   * and reads them back through a memory map without copying. All
+   * integers and doubles are little-endian:
+   * \code
+   * offset 0   "VEGACOL\0"           magic
+   * offset 8   uint32 version        (1)
+   * offset 12  uint32 columns        M
+   * offset 16  uint64 rows           N
+   * offset 24  uint64 data offset    (multiple of 64)
+   * offset 32  M names: uint32 length followed by the characters
+   * data       M columns of N doubles; every column starts at a
+   *            multiple of 64 bytes
+   * \endcode
+   *
+   * @{
+   */
+
+  /**
+   * @brief The read-only view of a column of doubles.
+   */
+  class ColumnView
+  {
+  public:
+    /**
+     * Constructs the view.
+     *
+     * @param pData The first value.
+     * @param iSize The number of values.
+     */
+    ColumnView(const double *pData, std::size_t iSize);
+
+    /**
+     * Returns the pointer to the first value.
+     *
+     * @return The first value.
+     */
+    const double *data() const;
+
+    /**
+     * Returns the number of values.
+     *
+     * @return The size of the column.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the value in row \p i.
+     *
+     * @param i The index of the row.
+     * @return The value.
+     */
+    double operator[](std::size_t i) const;
+
+    /**
+     * Returns the iterator to the first value.
+     *
+     * @return The first value.
+     */
+    const double *begin() const;
+
+    /**
+     * Returns the iterator past the last value.
+     *
+     * @return The end of the column.
+     */
+    const double *end() const;
+
+    /**
+     * Copies the values into a vector, for example, when the view is
+     * passed to a builder of a curve. The conversion is explicit, so
+     * the allocation is visible at the call.
+     *
+     * @return The vector of values.
+     */
+    explicit operator std::vector<double>() const;
+
+  private:
+    const double *m_pData;
+    std::size_t m_iSize;
+  };
+
+  /**
+   * Writes the table to a binary columnar file. A failed write throws
+   * std::runtime_error.
+   *
+   * @param sFile The name of the file.
+   * @param rValues The vector of columns of the table; the columns
+   * have the same size.
+   * @param rNames The vector of titles of the columns.
+   */
+  void writeColumns(const std::string &sFile,
+                    const std::vector<std::valarray<double>> &rValues,
+                    const std::vector<std::string> &rNames);
+
+  /**
+   * Writes the table to a binary columnar file. A failed write throws
+   * std::runtime_error.
+   *
+   * @param sFile The name of the file.
+   * @param rValues The vector of columns of the table; the columns
+   * have the same size.
+   * @param rNames The vector of titles of the columns.
+   */
+  void writeColumns(const std::string &sFile,
+                    const std::vector<std::vector<double>> &rValues,
+                    const std::vector<std::string> &rNames);
+
+  /**
+   * @brief The binary columnar file mapped into memory. The views of
+   * columns point into the map and stay valid while the object
+   * exists.
+   */
+  class ColumnFile
+  {
+  public:
+    /**
+     * Maps the file into memory and reads the header. A file whose
+     * names or columns do not fit into its size throws
+     * std::runtime_error.
+     *
+     * @param sFile The name of the file written by writeColumns().
+     */
+    explicit ColumnFile(const std::string &sFile);
+
+    /**
+     * Unmaps the file.
+     */
+    ~ColumnFile();
+
+    ColumnFile(const ColumnFile &) = delete;
+    ColumnFile &operator=(const ColumnFile &) = delete;
+
+    /**
+     * Returns the number of rows.
+     *
+     * @return The size of every column.
+     */
+    std::size_t rows() const;
+
+    /**
+     * Returns the titles of the columns.
+     *
+     * @return The names of the columns.
+     */
+    const std::vector<std::string> &names() const;
+
+    /**
+     * Returns the column with index \p iColumn.
+     *
+     * @param iColumn The index of the column.
+     * @return The view of the column.
+     */
+    ColumnView column(unsigned iColumn) const;
+
+    /**
+     * Returns the column with the title \p sName. An unknown title
+     * throws std::runtime_error.
+     *
+     * @param sName The title of the column.
+     * @return The view of the column.
+     */
+    ColumnView column(const std::string &sName) const;
+
+  private:
+    const unsigned char *m_pMap;
+    std::size_t m_iBytes;
+    std::size_t m_iRows;
+    std::vector<std::string> m_uNames;
+    std::vector<std::uint64_t> m_uOffsets;
+  };
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Columns_hpp__
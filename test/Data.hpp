@@ -13,6 +13,7 @@
  */
 
 #include "test/Main.hpp"
+#include <functional>
 #include <string>
 
 namespace test
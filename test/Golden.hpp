@@ -0,0 +1,155 @@
+#ifndef __test_all_Golden_hpp__
+#define __test_all_Golden_hpp__
+
+/**
+ * @file Golden.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Regression tests against golden outputs.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "test/Print.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Golden Regression tests against golden outputs.
+   *
+   * This module replays testing functions, splits their output into
+   * sections and compares every section with the stored (golden)
+   * output: the numbers must agree within given tolerances and the
+   * running time must not exceed the stored baseline. The baselines
+   * are measured on the machine that records the golden output, so
+   * every baseline is multiplied by the median over the sections of
+   * the ratios of the running times to the baselines. This cancels
+   * the speed of the host and of the formatting of the output, which
+   * all sections share, and leaves the slowdown of a single section.
+   *
+   * A section starts at a title line, that is, a line printed by
+   * print(const std::string &) which contains a word of at least
+   * three capital letters, no lowercase letters and does not end
+   * with a colon.
+   *
+   * @{
+   */
+
+  /**
+   * @brief A section of the output of a testing function.
+   */
+  class Section
+  {
+  public:
+    /**
+     * The title line of the section.
+     */
+    std::string title;
+
+    /**
+     * The text of the section including the title line.
+     */
+    std::string text;
+
+    /**
+     * The running time of the section in seconds.
+     */
+    double seconds;
+  };
+
+  /**
+   * @brief The tolerances of the regression test.
+   */
+  class Tolerance
+  {
+  public:
+    /**
+     * The relative tolerance for numbers.
+     */
+    double relative = 1E-10;
+
+    /**
+     * The absolute tolerance for numbers.
+     */
+    double absolute = 1E-12;
+
+    /**
+     * The maximal ratio of the running time of a section to its
+     * baseline scaled by the median ratio over the sections.
+     */
+    double slowdown = 2.;
+
+    /**
+     * The additional time in seconds allowed for every section; it
+     * covers the resolution of the clock for the shortest sections,
+     * whose running time is averaged over many runs.
+     */
+    double noise = 1E-6;
+  };
+
+  /**
+   * Runs the testing function and splits its output into sections.
+   * Numbers are printed with 15 significant digits. After the first
+   * run, which warms up the caches, the function is run until the
+   * total time exceeds \p dMinTime. The runs are split into five
+   * batches of equal time and the running time of a section is the
+   * minimum over the batches of its average time in a batch. Thus,
+   * the sections that take microseconds are timed over milliseconds.
+   *
+   * @param rF The testing function.
+   * @param dMinTime The minimal total time of the timed runs in
+   * seconds.
+   * @return The sections of the output.
+   */
+  std::vector<Section> replay(const std::function<void()> &rF,
+                              double dMinTime = 0.2);
+
+  /**
+   * Writes the golden output: the text of the sections to the file
+   * \p sFile + ".txt" and their running times to the file
+   * \p sFile + ".time".
+   *
+   * @param rSections The sections of the output.
+   * @param sFile The name of the golden files without extension.
+   */
+  void writeGolden(const std::vector<Section> &rSections,
+                   const std::string &sFile);
+
+  /**
+   * Reads the golden output written by writeGolden().
+   *
+   * @param sFile The name of the golden files without extension.
+   * @return The sections of the golden output or an empty vector if
+   * a file can not be read or the running times do not match the
+   * sections.
+   */
+  std::vector<Section> readGolden(const std::string &sFile);
+
+  /**
+   * Compares the replayed output with the golden one section by
+   * section and prints the report: the maximal relative error of
+   * numbers, the running times, the baselines and the slowdowns
+   * relative to the scaled baselines. Words other than numbers must
+   * coincide.
+   *
+   * @param rGolden The golden output.
+   * @param rReplay The replayed output.
+   * @param rTolerance The tolerances.
+   * @param sTitle The title of the report.
+   * @return true if every section agrees with the golden output and
+   * is not slower than its baseline.
+   */
+  bool checkGolden(const std::vector<Section> &rGolden,
+                   const std::vector<Section> &rReplay,
+                   const Tolerance &rTolerance, const std::string &sTitle);
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Golden_hpp__
@@ -0,0 +1,177 @@
+#ifndef __test_all_Histogram_hpp__
+#define __test_all_Histogram_hpp__
+
+/**
+ * @file Histogram.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Latency histograms of curves.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "test/Print.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Histogram Latency histograms of curves.
+   *
+   * This module records the latencies of single calls of curves in
+   * histograms with logarithmic buckets (as in HdrHistogram): values
+   * below 32 ns are exact, larger values are kept with 5 significant
+   * bits, that is, with the relative error below 3.2%. Every thread
+   * records into its own Histogram; the histograms are merged into a
+   * SharedHistogram by atomic additions without locks.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The histogram of latencies in nanoseconds recorded by one
+   * thread.
+   */
+  class Histogram
+  {
+  public:
+    /**
+     * Constructs the empty histogram.
+     */
+    Histogram();
+
+    /**
+     * Records one value.
+     *
+     * @param iValue The latency in nanoseconds.
+     */
+    void record(unsigned long long iValue);
+
+    /**
+     * Adds the values of another histogram.
+     *
+     * @param rHistogram The histogram.
+     */
+    void merge(const Histogram &rHistogram);
+
+    /**
+     * Returns the number of recorded values.
+     *
+     * @return The number of values.
+     */
+    unsigned long long count() const;
+
+    /**
+     * Returns the largest recorded value.
+     *
+     * @return The exact maximum in nanoseconds.
+     */
+    unsigned long long max() const;
+
+    /**
+     * Returns the quantile of recorded values: the upper bound of the
+     * bucket that contains it.
+     *
+     * @param dP The level, \f$0<p\leq 1\f$, for example, 0.99.
+     * @return The quantile in nanoseconds.
+     */
+    unsigned long long quantile(double dP) const;
+
+    /**
+     * Returns the index of the bucket of a value.
+     *
+     * @param iValue The value.
+     * @return The index of the bucket.
+     */
+    static unsigned bucket(unsigned long long iValue);
+
+    /**
+     * Returns the largest value in the bucket.
+     *
+     * @param iBucket The index of the bucket.
+     * @return The upper bound of the bucket.
+     */
+    static unsigned long long upper(unsigned iBucket);
+
+    /**
+     * The number of buckets.
+     */
+    static const unsigned c_iBuckets;
+
+  private:
+    friend class SharedHistogram;
+    std::vector<unsigned long long> m_uCounts;
+    unsigned long long m_iMax;
+  };
+
+  /**
+   * @brief The histogram of latencies shared by threads. Thread-local
+   * histograms are added by atomic operations without locks.
+   */
+  class SharedHistogram
+  {
+  public:
+    /**
+     * Constructs the empty histogram.
+     */
+    SharedHistogram();
+
+    /**
+     * Adds the thread-local histogram. It can be called from many
+     * threads at the same time.
+     *
+     * @param rHistogram The histogram of one thread.
+     */
+    void merge(const Histogram &rHistogram);
+
+    /**
+     * Returns the copy of the current values.
+     *
+     * @return The histogram with all merged values.
+     */
+    Histogram histogram() const;
+
+  private:
+    std::unique_ptr<std::atomic<unsigned long long>[]> m_pCounts;
+    std::atomic<unsigned long long> m_iMax;
+  };
+
+  /**
+   * Computes the latencies of single calls of the curve. The points
+   * are divided into contiguous blocks, one for every thread; every
+   * call is timed by the steady clock, so the latency includes the
+   * cost of reading the clock.
+   *
+   * @param rCurve The curve.
+   * @param rPoints The arguments of the calls.
+   * @param iThreads The number of threads; if 0, then the number of
+   * hardware threads.
+   * @return The histogram of latencies.
+   */
+  Histogram latency(const std::function<double(double)> &rCurve,
+                    const std::vector<double> &rPoints, unsigned iThreads = 0);
+
+  /**
+   * Prints the table of latencies with columns "curve", "calls",
+   * "p50 ns", "p99 ns", "p99.9 ns" and "max ns" followed by the names
+   * of the curves.
+   *
+   * @param rNames The names of the curves.
+   * @param rHistograms The histograms of latencies of the curves.
+   * @param sTitle The title of the table.
+   */
+  void printLatency(const std::vector<std::string> &rNames,
+                    const std::vector<Histogram> &rHistograms,
+                    const std::string &sTitle);
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Histogram_hpp__
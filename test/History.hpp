@@ -0,0 +1,198 @@
+#ifndef __test_all_History_hpp__
+#define __test_all_History_hpp__
+
+/**
+ * @file History.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Compressed history of daily curves.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "test/Columns.hpp"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_History Compressed history of daily curves.
+   *
+   * This module archives the market quotes of a curve (discount
+   * factors, forward prices or volatilities) for consecutive days.
+   * The times of quotes are common for all days; the values of a day
+   * are compressed against the values of the previous day:
+   *
+   * 1. The bits of the value are XOR-ed with the bits of the same
+   * quote of the previous day.
+   * 2. A zero result is written as the single bit 0.
+   * 3. Otherwise the bit 1 is followed either by 0 and the meaningful
+   * bits inside the window of leading and trailing zeros of the
+   * previous XOR of this quote, or by 1, 5 bits of the number of
+   * leading zeros, 6 bits of the number of meaningful bits and the
+   * meaningful bits.
+   *
+   * The days are grouped into blocks of a fixed number of days; the
+   * first day of a block is written without compression, so a block
+   * is decoded independently of the others. All numbers are
+   * little-endian:
+   * \code
+   * offset 0   "VEGAHST\0"            magic
+   * offset 8   uint32 version         (1)
+   * offset 12  uint32 quotes          M
+   * offset 16  uint32 days in a block B
+   * offset 20  uint32 (zero)
+   * offset 24  M doubles of times
+   * blocks     uint32 days, uint32 bytes of data, the data padded
+   *            to 8 bytes
+   * \endcode
+   * The blocks are only appended to the file. A writer opened on an
+   * existing file continues it: the days of the last incomplete block
+   * are decoded, the block is cut off and written again together with
+   * the new days. When the file is opened for reading, the offsets of
+   * blocks are collected into an index;
+   * the day \f$n\f$ lies in the block \f$\lfloor n/B\rfloor\f$, so a
+   * day is found in constant time and at most \f$B\f$ days are
+   * decoded.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The writer of a history of daily curves.
+   */
+  class HistoryWriter
+  {
+  public:
+    /**
+     * Creates the file of history or opens an existing one for
+     * appending. An existing file must have the same times of quotes
+     * and the same number of days in a block; otherwise
+     * std::runtime_error is thrown.
+     *
+     * @param sFile The name of the file.
+     * @param rTimes The times of quotes, common for all days.
+     * @param iBlockDays The number of days in a block.
+     */
+    HistoryWriter(const std::string &sFile, const std::vector<double> &rTimes,
+                  unsigned iBlockDays = 64);
+
+    /**
+     * Writes the last incomplete block.
+     */
+    ~HistoryWriter();
+
+    HistoryWriter(const HistoryWriter &) = delete;
+    HistoryWriter &operator=(const HistoryWriter &) = delete;
+
+    /**
+     * Appends the quotes of the next day.
+     *
+     * @param rValues The quotes at the times given in the
+     * constructor.
+     */
+    void append(const std::vector<double> &rValues);
+
+    /**
+     * Returns the number of bytes written so far, without the last
+     * incomplete block.
+     *
+     * @return The size of the file.
+     */
+    std::size_t bytes() const;
+
+  private:
+    void writeBlock();
+
+    std::ofstream m_fOut;
+    unsigned m_iQuotes;
+    unsigned m_iBlockDays;
+    unsigned m_iDays;
+    std::size_t m_iBytes;
+    std::vector<std::uint64_t> m_uPrevious;
+    std::vector<unsigned char> m_uLeading;
+    std::vector<unsigned char> m_uTrailing;
+    std::vector<std::uint64_t> m_uBits;
+    unsigned m_iBit;
+  };
+
+  /**
+   * @brief The history of daily curves in a file mapped into memory.
+   */
+  class HistoryFile
+  {
+  public:
+    /**
+     * Maps the file into memory and builds the index of blocks. A
+     * file whose header or blocks do not fit into its size throws
+     * std::runtime_error.
+     *
+     * @param sFile The name of the file written by HistoryWriter.
+     */
+    explicit HistoryFile(const std::string &sFile);
+
+    /**
+     * Unmaps the file.
+     */
+    ~HistoryFile();
+
+    HistoryFile(const HistoryFile &) = delete;
+    HistoryFile &operator=(const HistoryFile &) = delete;
+
+    /**
+     * Returns the number of days.
+     *
+     * @return The number of days in the history.
+     */
+    std::size_t days() const;
+
+    /**
+     * Returns the times of quotes.
+     *
+     * @return The view of the times, common for all days.
+     */
+    ColumnView times() const;
+
+    /**
+     * Decodes the quotes of a day.
+     *
+     * @param iDay The index of the day.
+     * @return The quotes of the day.
+     */
+    std::vector<double> values(std::size_t iDay) const;
+
+    /**
+     * Decodes the days in the range \f$[iFirst, iLast)\f$ in order and
+     * calls \p rF for every day. The vector of quotes is reused
+     * between the calls. A range outside the history throws
+     * std::runtime_error.
+     *
+     * @param iFirst The first day.
+     * @param iLast The day after the last one.
+     * @param rF The function of the index of a day and its quotes.
+     */
+    void values(std::size_t iFirst, std::size_t iLast,
+                const std::function<void(std::size_t, const std::vector<double> &)> &rF) const;
+
+  private:
+    friend class HistoryWriter;
+
+    const unsigned char *m_pMap;
+    std::size_t m_iBytes;
+    unsigned m_iQuotes;
+    unsigned m_iBlockDays;
+    std::size_t m_iDays;
+    std::vector<std::size_t> m_uBlocks;
+  };
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_History_hpp__
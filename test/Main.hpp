@@ -12,6 +12,9 @@
  *
  */
 
+#include <functional>
+#include <string>
+#include <vector>
 #include "test/Print.hpp"
 
 /**
@@ -40,6 +43,46 @@ namespace test
    */
   void project(const std::function<void()> &rF, const std::string &sProjectDir,
                const std::string &sFile, const std::string &sTitle);
+
+  /**
+   * @brief The arguments of project() for one run of runProjects().
+   */
+  class Job
+  {
+  public:
+    /**
+     * The function that runs the test.
+     */
+    std::function<void()> run;
+
+    /**
+     * The name of the project directory relative to the output
+     * directory.
+     */
+    std::string dir;
+
+    /**
+     * The name of the output file.
+     */
+    std::string file;
+
+    /**
+     * The name of the project printed at the top of the output file.
+     */
+    std::string title;
+  };
+
+  /**
+   * Runs many projects on a pool of threads. Every project writes to
+   * its own output file through its own Sink, so the output files
+   * are the same as for the sequential calls of project(). The
+   * testing functions must not share mutable data.
+   *
+   * @param rJobs The projects.
+   * @param iThreads The number of threads; if 0, then the number of
+   * hardware threads.
+   */
+  void runProjects(const std::vector<Job> &rJobs, unsigned iThreads = 0);
   /** @} */
 } // namespace test
 
@@ -0,0 +1,211 @@
+#ifndef __test_all_Market_hpp__
+#define __test_all_Market_hpp__
+
+/**
+ * @file Market.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Loaders of market data.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "test/Columns.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Market Loaders of market data.
+   *
+   * This module loads many market curves, that is, pairs of vectors
+   * (times, values) as returned by getDiscount(), getForward() and
+   * getVol(). Two sources are supported:
+   *
+   * 1. CSV files with lines "curve,time,value"; the lines of a curve
+   * are consecutive and its times increase. The file is mapped into
+   * memory and parsed by std::from_chars into two arrays shared by
+   * all curves.
+   *
+   * 2. Binary files written by writeMarket() that are mapped into
+   * memory and used without parsing. All numbers are little-endian:
+   * \code
+   * offset 0   "VEGAMKT\0"            magic
+   * offset 8   uint32 version         (1)
+   * offset 12  uint32 curves          K
+   * offset 16  uint64 points          N
+   * offset 24  uint64 names size      B
+   * offset 32  K+1 uint64 offsets of curves in the arrays of points
+   *            K+1 uint64 offsets of names in the block of names
+   *            (aligned to 64) N doubles of times
+   *            (aligned to 64) N doubles of values
+   *            B characters of names
+   * \endcode
+   *
+   * The curves are returned as views into the shared arrays or into
+   * the map. A view of times or values converts explicitly to the
+   * std::vector<double> taken by value by the builders of curves; the
+   * builder moves this vector into the curve, so the conversion is the
+   * only copy of the knots.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The view of a market curve.
+   */
+  class MarketCurve
+  {
+  public:
+    /**
+     * The name of the curve.
+     */
+    std::string_view name;
+
+    /**
+     * The times of quotes.
+     */
+    ColumnView times;
+
+    /**
+     * The quotes (discount factors, forward prices, volatilities).
+     */
+    ColumnView values;
+  };
+
+  /**
+   * @brief Market curves loaded from a CSV file.
+   */
+  class MarketData
+  {
+  public:
+    /**
+     * Constructs the empty collection.
+     */
+    MarketData();
+
+    /**
+     * Adds a curve.
+     *
+     * @param sName The name of the curve.
+     * @param rTimes The times of quotes.
+     * @param rValues The quotes.
+     */
+    void push_back(const std::string &sName, const std::vector<double> &rTimes,
+                   const std::vector<double> &rValues);
+
+    /**
+     * Returns the number of curves.
+     *
+     * @return The number of curves.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the view of a curve. It stays valid until the next
+     * change of the collection.
+     *
+     * @param iCurve The index of the curve.
+     * @return The view of the curve.
+     */
+    MarketCurve curve(std::size_t iCurve) const;
+
+  private:
+    friend MarketData readMarketCsv(const std::string &sFile);
+    friend void writeMarket(const std::string &sFile, const MarketData &rData);
+
+    std::string m_sNames;
+    std::vector<std::size_t> m_uNames;
+    std::vector<double> m_uTimes;
+    std::vector<double> m_uValues;
+    std::vector<std::size_t> m_uOffsets;
+  };
+
+  /**
+   * Reads the market curves from a CSV file with lines
+   * "curve,time,value". The first line is the header and is skipped
+   * together with empty lines; any other line that is not a name, a
+   * time and a value separated by commas throws std::runtime_error
+   * with the number of the line.
+   *
+   * @param sFile The name of the file.
+   * @return The market curves.
+   */
+  MarketData readMarketCsv(const std::string &sFile);
+
+  /**
+   * Writes the market curves to a CSV file with lines
+   * "curve,time,value"; the numbers are written in the shortest form
+   * that is read back exactly.
+   *
+   * @param sFile The name of the file.
+   * @param rData The market curves.
+   */
+  void writeMarketCsv(const std::string &sFile, const MarketData &rData);
+
+  /**
+   * Writes the market curves to a binary file.
+   *
+   * @param sFile The name of the file.
+   * @param rData The market curves.
+   */
+  void writeMarket(const std::string &sFile, const MarketData &rData);
+
+  /**
+   * @brief Market curves in a binary file mapped into memory. The
+   * views point into the map and stay valid while the object exists.
+   */
+  class MarketFile
+  {
+  public:
+    /**
+     * Maps the file into memory. A file whose tables of offsets do not
+     * increase or point outside the file throws std::runtime_error.
+     *
+     * @param sFile The name of the file written by writeMarket().
+     */
+    explicit MarketFile(const std::string &sFile);
+
+    /**
+     * Unmaps the file.
+     */
+    ~MarketFile();
+
+    MarketFile(const MarketFile &) = delete;
+    MarketFile &operator=(const MarketFile &) = delete;
+
+    /**
+     * Returns the number of curves.
+     *
+     * @return The number of curves.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the view of a curve.
+     *
+     * @param iCurve The index of the curve.
+     * @return The view of the curve.
+     */
+    MarketCurve curve(std::size_t iCurve) const;
+
+  private:
+    const unsigned char *m_pMap;
+    std::size_t m_iBytes;
+    std::size_t m_iCurves;
+    const std::uint64_t *m_pOffsets;
+    const std::uint64_t *m_pNames;
+    const double *m_pTimes;
+    const double *m_pValues;
+    const char *m_pNameChars;
+  };
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Market_hpp__
@@ -0,0 +1,90 @@
+#include "test/Allocations.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace test;
+
+namespace NAllocations
+{
+  std::atomic<std::size_t> g_iCount(0);
+} // namespace NAllocations
+
+void *operator new(std::size_t iBytes)
+{
+  NAllocations::g_iCount.fetch_add(1, std::memory_order_relaxed);
+  void *p = std::malloc(iBytes ? iBytes : 1);
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](std::size_t iBytes)
+{
+  return operator new(iBytes);
+}
+
+void *operator new(std::size_t iBytes, std::align_val_t iAlign)
+{
+  NAllocations::g_iCount.fetch_add(1, std::memory_order_relaxed);
+  std::size_t iA = std::size_t(iAlign);
+  void *p = std::aligned_alloc(iA, (iBytes + iA - 1) / iA * iA);
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](std::size_t iBytes, std::align_val_t iAlign)
+{
+  return operator new(iBytes, iAlign);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+std::size_t test::allocations()
+{
+  return NAllocations::g_iCount.load(std::memory_order_relaxed);
+}
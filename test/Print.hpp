@@ -18,6 +18,7 @@
 #include <vector>
 #include <valarray>
 #include "test/Output.hpp"
+#include "test/Sink.hpp"
 #include "test/Index.hpp"
 #include "test/Data.hpp"
 
@@ -137,6 +138,59 @@ namespace test
                   const std::string &sMessage, unsigned iColumnSize = 10,
                   unsigned iSpaceSize = 6, unsigned iMaxRows = 20);
 
+  /**
+   * Prints displayed message to the sink.
+   *
+   * @param rSink The output sink.
+   * @param sMessage The message.
+   */
+  void print(Sink &rSink, const std::string &sMessage);
+
+  /**
+   * Prints the value of a parameter to the sink.
+   *
+   * @param rSink The output sink.
+   * @param dValue The value of the parameter.
+   * @param rName The name of the parameter.
+   * @param bExtraLine If \p true, then extra line is added at the end.
+   */
+  void print(Sink &rSink, double dValue, const std::string &rName,
+             bool bExtraLine = false);
+
+  /**
+   * Prints the subset of the table of the results to the sink.
+   *
+   * @param rSink The output sink.
+   * @param rValues The vector of columns of the results.
+   * @param rNames The vector of titles of the columns.
+   * @param sMessage The title of the table.
+   * @param iColumnSize The width of the column.
+   * @param iSpaceSize The space between the columns.
+   * @param iMaxRows The maximal number of rows in the middle of total table
+   * to be printed.
+   */
+  void printTable(Sink &rSink, const std::vector<std::valarray<double>> &rValues,
+                  const std::vector<std::string> &rNames,
+                  const std::string &sMessage, unsigned iColumnSize,
+                  unsigned iSpaceSize, unsigned iMaxRows);
+
+  /**
+   * Prints the subset of the table of the results to the sink.
+   *
+   * @param rSink The output sink.
+   * @param rValues The vector of columns of the results.
+   * @param rNames The vector of titles of the columns.
+   * @param sMessage The title of the table.
+   * @param iColumnSize The width of the column.
+   * @param iSpaceSize The space between the columns.
+   * @param iMaxRows The maximal number of rows in the middle of total table
+   * to be printed.
+   */
+  void printTable(Sink &rSink, const std::vector<std::vector<double>> &rValues,
+                  const std::vector<std::string> &rNames,
+                  const std::string &sMessage, unsigned iColumnSize = 10,
+                  unsigned iSpaceSize = 6, unsigned iMaxRows = 20);
+
   class CashFlow;
   /**
    * Prints the parameters of a regular cash flow.
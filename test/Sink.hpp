@@ -0,0 +1,115 @@
+#ifndef __test_all_Sink_hpp__
+#define __test_all_Sink_hpp__
+
+/**
+ * @file Sink.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Output sinks of testing functions.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Sink Output sinks.
+   *
+   * The printing functions write to an output sink. It is either
+   * given explicitly or it is the current sink of the calling thread
+   * set by SinkScope; by default, the current sink is the console.
+   * Every project has its own sink, so projects can run concurrently
+   * in different threads.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The destination of the output of testing functions.
+   */
+  class Sink
+  {
+  public:
+    /**
+     * Constructs the sink that writes to an existing stream.
+     *
+     * @param rOut The output stream.
+     */
+    explicit Sink(std::ostream &rOut);
+
+    /**
+     * Constructs the sink that writes to a new file.
+     *
+     * @param sFile The name of the file.
+     */
+    explicit Sink(const std::string &sFile);
+
+    Sink(const Sink &) = delete;
+    Sink &operator=(const Sink &) = delete;
+
+    /**
+     * Returns the output stream of the sink.
+     *
+     * @return The output stream.
+     */
+    std::ostream &stream();
+
+  private:
+    std::unique_ptr<std::ofstream> m_pFile;
+    std::ostream *m_pOut;
+  };
+
+  /**
+   * Returns the current sink of the calling thread.
+   *
+   * @return The sink set by the innermost SinkScope of the thread or
+   * the console.
+   */
+  Sink &sink();
+
+  /**
+   * Returns the output stream of the current sink of the calling
+   * thread.
+   *
+   * @return The stream of sink().
+   */
+  std::ostream &out();
+
+  /**
+   * @brief Makes a sink current for the calling thread during the
+   * lifetime of the object.
+   */
+  class SinkScope
+  {
+  public:
+    /**
+     * Makes the sink current.
+     *
+     * @param rSink The sink.
+     */
+    explicit SinkScope(Sink &rSink);
+
+    /**
+     * Restores the previous sink.
+     */
+    ~SinkScope();
+
+    SinkScope(const SinkScope &) = delete;
+    SinkScope &operator=(const SinkScope &) = delete;
+
+  private:
+    Sink *m_pPrevious;
+  };
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Sink_hpp__
@@ -0,0 +1,242 @@
+#include "test/Bench.hpp"
+#include <chrono>
+#include <cassert>
+#include <cmath>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace test;
+
+double test::Measurement::nanoseconds() const
+{
+  return 1E9 * seconds / (double(repeats) * double(points));
+}
+
+test::Counters test::Measurement::perPoint() const
+{
+  return counters.per(double(repeats) * double(points));
+}
+
+bool test::Counters::available() const
+{
+  return !(std::isnan(cycles) && std::isnan(instructions) && std::isnan(branchMisses) &&
+           std::isnan(l1Misses) && std::isnan(llcMisses));
+}
+
+test::Counters test::Counters::per(double dN) const
+{
+  return Counters{cycles / dN, instructions / dN, branchMisses / dN,
+                  l1Misses / dN, llcMisses / dN};
+}
+
+namespace NPerf
+{
+#ifdef __linux__
+  // the events in the order of the members of Counters
+  const std::vector<std::pair<unsigned, unsigned long long>> c_uEvents = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}};
+
+  int open(unsigned iType, unsigned long long iConfig)
+  {
+    perf_event_attr uAttr{};
+    uAttr.size = sizeof(uAttr);
+    uAttr.type = iType;
+    uAttr.config = iConfig;
+    uAttr.disabled = 1;
+    uAttr.exclude_kernel = 1;
+    uAttr.exclude_hv = 1;
+    uAttr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return int(syscall(SYS_perf_event_open, &uAttr, 0, -1, -1, 0));
+  }
+
+  // the value of the counter scaled for multiplexing
+  double read(int iFd)
+  {
+    unsigned long long uValues[3];
+    if (iFd < 0 || ::read(iFd, uValues, sizeof(uValues)) != sizeof(uValues) || uValues[2] == 0)
+    {
+      return NAN;
+    }
+    return double(uValues[0]) * double(uValues[1]) / double(uValues[2]);
+  }
+#endif
+} // namespace NPerf
+
+test::PerfCounters::PerfCounters()
+{
+#ifdef __linux__
+  for (const auto &rEvent : NPerf::c_uEvents)
+  {
+    m_uFd.push_back(NPerf::open(rEvent.first, rEvent.second));
+  }
+#endif
+}
+
+test::PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+  for (int iFd : m_uFd)
+  {
+    if (iFd >= 0)
+    {
+      close(iFd);
+    }
+  }
+#endif
+}
+
+void test::PerfCounters::start()
+{
+#ifdef __linux__
+  for (int iFd : m_uFd)
+  {
+    if (iFd >= 0)
+    {
+      ioctl(iFd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(iFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+test::Counters test::PerfCounters::stop()
+{
+  std::vector<double> uValues(5, NAN);
+#ifdef __linux__
+  for (int iFd : m_uFd)
+  {
+    if (iFd >= 0)
+    {
+      ioctl(iFd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (unsigned i = 0; i < m_uFd.size(); i++)
+  {
+    uValues[i] = NPerf::read(m_uFd[i]);
+  }
+#endif
+  return Counters{uValues[0], uValues[1], uValues[2], uValues[3], uValues[4]};
+}
+
+namespace NBench
+{
+  // the result of evaluations; it keeps the optimizer from removing them
+  thread_local volatile double g_dSink = 0.;
+} // namespace NBench
+
+void test::keepAlive(double dValue)
+{
+  NBench::g_dSink = dValue;
+}
+
+double test::seconds()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+test::Measurement test::measure(const std::function<void()> &rRun,
+                                const std::string &sCurve, const std::string &sKind,
+                                unsigned iKnots, unsigned long iPoints,
+                                double dMinTime)
+{
+  assert(iPoints > 0);
+
+  Measurement uM;
+  uM.curve = sCurve;
+  uM.kind = sKind;
+  uM.knots = iKnots;
+  uM.points = iPoints;
+  uM.repeats = 0;
+  static thread_local PerfCounters uCounters;
+  uCounters.start();
+  double dStart = seconds();
+  do
+  {
+    rRun();
+    uM.repeats++;
+    uM.seconds = seconds() - dStart;
+  } while (uM.seconds < dMinTime);
+  uM.counters = uCounters.stop();
+  return uM;
+}
+
+void test::printBench(const std::vector<Measurement> &rResults,
+                      const std::string &sTitle)
+{
+  bool bCounters = std::any_of(rResults.begin(), rResults.end(),
+                               [](const Measurement &rM)
+                               { return rM.counters.available(); });
+  std::vector<std::string> uNames = {"knots", "points", "ns/point"};
+  if (bCounters)
+  {
+    uNames.insert(uNames.end(), {"cycles", "instr", "br-miss", "L1-miss", "LLC-miss"});
+  }
+  std::vector<std::vector<double>> uColumns(uNames.size());
+  for (const Measurement &rM : rResults)
+  {
+    uColumns[0].push_back(rM.knots);
+    uColumns[1].push_back(rM.points);
+    uColumns[2].push_back(rM.nanoseconds());
+    if (bCounters)
+    {
+      Counters uC = rM.perPoint();
+      uColumns[3].push_back(uC.cycles);
+      uColumns[4].push_back(uC.instructions);
+      uColumns[5].push_back(uC.branchMisses);
+      uColumns[6].push_back(uC.l1Misses);
+      uColumns[7].push_back(uC.llcMisses);
+    }
+  }
+  printTable(uColumns, uNames, sTitle, 10, 4, rResults.size());
+}
+
+void test::writeJson(const std::vector<Measurement> &rResults,
+                     const std::string &sFile)
+{
+  std::ofstream fOut(sFile.c_str());
+  fOut << std::setprecision(10);
+  fOut << "{\"benchmarks\": [";
+  for (unsigned i = 0; i < rResults.size(); i++)
+  {
+    const Measurement &rM = rResults[i];
+    fOut << ((i > 0) ? "," : "") << "\n  {"
+         << "\"curve\": \"" << rM.curve << "\", "
+         << "\"kind\": \"" << rM.kind << "\", "
+         << "\"knots\": " << rM.knots << ", "
+         << "\"points\": " << rM.points << ", "
+         << "\"repeats\": " << rM.repeats << ", "
+         << "\"seconds\": " << rM.seconds << ", "
+         << "\"ns_per_point\": " << rM.nanoseconds();
+    Counters uC = rM.perPoint();
+    std::vector<std::pair<std::string, double>> uCounters = {
+        {"cycles_per_point", uC.cycles},
+        {"instructions_per_point", uC.instructions},
+        {"branch_misses_per_point", uC.branchMisses},
+        {"l1_misses_per_point", uC.l1Misses},
+        {"llc_misses_per_point", uC.llcMisses}};
+    for (const auto &rC : uCounters)
+    {
+      fOut << ", \"" << rC.first << "\": ";
+      if (std::isnan(rC.second))
+      {
+        fOut << "null";
+      }
+      else
+      {
+        fOut << rC.second;
+      }
+    }
+    fOut << "}";
+  }
+  fOut << "\n]}\n";
+}
@@ -0,0 +1,241 @@
+#include "test/Columns.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace test;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "the columnar files are read without conversion on little-endian hosts");
+
+namespace NColumns
+{
+  const char c_sMagic[8] = {'V', 'E', 'G', 'A', 'C', 'O', 'L', '\0'};
+  const std::uint32_t c_iVersion = 1;
+  const std::size_t c_iAlign = 64;
+  const std::size_t c_iHeader = 32;
+
+  std::size_t align(std::size_t iOffset)
+  {
+    return (iOffset + c_iAlign - 1) / c_iAlign * c_iAlign;
+  }
+
+  template <class T>
+  void put(std::vector<char> &rBytes, T iValue)
+  {
+    const char *pValue = reinterpret_cast<const char *>(&iValue);
+    rBytes.insert(rBytes.end(), pValue, pValue + sizeof(T));
+  }
+
+  template <class T>
+  T get(const unsigned char *pData)
+  {
+    T iValue;
+    std::memcpy(&iValue, pData, sizeof(T));
+    return iValue;
+  }
+
+  void write(const std::string &sFile, const std::vector<const double *> &rColumns,
+             std::size_t iRows, const std::vector<std::string> &rNames)
+  {
+    assert(rColumns.size() == rNames.size());
+
+    std::vector<char> uHeader(c_sMagic, c_sMagic + 8);
+    put<std::uint32_t>(uHeader, c_iVersion);
+    put<std::uint32_t>(uHeader, std::uint32_t(rColumns.size()));
+    put<std::uint64_t>(uHeader, std::uint64_t(iRows));
+    std::size_t iNames = 0;
+    for (const std::string &sName : rNames)
+    {
+      iNames += sizeof(std::uint32_t) + sName.size();
+    }
+    put<std::uint64_t>(uHeader, std::uint64_t(align(c_iHeader + iNames)));
+    for (const std::string &sName : rNames)
+    {
+      put<std::uint32_t>(uHeader, std::uint32_t(sName.size()));
+      uHeader.insert(uHeader.end(), sName.begin(), sName.end());
+    }
+    uHeader.resize(align(uHeader.size()), '\0');
+
+    std::ofstream fOut(sFile.c_str(), std::ios::binary);
+    if (!fOut)
+    {
+      throw std::runtime_error("cannot open the file " + sFile);
+    }
+    fOut.write(uHeader.data(), uHeader.size());
+    std::vector<char> uPad(c_iAlign, '\0');
+    std::size_t iColumn = iRows * sizeof(double);
+    for (const double *pColumn : rColumns)
+    {
+      fOut.write(reinterpret_cast<const char *>(pColumn), iColumn);
+      fOut.write(uPad.data(), align(iColumn) - iColumn);
+    }
+    fOut.close();
+    if (!fOut)
+    {
+      throw std::runtime_error("cannot write the file " + sFile);
+    }
+  }
+} // namespace NColumns
+
+test::ColumnView::ColumnView(const double *pData, std::size_t iSize)
+    : m_pData(pData), m_iSize(iSize)
+{
+}
+
+const double *test::ColumnView::data() const
+{
+  return m_pData;
+}
+
+std::size_t test::ColumnView::size() const
+{
+  return m_iSize;
+}
+
+double test::ColumnView::operator[](std::size_t i) const
+{
+  assert(i < m_iSize);
+  return m_pData[i];
+}
+
+const double *test::ColumnView::begin() const
+{
+  return m_pData;
+}
+
+const double *test::ColumnView::end() const
+{
+  return m_pData + m_iSize;
+}
+
+test::ColumnView::operator std::vector<double>() const
+{
+  return std::vector<double>(m_pData, m_pData + m_iSize);
+}
+
+void test::writeColumns(const std::string &sFile,
+                        const std::vector<std::valarray<double>> &rValues,
+                        const std::vector<std::string> &rNames)
+{
+  std::size_t iRows = rValues.empty() ? 0 : rValues.front().size();
+  std::vector<const double *> uColumns;
+  for (const std::valarray<double> &rColumn : rValues)
+  {
+    assert(rColumn.size() == iRows);
+    uColumns.push_back(std::begin(rColumn));
+  }
+  NColumns::write(sFile, uColumns, iRows, rNames);
+}
+
+void test::writeColumns(const std::string &sFile,
+                        const std::vector<std::vector<double>> &rValues,
+                        const std::vector<std::string> &rNames)
+{
+  std::size_t iRows = rValues.empty() ? 0 : rValues.front().size();
+  std::vector<const double *> uColumns;
+  for (const std::vector<double> &rColumn : rValues)
+  {
+    assert(rColumn.size() == iRows);
+    uColumns.push_back(rColumn.data());
+  }
+  NColumns::write(sFile, uColumns, iRows, rNames);
+}
+
+test::ColumnFile::ColumnFile(const std::string &sFile)
+    : m_pMap(nullptr), m_iBytes(0), m_iRows(0)
+{
+  using namespace NColumns;
+
+  int iFd = open(sFile.c_str(), O_RDONLY);
+  struct stat uStat;
+  if (iFd < 0 || fstat(iFd, &uStat) != 0)
+  {
+    if (iFd >= 0)
+    {
+      close(iFd);
+    }
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  m_iBytes = std::size_t(uStat.st_size);
+  void *pMap = (m_iBytes > 0) ? mmap(nullptr, m_iBytes, PROT_READ, MAP_SHARED, iFd, 0) : MAP_FAILED;
+  close(iFd);
+  if (pMap == MAP_FAILED || m_iBytes < c_iHeader || std::memcmp(pMap, c_sMagic, 8) != 0 ||
+      get<std::uint32_t>(static_cast<const unsigned char *>(pMap) + 8) != c_iVersion)
+  {
+    if (pMap != MAP_FAILED)
+    {
+      munmap(pMap, m_iBytes);
+    }
+    throw std::runtime_error("the file " + sFile + " is not a columnar file of version 1");
+  }
+  m_pMap = static_cast<const unsigned char *>(pMap);
+
+  std::uint32_t iColumns = get<std::uint32_t>(m_pMap + 12);
+  m_iRows = get<std::uint64_t>(m_pMap + 16);
+  std::uint64_t iOffset = get<std::uint64_t>(m_pMap + 24);
+
+  // the names lie between the header and the first column; the
+  // columns lie inside the file
+  bool bValid = (m_iRows <= m_iBytes / sizeof(double) && iOffset <= m_iBytes &&
+                 iOffset % sizeof(double) == 0);
+  std::size_t iName = c_iHeader;
+  for (std::uint32_t i = 0; bValid && i < iColumns; i++)
+  {
+    bValid = (iName + sizeof(std::uint32_t) <= iOffset);
+    std::uint32_t iLength = bValid ? get<std::uint32_t>(m_pMap + iName) : 0;
+    bValid = bValid && (iName + sizeof(std::uint32_t) + iLength <= iOffset) &&
+             (iOffset + m_iRows * sizeof(double) <= m_iBytes);
+    if (bValid)
+    {
+      m_uNames.emplace_back(reinterpret_cast<const char *>(m_pMap + iName) + sizeof(std::uint32_t),
+                            iLength);
+      iName += sizeof(std::uint32_t) + iLength;
+      m_uOffsets.push_back(iOffset);
+      iOffset += align(m_iRows * sizeof(double));
+    }
+  }
+  if (!bValid)
+  {
+    munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+    throw std::runtime_error("the columnar file " + sFile + " is damaged");
+  }
+}
+
+test::ColumnFile::~ColumnFile()
+{
+  munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+}
+
+std::size_t test::ColumnFile::rows() const
+{
+  return m_iRows;
+}
+
+const std::vector<std::string> &test::ColumnFile::names() const
+{
+  return m_uNames;
+}
+
+test::ColumnView test::ColumnFile::column(unsigned iColumn) const
+{
+  assert(iColumn < m_uOffsets.size());
+  return ColumnView(reinterpret_cast<const double *>(m_pMap + m_uOffsets[iColumn]), m_iRows);
+}
+
+test::ColumnView test::ColumnFile::column(const std::string &sName) const
+{
+  auto iName = std::find(m_uNames.begin(), m_uNames.end(), sName);
+  if (iName == m_uNames.end())
+  {
+    throw std::runtime_error("no column " + sName + " in the columnar file");
+  }
+  return column(unsigned(iName - m_uNames.begin()));
+}
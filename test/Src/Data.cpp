@@ -1,5 +1,6 @@
 #include "test/Data.hpp"
 #include "test/Output.hpp"
+#include "test/Table.hpp"
 #include <cassert>
 
 using namespace std;
@@ -10,33 +11,8 @@ void test::print(const std::function<double(double)> &rData, double dStartTime,
 {
   test::print("VALUES VERSUS TIME:");
 
-  int iI, iSize;
-  if (dInterval == 0.)
-  {
-    iSize = 1;
-  }
-  else
-  {
-    iSize = iPoints;
-  }
-
-  unsigned iTime = 8;
-  unsigned iSpace = 6;
-  unsigned iValue = 10;
-
-  double dPeriod = dInterval / (iSize + 0.25);
-  std::cout << std::setw(iTime) << "time"
-            << std::setw(iSpace) << ""
-            << std::setw(iValue) << "value" << endl;
-
-  for (iI = 0; iI < iSize + 1; iI++)
-  {
-    double dTime = dStartTime + iI * dPeriod;
-    std::cout << std::setw(iTime) << dTime
-              << std::setw(iSpace) << ""
-              << std::setw(iValue) << rData(dTime) << endl;
-  }
-  cout << endl;
+  writeCurve(out(), rData, dStartTime, dInterval, iPoints, TableFormat::fixed);
+  out() << endl;
 }
 
 void test::print(const std::string &sTitle,
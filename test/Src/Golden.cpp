@@ -0,0 +1,351 @@
+#include "test/Golden.hpp"
+#include "test/Bench.hpp"
+#include "vega/trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+
+using namespace std;
+using namespace test;
+
+namespace NGolden
+{
+  // the number of batches of timed runs in replay()
+  const unsigned c_iBatches = 5;
+
+  // stores the output and the time at the end of every line
+  class Timestamps : public std::streambuf
+  {
+  public:
+    std::string text;
+    std::vector<double> lines;
+
+  protected:
+    int overflow(int c) override
+    {
+      if (c != traits_type::eof())
+      {
+        text.push_back(char(c));
+        if (c == '\n')
+        {
+          lines.push_back(seconds());
+        }
+      }
+      return c;
+    }
+
+    std::streamsize xsputn(const char *pS, std::streamsize iN) override
+    {
+      text.append(pS, iN);
+      for (std::streamsize i = 0; i < iN; i++)
+      {
+        if (pS[i] == '\n')
+        {
+          lines.push_back(seconds());
+        }
+      }
+      return iN;
+    }
+  };
+
+  bool isTitle(const std::string &sLine)
+  {
+    if (sLine.empty() || sLine.back() == ':')
+    {
+      return false;
+    }
+    unsigned iRun = 0, iMaxRun = 0;
+    for (char c : sLine)
+    {
+      if (std::islower((unsigned char)c))
+      {
+        return false;
+      }
+      iRun = std::isupper((unsigned char)c) ? iRun + 1 : 0;
+      iMaxRun = std::max(iMaxRun, iRun);
+    }
+    return (iMaxRun >= 3);
+  }
+
+  // splits the text into sections; rLines are the times at the ends
+  // of lines and dEnd is the time at the end of the output
+  std::vector<Section> split(const std::string &sText,
+                             const std::vector<double> &rLines, double dEnd)
+  {
+    std::vector<Section> uSections;
+    std::vector<double> uStart;
+    std::size_t iPos = 0;
+    unsigned iLine = 0;
+    while (iPos < sText.size())
+    {
+      std::size_t iEnd = sText.find('\n', iPos);
+      iEnd = (iEnd == std::string::npos) ? sText.size() : iEnd + 1;
+      std::string sLine = sText.substr(iPos, iEnd - iPos);
+      while (!sLine.empty() && std::isspace((unsigned char)sLine.back()))
+      {
+        sLine.pop_back();
+      }
+      double dTime = (iLine < rLines.size()) ? rLines[iLine] : dEnd;
+      if (isTitle(sLine) || uSections.empty())
+      {
+        uSections.push_back(Section{isTitle(sLine) ? sLine : "", "", 0.});
+        uStart.push_back(dTime);
+      }
+      uSections.back().text.append(sText, iPos, iEnd - iPos);
+      iPos = iEnd;
+      iLine++;
+    }
+    for (unsigned i = 0; i < uSections.size(); i++)
+    {
+      double dNext = (i + 1 < uStart.size()) ? uStart[i + 1] : dEnd;
+      uSections[i].seconds = dNext - uStart[i];
+    }
+    return uSections;
+  }
+
+  std::vector<std::string> words(const std::string &sText)
+  {
+    std::istringstream uIn(sText);
+    std::vector<std::string> uWords;
+    std::string sWord;
+    while (uIn >> sWord)
+    {
+      uWords.push_back(sWord);
+    }
+    return uWords;
+  }
+
+  bool number(const std::string &sWord, double &rValue)
+  {
+    const char *pStart = sWord.c_str();
+    char *pEnd = nullptr;
+    rValue = std::strtod(pStart, &pEnd);
+    return (pEnd != pStart) && (*pEnd == '\0');
+  }
+
+  // returns the maximal error in the units of tolerance; the error
+  // is infinite if the words do not match
+  double error(const std::string &sGolden, const std::string &sReplay,
+               const Tolerance &rTolerance)
+  {
+    std::vector<std::string> uGolden = words(sGolden);
+    std::vector<std::string> uReplay = words(sReplay);
+    if (uGolden.size() != uReplay.size())
+    {
+      return INFINITY;
+    }
+    double dError = 0.;
+    for (unsigned i = 0; i < uGolden.size(); i++)
+    {
+      double dGolden, dReplay;
+      if (number(uGolden[i], dGolden) && number(uReplay[i], dReplay))
+      {
+        if (std::isnan(dGolden) || std::isnan(dReplay))
+        {
+          if (std::isnan(dGolden) != std::isnan(dReplay))
+          {
+            return INFINITY;
+          }
+          continue;
+        }
+        double dTol = rTolerance.absolute + rTolerance.relative * std::abs(dGolden);
+        dError = std::max(dError, std::abs(dReplay - dGolden) / dTol);
+      }
+      else if (uGolden[i] != uReplay[i])
+      {
+        return INFINITY;
+      }
+    }
+    return dError;
+  }
+
+} // namespace NGolden
+
+std::vector<test::Section> test::replay(const std::function<void()> &rF,
+                                        double dMinTime)
+{
+  std::vector<Section> uSections;
+  std::vector<double> uBatch;
+  unsigned iRuns = 0;
+  double dBatchTime = 0.;
+  double dTime = 0.;
+  // the first run is not timed
+  for (unsigned i = 0; i == 0 || dTime < dMinTime; i++)
+  {
+    NGolden::Timestamps uBuffer;
+    std::ostream uStream(&uBuffer);
+    uStream.precision(15);
+    Sink uSink(uStream);
+    double dStart = seconds();
+    {
+      SinkScope uScope(uSink);
+#ifdef VEGA_TRACE
+      // the calls of a replay are not added to the report of the caller
+      vega::TraceRegistry uTrace;
+      vega::TraceRegistryScope uTraceScope(uTrace);
+#endif
+      rF();
+    }
+    uStream.flush();
+    double dEnd = seconds();
+
+    std::vector<Section> uRun = NGolden::split(uBuffer.text, uBuffer.lines, dEnd);
+    if (i == 0)
+    {
+      uSections = uRun;
+      uBatch.assign(uSections.size(), 0.);
+      for (Section &rS : uSections)
+      {
+        rS.seconds = INFINITY;
+      }
+      continue;
+    }
+    if (uRun.size() != uSections.size())
+    {
+      throw std::runtime_error("The replays of a testing function have different sections");
+    }
+    for (unsigned j = 0; j < uSections.size(); j++)
+    {
+      uBatch[j] += uRun[j].seconds;
+    }
+    iRuns++;
+    dBatchTime += dEnd - dStart;
+    dTime += dEnd - dStart;
+
+    // a batch ends after a fixed share of the time; the minimum over
+    // the batches ignores the batches interrupted by other processes
+    if (dBatchTime >= dMinTime / NGolden::c_iBatches || dTime >= dMinTime)
+    {
+      for (unsigned j = 0; j < uSections.size(); j++)
+      {
+        uSections[j].seconds = std::min(uSections[j].seconds, uBatch[j] / iRuns);
+      }
+      uBatch.assign(uSections.size(), 0.);
+      iRuns = 0;
+      dBatchTime = 0.;
+    }
+  }
+  return uSections;
+}
+
+void test::writeGolden(const std::vector<Section> &rSections,
+                       const std::string &sFile)
+{
+  std::ofstream fText((sFile + ".txt").c_str());
+  std::ofstream fTime((sFile + ".time").c_str());
+  fTime << std::setprecision(6);
+  for (const Section &rS : rSections)
+  {
+    fText << rS.text;
+    fTime << rS.seconds << "\t" << rS.title << "\n";
+  }
+}
+
+std::vector<test::Section> test::readGolden(const std::string &sFile)
+{
+  std::ifstream fText((sFile + ".txt").c_str());
+  std::ifstream fTime((sFile + ".time").c_str());
+  if (!fText || !fTime)
+  {
+    return {};
+  }
+  std::ostringstream uText;
+  uText << fText.rdbuf();
+  std::vector<Section> uSections = NGolden::split(uText.str(), {}, 0.);
+
+  // every section has its baseline
+  std::string sLine;
+  for (Section &rS : uSections)
+  {
+    if (!std::getline(fTime, sLine))
+    {
+      return {};
+    }
+    char *pEnd = nullptr;
+    rS.seconds = std::strtod(sLine.c_str(), &pEnd);
+    if (pEnd == sLine.c_str() || !(rS.seconds >= 0.))
+    {
+      return {};
+    }
+  }
+  if (std::getline(fTime, sLine))
+  {
+    return {};
+  }
+  return uSections;
+}
+
+bool test::checkGolden(const std::vector<Section> &rGolden,
+                       const std::vector<Section> &rReplay,
+                       const Tolerance &rTolerance, const std::string &sTitle)
+{
+  if (rGolden.size() != rReplay.size())
+  {
+    print(sTitle);
+    print(rGolden.size(), "sections in the golden output");
+    print(rReplay.size(), "sections in the replayed output");
+    print("FAILED: the numbers of sections are different");
+    return false;
+  }
+
+  // the speed of the host: the median over the sections of the
+  // ratios of the running times to the baselines
+  std::vector<double> uRatios;
+  for (unsigned i = 0; i < rGolden.size(); i++)
+  {
+    if (rGolden[i].seconds > 0.)
+    {
+      uRatios.push_back(rReplay[i].seconds / rGolden[i].seconds);
+    }
+  }
+  double dHost = 1.;
+  if (!uRatios.empty())
+  {
+    std::sort(uRatios.begin(), uRatios.end());
+    unsigned iMiddle = uRatios.size() / 2;
+    dHost = (uRatios.size() % 2 == 1) ? uRatios[iMiddle]
+                                      : 0.5 * (uRatios[iMiddle - 1] + uRatios[iMiddle]);
+  }
+
+  bool bPassed = true;
+  std::vector<std::string> uFailed;
+  std::vector<std::vector<double>> uColumns(5);
+  for (unsigned i = 0; i < rGolden.size(); i++)
+  {
+    double dError = (rGolden[i].title == rReplay[i].title)
+                        ? NGolden::error(rGolden[i].text, rReplay[i].text, rTolerance)
+                        : INFINITY;
+    double dBaseline = dHost * rGolden[i].seconds;
+    double dMaxTime = rTolerance.slowdown * dBaseline + rTolerance.noise;
+    bool bNumbers = (dError <= 1.);
+    bool bTime = (rReplay[i].seconds <= dMaxTime);
+    if (!bNumbers)
+    {
+      uFailed.push_back(std::to_string(i) + ": numbers differ in " + rGolden[i].title);
+    }
+    if (!bTime)
+    {
+      uFailed.push_back(std::to_string(i) + ": too slow " + rGolden[i].title);
+    }
+    bPassed = bPassed && bNumbers && bTime;
+
+    uColumns[0].push_back(i);
+    uColumns[1].push_back(dError);
+    uColumns[2].push_back(rReplay[i].seconds);
+    uColumns[3].push_back(rGolden[i].seconds);
+    uColumns[4].push_back(rReplay[i].seconds / dBaseline);
+  }
+  printTable(uColumns, {"section", "error/tol", "seconds", "baseline", "slowdown"},
+             sTitle, 12, 4, rGolden.size());
+  print(dHost, "median ratio of the running times to the baselines", true);
+  for (const std::string &sFailed : uFailed)
+  {
+    print("FAILED " + sFailed);
+  }
+  print(bPassed ? "passed" : "failed");
+  return bPassed;
+}
@@ -0,0 +1,210 @@
+#include "test/Histogram.hpp"
+#include "test/Bench.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+using namespace test;
+
+namespace NHistogram
+{
+  // the number of significant bits kept in a bucket
+  const unsigned c_iBits = 5;
+  const unsigned c_iSub = 1u << c_iBits;
+
+  long long now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+} // namespace NHistogram
+
+const unsigned test::Histogram::c_iBuckets = (64 - NHistogram::c_iBits + 1) * NHistogram::c_iSub;
+
+unsigned test::Histogram::bucket(unsigned long long iValue)
+{
+  using namespace NHistogram;
+  if (iValue < c_iSub)
+  {
+    return unsigned(iValue);
+  }
+  unsigned iExp = 63 - __builtin_clzll(iValue);
+  unsigned iShift = iExp - c_iBits;
+  return (iShift + 1) * c_iSub + unsigned((iValue >> iShift) & (c_iSub - 1));
+}
+
+unsigned long long test::Histogram::upper(unsigned iBucket)
+{
+  using namespace NHistogram;
+  if (iBucket < c_iSub)
+  {
+    return iBucket;
+  }
+  unsigned iShift = iBucket / c_iSub - 1;
+  unsigned long long iLower = (unsigned long long)(c_iSub + iBucket % c_iSub) << iShift;
+  return iLower + ((1ull << iShift) - 1);
+}
+
+test::Histogram::Histogram()
+    : m_uCounts(c_iBuckets, 0), m_iMax(0)
+{
+}
+
+void test::Histogram::record(unsigned long long iValue)
+{
+  m_uCounts[bucket(iValue)]++;
+  m_iMax = std::max(m_iMax, iValue);
+}
+
+void test::Histogram::merge(const Histogram &rHistogram)
+{
+  for (unsigned i = 0; i < c_iBuckets; i++)
+  {
+    m_uCounts[i] += rHistogram.m_uCounts[i];
+  }
+  m_iMax = std::max(m_iMax, rHistogram.m_iMax);
+}
+
+unsigned long long test::Histogram::count() const
+{
+  unsigned long long iCount = 0;
+  for (unsigned long long iC : m_uCounts)
+  {
+    iCount += iC;
+  }
+  return iCount;
+}
+
+unsigned long long test::Histogram::max() const
+{
+  return m_iMax;
+}
+
+unsigned long long test::Histogram::quantile(double dP) const
+{
+  assert(dP > 0. && dP <= 1.);
+
+  unsigned long long iCount = count();
+  if (iCount == 0)
+  {
+    return 0;
+  }
+  unsigned long long iRank = (unsigned long long)std::ceil(dP * iCount);
+  iRank = std::max(iRank, 1ull);
+  unsigned long long iSum = 0;
+  for (unsigned i = 0; i < c_iBuckets; i++)
+  {
+    iSum += m_uCounts[i];
+    if (iSum >= iRank)
+    {
+      return std::min(upper(i), m_iMax);
+    }
+  }
+  return m_iMax;
+}
+
+test::SharedHistogram::SharedHistogram()
+    : m_pCounts(new std::atomic<unsigned long long>[Histogram::c_iBuckets]), m_iMax(0)
+{
+  for (unsigned i = 0; i < Histogram::c_iBuckets; i++)
+  {
+    m_pCounts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void test::SharedHistogram::merge(const Histogram &rHistogram)
+{
+  for (unsigned i = 0; i < Histogram::c_iBuckets; i++)
+  {
+    if (rHistogram.m_uCounts[i] > 0)
+    {
+      m_pCounts[i].fetch_add(rHistogram.m_uCounts[i], std::memory_order_relaxed);
+    }
+  }
+  unsigned long long iMax = m_iMax.load(std::memory_order_relaxed);
+  while (iMax < rHistogram.m_iMax &&
+         !m_iMax.compare_exchange_weak(iMax, rHistogram.m_iMax, std::memory_order_relaxed))
+  {
+  }
+}
+
+test::Histogram test::SharedHistogram::histogram() const
+{
+  Histogram uHistogram;
+  for (unsigned i = 0; i < Histogram::c_iBuckets; i++)
+  {
+    uHistogram.m_uCounts[i] = m_pCounts[i].load(std::memory_order_relaxed);
+  }
+  uHistogram.m_iMax = m_iMax.load(std::memory_order_relaxed);
+  return uHistogram;
+}
+
+test::Histogram test::latency(const std::function<double(double)> &rCurve,
+                              const std::vector<double> &rPoints, unsigned iThreads)
+{
+  if (iThreads == 0)
+  {
+    iThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  iThreads = std::max(1u, std::min<unsigned>(iThreads, rPoints.size()));
+
+  SharedHistogram uShared;
+  auto uRun = [&rCurve, &rPoints, &uShared](std::size_t iBegin, std::size_t iEnd)
+  {
+    Histogram uLocal;
+    double dSum = 0.;
+    for (std::size_t i = iBegin; i < iEnd; i++)
+    {
+      long long iStart = NHistogram::now();
+      dSum += rCurve(rPoints[i]);
+      uLocal.record(NHistogram::now() - iStart);
+    }
+    keepAlive(dSum);
+    uShared.merge(uLocal);
+  };
+
+  std::vector<std::thread> uThreads;
+  std::size_t iBlock = (rPoints.size() + iThreads - 1) / iThreads;
+  for (unsigned t = 1; t < iThreads; t++)
+  {
+    std::size_t iBegin = std::min(t * iBlock, rPoints.size());
+    std::size_t iEnd = std::min(iBegin + iBlock, rPoints.size());
+    uThreads.emplace_back(uRun, iBegin, iEnd);
+  }
+  uRun(0, std::min(iBlock, rPoints.size()));
+  for (std::thread &rThread : uThreads)
+  {
+    rThread.join();
+  }
+  return uShared.histogram();
+}
+
+void test::printLatency(const std::vector<std::string> &rNames,
+                        const std::vector<Histogram> &rHistograms,
+                        const std::string &sTitle)
+{
+  assert(rNames.size() == rHistograms.size());
+
+  std::vector<std::vector<double>> uColumns(6);
+  for (unsigned i = 0; i < rHistograms.size(); i++)
+  {
+    const Histogram &rH = rHistograms[i];
+    uColumns[0].push_back(i);
+    uColumns[1].push_back(rH.count());
+    uColumns[2].push_back(rH.quantile(0.5));
+    uColumns[3].push_back(rH.quantile(0.99));
+    uColumns[4].push_back(rH.quantile(0.999));
+    uColumns[5].push_back(rH.max());
+  }
+  printTable(uColumns, {"curve", "calls", "p50 ns", "p99 ns", "p99.9 ns", "max ns"},
+             sTitle, 10, 4, rHistograms.size());
+  for (unsigned i = 0; i < rNames.size(); i++)
+  {
+    out() << "curve " << i << ": " << rNames[i] << endl;
+  }
+  out() << endl;
+}
@@ -0,0 +1,369 @@
+#include "test/History.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace test;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "the files of history are read without conversion on little-endian hosts");
+
+namespace NHistory
+{
+  const char c_sMagic[8] = {'V', 'E', 'G', 'A', 'H', 'S', 'T', '\0'};
+  const std::uint32_t c_iVersion = 1;
+  const std::size_t c_iHeader = 24;
+  // the window of the previous XOR is not defined
+  const unsigned char c_iNoWindow = 0xFF;
+
+  template <class T>
+  T get(const unsigned char *pData)
+  {
+    T iValue;
+    std::memcpy(&iValue, pData, sizeof(T));
+    return iValue;
+  }
+
+  std::uint64_t bits(double dX)
+  {
+    std::uint64_t iX;
+    std::memcpy(&iX, &dX, sizeof(double));
+    return iX;
+  }
+
+  double value(std::uint64_t iX)
+  {
+    double dX;
+    std::memcpy(&dX, &iX, sizeof(double));
+    return dX;
+  }
+
+  // appends iN lowest bits of iValue, 1 <= iN <= 64
+  void put(std::vector<std::uint64_t> &rWords, unsigned &rBit, std::uint64_t iValue, unsigned iN)
+  {
+    if (iN < 64)
+    {
+      iValue &= (std::uint64_t(1) << iN) - 1;
+    }
+    unsigned iWord = rBit / 64, iOffset = rBit % 64;
+    if (iWord + 2 > rWords.size())
+    {
+      rWords.resize(iWord + 2, 0);
+    }
+    rWords[iWord] |= iValue << iOffset;
+    if (iOffset + iN > 64)
+    {
+      rWords[iWord + 1] |= iValue >> (64 - iOffset);
+    }
+    rBit += iN;
+  }
+
+  // reads the bits written by put()
+  class BitReader
+  {
+  public:
+    BitReader(const unsigned char *pData, std::size_t iWords)
+        : m_pData(pData), m_iWords(iWords), m_iBit(0)
+    {
+    }
+
+    std::uint64_t get(unsigned iN)
+    {
+      unsigned iWord = m_iBit / 64, iOffset = m_iBit % 64;
+      std::uint64_t iValue = word(iWord) >> iOffset;
+      if (iOffset + iN > 64)
+      {
+        iValue |= word(iWord + 1) << (64 - iOffset);
+      }
+      m_iBit += iN;
+      return (iN < 64) ? iValue & ((std::uint64_t(1) << iN) - 1) : iValue;
+    }
+
+  private:
+    std::uint64_t word(std::size_t iWord) const
+    {
+      return (iWord < m_iWords) ? NHistory::get<std::uint64_t>(m_pData + 8 * iWord) : 0;
+    }
+
+    const unsigned char *m_pData;
+    std::size_t m_iWords;
+    std::size_t m_iBit;
+  };
+} // namespace NHistory
+
+test::HistoryWriter::HistoryWriter(const std::string &sFile, const std::vector<double> &rTimes,
+                                   unsigned iBlockDays)
+    : m_iQuotes(rTimes.size()), m_iBlockDays(iBlockDays), m_iDays(0), m_iBytes(0),
+      m_uPrevious(rTimes.size()), m_uLeading(rTimes.size()), m_uTrailing(rTimes.size()),
+      m_iBit(0)
+{
+  using namespace NHistory;
+  if (iBlockDays == 0)
+  {
+    throw std::runtime_error("a block of the history " + sFile + " has no days");
+  }
+
+  // an existing history is continued; the days of its last incomplete
+  // block are decoded and the block is written again with the new days
+  std::vector<std::vector<double>> uPartial;
+  struct stat uStat;
+  bool bAppend = (stat(sFile.c_str(), &uStat) == 0 && uStat.st_size > 0);
+  if (bAppend)
+  {
+    HistoryFile uHistory(sFile);
+    ColumnView uTimes = uHistory.times();
+    if (uHistory.m_iBlockDays != m_iBlockDays || uTimes.size() != m_iQuotes ||
+        !std::equal(uTimes.begin(), uTimes.end(), rTimes.begin()))
+    {
+      throw std::runtime_error("the history " + sFile + " has other times or days in a block");
+    }
+    m_iBytes = uHistory.m_iBytes;
+    std::size_t iPartial = uHistory.m_iDays % m_iBlockDays;
+    if (iPartial > 0)
+    {
+      m_iBytes = uHistory.m_uBlocks.back();
+      uHistory.values(uHistory.m_iDays - iPartial, uHistory.m_iDays,
+                      [&uPartial](std::size_t, const std::vector<double> &rValues)
+                      { uPartial.push_back(rValues); });
+    }
+  }
+  if (bAppend && truncate(sFile.c_str(), off_t(m_iBytes)) != 0)
+  {
+    throw std::runtime_error("cannot truncate the file " + sFile);
+  }
+  m_fOut.open(sFile.c_str(), bAppend ? std::ios::binary | std::ios::app : std::ios::binary);
+  if (!m_fOut)
+  {
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  if (!bAppend)
+  {
+    std::uint32_t uHeader[4] = {c_iVersion, m_iQuotes, m_iBlockDays, 0};
+    m_fOut.write(c_sMagic, 8);
+    m_fOut.write(reinterpret_cast<const char *>(uHeader), sizeof(uHeader));
+    m_fOut.write(reinterpret_cast<const char *>(rTimes.data()), rTimes.size() * sizeof(double));
+    m_iBytes = c_iHeader + rTimes.size() * sizeof(double);
+  }
+  for (const std::vector<double> &rValues : uPartial)
+  {
+    append(rValues);
+  }
+}
+
+test::HistoryWriter::~HistoryWriter()
+{
+  if (m_iDays > 0)
+  {
+    writeBlock();
+  }
+}
+
+void test::HistoryWriter::append(const std::vector<double> &rValues)
+{
+  using namespace NHistory;
+  assert(rValues.size() == m_iQuotes);
+
+  for (unsigned i = 0; i < m_iQuotes; i++)
+  {
+    std::uint64_t iX = bits(rValues[i]);
+    if (m_iDays == 0)
+    {
+      put(m_uBits, m_iBit, iX, 64);
+      m_uLeading[i] = c_iNoWindow;
+    }
+    else
+    {
+      std::uint64_t iXor = iX ^ m_uPrevious[i];
+      if (iXor == 0)
+      {
+        put(m_uBits, m_iBit, 0, 1);
+      }
+      else
+      {
+        unsigned iLeading = std::min(__builtin_clzll(iXor), 31);
+        unsigned iTrailing = __builtin_ctzll(iXor);
+        if (m_uLeading[i] != c_iNoWindow && iLeading >= m_uLeading[i] &&
+            iTrailing >= m_uTrailing[i])
+        {
+          // the bits 1, 0 and the bits inside the previous window
+          put(m_uBits, m_iBit, 1, 2);
+          put(m_uBits, m_iBit, iXor >> m_uTrailing[i], 64 - m_uLeading[i] - m_uTrailing[i]);
+        }
+        else
+        {
+          // the bits 1, 1, the new window and the bits inside it
+          unsigned iMeaningful = 64 - iLeading - iTrailing;
+          put(m_uBits, m_iBit, 3, 2);
+          put(m_uBits, m_iBit, iLeading, 5);
+          put(m_uBits, m_iBit, iMeaningful - 1, 6);
+          put(m_uBits, m_iBit, iXor >> iTrailing, iMeaningful);
+          m_uLeading[i] = iLeading;
+          m_uTrailing[i] = iTrailing;
+        }
+      }
+    }
+    m_uPrevious[i] = iX;
+  }
+  m_iDays++;
+  if (m_iDays == m_iBlockDays)
+  {
+    writeBlock();
+  }
+}
+
+std::size_t test::HistoryWriter::bytes() const
+{
+  return m_iBytes;
+}
+
+void test::HistoryWriter::writeBlock()
+{
+  std::uint32_t iWords = (m_iBit + 63) / 64;
+  std::uint32_t uHeader[2] = {m_iDays, iWords * 8};
+  m_uBits.resize(iWords);
+  m_fOut.write(reinterpret_cast<const char *>(uHeader), sizeof(uHeader));
+  m_fOut.write(reinterpret_cast<const char *>(m_uBits.data()), iWords * 8);
+  m_iBytes += sizeof(uHeader) + iWords * 8;
+
+  m_uBits.assign(m_uBits.size(), 0);
+  m_iBit = 0;
+  m_iDays = 0;
+}
+
+test::HistoryFile::HistoryFile(const std::string &sFile)
+    : m_pMap(nullptr), m_iBytes(0), m_iQuotes(0), m_iBlockDays(0), m_iDays(0)
+{
+  using namespace NHistory;
+
+  int iFd = open(sFile.c_str(), O_RDONLY);
+  struct stat uStat;
+  if (iFd < 0 || fstat(iFd, &uStat) != 0)
+  {
+    if (iFd >= 0)
+    {
+      close(iFd);
+    }
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  m_iBytes = std::size_t(uStat.st_size);
+  void *pMap = (m_iBytes > 0) ? mmap(nullptr, m_iBytes, PROT_READ, MAP_SHARED, iFd, 0) : MAP_FAILED;
+  close(iFd);
+  if (pMap == MAP_FAILED || m_iBytes < c_iHeader || std::memcmp(pMap, c_sMagic, 8) != 0 ||
+      get<std::uint32_t>(static_cast<const unsigned char *>(pMap) + 8) != c_iVersion)
+  {
+    if (pMap != MAP_FAILED)
+    {
+      munmap(pMap, m_iBytes);
+    }
+    throw std::runtime_error("the file " + sFile + " is not a history of version 1");
+  }
+  m_pMap = static_cast<const unsigned char *>(pMap);
+  m_iQuotes = get<std::uint32_t>(m_pMap + 12);
+  m_iBlockDays = get<std::uint32_t>(m_pMap + 16);
+
+  // the index of blocks; only the last block may be incomplete and
+  // the blocks end at the end of the file
+  std::size_t iOffset = c_iHeader + m_iQuotes * sizeof(double);
+  bool bValid = (m_iBlockDays > 0 && iOffset <= m_iBytes);
+  while (bValid && iOffset < m_iBytes)
+  {
+    std::uint32_t iDays = 0, iBytes = 0;
+    if (iOffset + 8 <= m_iBytes)
+    {
+      iDays = get<std::uint32_t>(m_pMap + iOffset);
+      iBytes = get<std::uint32_t>(m_pMap + iOffset + 4);
+    }
+    bValid = (iOffset + 8 <= m_iBytes && iOffset + 8 + iBytes <= m_iBytes && iBytes % 8 == 0 &&
+              iDays > 0 && iDays <= m_iBlockDays && (m_iDays % m_iBlockDays) == 0);
+    m_uBlocks.push_back(iOffset);
+    m_iDays += iDays;
+    iOffset += 8 + std::size_t(iBytes);
+  }
+  if (!bValid)
+  {
+    munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+    throw std::runtime_error("the history " + sFile + " is damaged");
+  }
+}
+
+test::HistoryFile::~HistoryFile()
+{
+  munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+}
+
+std::size_t test::HistoryFile::days() const
+{
+  return m_iDays;
+}
+
+test::ColumnView test::HistoryFile::times() const
+{
+  return ColumnView(reinterpret_cast<const double *>(m_pMap + NHistory::c_iHeader), m_iQuotes);
+}
+
+std::vector<double> test::HistoryFile::values(std::size_t iDay) const
+{
+  std::vector<double> uValues;
+  values(iDay, iDay + 1, [&uValues](std::size_t, const std::vector<double> &rValues)
+         { uValues = rValues; });
+  return uValues;
+}
+
+void test::HistoryFile::values(std::size_t iFirst, std::size_t iLast,
+                               const std::function<void(std::size_t, const std::vector<double> &)> &rF) const
+{
+  using namespace NHistory;
+  if (iFirst > iLast || iLast > m_iDays)
+  {
+    throw std::runtime_error("the days " + std::to_string(iFirst) + " to " + std::to_string(iLast) +
+                             " are not in the history of " + std::to_string(m_iDays) + " days");
+  }
+
+  std::vector<double> uValues(m_iQuotes);
+  std::vector<std::uint64_t> uPrevious(m_iQuotes);
+  std::vector<unsigned char> uLeading(m_iQuotes), uTrailing(m_iQuotes);
+  std::size_t iDay = iFirst - iFirst % m_iBlockDays;
+  while (iDay < iLast)
+  {
+    std::size_t iOffset = m_uBlocks[iDay / m_iBlockDays];
+    std::uint32_t iDays = get<std::uint32_t>(m_pMap + iOffset);
+    std::uint32_t iBytes = get<std::uint32_t>(m_pMap + iOffset + 4);
+    BitReader uBits(m_pMap + iOffset + 8, iBytes / 8);
+    for (std::uint32_t n = 0; n < iDays && iDay < iLast; n++, iDay++)
+    {
+      for (unsigned i = 0; i < m_iQuotes; i++)
+      {
+        if (n == 0)
+        {
+          uPrevious[i] = uBits.get(64);
+        }
+        else if (uBits.get(1))
+        {
+          if (uBits.get(1))
+          {
+            uLeading[i] = uBits.get(5);
+            unsigned iMeaningful = uBits.get(6) + 1;
+            if (uLeading[i] + iMeaningful > 64)
+            {
+              throw std::runtime_error("a block of the history is damaged");
+            }
+            uTrailing[i] = 64 - uLeading[i] - iMeaningful;
+          }
+          unsigned iMeaningful = 64 - uLeading[i] - uTrailing[i];
+          uPrevious[i] ^= uBits.get(iMeaningful) << uTrailing[i];
+        }
+        uValues[i] = value(uPrevious[i]);
+      }
+      if (iDay >= iFirst)
+      {
+        rF(iDay, uValues);
+      }
+    }
+  }
+}
@@ -1,5 +1,8 @@
 #include "test/Output.hpp"
 #include "test/Main.hpp"
+#include "test/Trace.hpp"
+#include <atomic>
+#include <thread>
 
 using namespace std;
 using namespace test;
@@ -35,12 +38,50 @@ void test::project(const std::function<void()> &rF, const std::string &sProjectD
                    const std::string &sFileName, const std::string &sTitle)
 {
   std::string sFile = fileName(OUTPUT_DIR, sProjectDir, sFileName);
-  std::ofstream fOut(sFile.c_str());
-  std::streambuf *strmBuffer = std::cout.rdbuf();
-  std::cout.rdbuf(fOut.rdbuf());
-  printAtStart(sTitle);
-  rF();
-  std::cout.rdbuf(strmBuffer);
+  {
+    Sink uSink(sFile);
+    SinkScope uScope(uSink);
+#ifdef VEGA_TRACE
+    // the curves built by the project are recorded in its own registry
+    vega::TraceRegistry uTrace;
+    vega::TraceRegistryScope uTraceScope(uTrace);
+#endif
+    printAtStart(sTitle);
+    rF();
+#ifdef VEGA_TRACE
+    printTrace("INSTRUMENTATION OF CURVES");
+    writeTrace(std::string(OUTPUT_DIR) + "/" + sProjectDir + "/" + sFileName + ".trace.json");
+#endif
+  }
   printAtEnd(sFile);
 }
 
+void test::runProjects(const std::vector<Job> &rJobs, unsigned iThreads)
+{
+  if (iThreads == 0)
+  {
+    iThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  iThreads = std::max(1u, std::min<unsigned>(iThreads, rJobs.size()));
+
+  std::atomic<std::size_t> iNext(0);
+  auto uWorker = [&rJobs, &iNext]()
+  {
+    for (std::size_t i = iNext++; i < rJobs.size(); i = iNext++)
+    {
+      const Job &rJob = rJobs[i];
+      project(rJob.run, rJob.dir, rJob.file, rJob.title);
+    }
+  };
+
+  std::vector<std::thread> uThreads;
+  for (unsigned t = 1; t < iThreads; t++)
+  {
+    uThreads.emplace_back(uWorker);
+  }
+  uWorker();
+  for (std::thread &rThread : uThreads)
+  {
+    rThread.join();
+  }
+}
@@ -0,0 +1,302 @@
+#include "test/Market.hpp"
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace test;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "the market files are read without conversion on little-endian hosts");
+
+namespace NMarket
+{
+  const char c_sMagic[8] = {'V', 'E', 'G', 'A', 'M', 'K', 'T', '\0'};
+  const std::uint32_t c_iVersion = 1;
+  const std::size_t c_iAlign = 64;
+  const std::size_t c_iHeader = 32;
+
+  std::size_t align(std::size_t iOffset)
+  {
+    return (iOffset + c_iAlign - 1) / c_iAlign * c_iAlign;
+  }
+
+  template <class T>
+  T get(const unsigned char *pData)
+  {
+    T iValue;
+    std::memcpy(&iValue, pData, sizeof(T));
+    return iValue;
+  }
+
+  // maps the whole file into memory; returns nullptr for an empty file
+  const unsigned char *map(const std::string &sFile, std::size_t &rBytes)
+  {
+    int iFd = open(sFile.c_str(), O_RDONLY);
+    struct stat uStat;
+    if (iFd < 0 || fstat(iFd, &uStat) != 0)
+    {
+      if (iFd >= 0)
+      {
+        close(iFd);
+      }
+      throw std::runtime_error("cannot open the file " + sFile);
+    }
+    rBytes = std::size_t(uStat.st_size);
+    void *pMap = (rBytes > 0) ? mmap(nullptr, rBytes, PROT_READ, MAP_SHARED, iFd, 0) : nullptr;
+    close(iFd);
+    if (pMap == MAP_FAILED)
+    {
+      throw std::runtime_error("cannot map the file " + sFile);
+    }
+    if (pMap)
+    {
+      madvise(pMap, rBytes, MADV_SEQUENTIAL);
+    }
+    return static_cast<const unsigned char *>(pMap);
+  }
+
+  // the offsets of the arrays of times, values and names in the
+  // binary file
+  void layout(std::size_t iCurves, std::size_t iPoints, std::size_t &rTimes,
+              std::size_t &rValues, std::size_t &rNames)
+  {
+    rTimes = align(c_iHeader + 2 * (iCurves + 1) * sizeof(std::uint64_t));
+    rValues = align(rTimes + iPoints * sizeof(double));
+    rNames = rValues + iPoints * sizeof(double);
+  }
+} // namespace NMarket
+
+test::MarketData::MarketData()
+    : m_uNames(1, 0), m_uOffsets(1, 0)
+{
+}
+
+void test::MarketData::push_back(const std::string &sName, const std::vector<double> &rTimes,
+                                 const std::vector<double> &rValues)
+{
+  assert(rTimes.size() == rValues.size());
+  assert(std::is_sorted(rTimes.begin(), rTimes.end()));
+
+  m_sNames.append(sName);
+  m_uNames.push_back(m_sNames.size());
+  m_uTimes.insert(m_uTimes.end(), rTimes.begin(), rTimes.end());
+  m_uValues.insert(m_uValues.end(), rValues.begin(), rValues.end());
+  m_uOffsets.push_back(m_uTimes.size());
+}
+
+std::size_t test::MarketData::size() const
+{
+  return m_uOffsets.size() - 1;
+}
+
+test::MarketCurve test::MarketData::curve(std::size_t iCurve) const
+{
+  assert(iCurve < size());
+  std::size_t iBegin = m_uOffsets[iCurve], iSize = m_uOffsets[iCurve + 1] - iBegin;
+  return MarketCurve{std::string_view(m_sNames.data() + m_uNames[iCurve],
+                                      m_uNames[iCurve + 1] - m_uNames[iCurve]),
+                     ColumnView(m_uTimes.data() + iBegin, iSize),
+                     ColumnView(m_uValues.data() + iBegin, iSize)};
+}
+
+test::MarketData test::readMarketCsv(const std::string &sFile)
+{
+  std::size_t iBytes = 0;
+  const char *pBegin = reinterpret_cast<const char *>(NMarket::map(sFile, iBytes));
+  const char *pEnd = pBegin + iBytes;
+
+  // one allocation of the arrays of points for the whole file
+  MarketData uData;
+  std::size_t iLines = std::count(pBegin, pEnd, '\n') + 1;
+  uData.m_uTimes.reserve(iLines);
+  uData.m_uValues.reserve(iLines);
+
+  std::string_view sCurve;
+  std::size_t iLine = 0;
+  for (const char *pLine = pBegin; pLine < pEnd; iLine++)
+  {
+    const char *pNext = static_cast<const char *>(std::memchr(pLine, '\n', pEnd - pLine));
+    pNext = (pNext) ? pNext : pEnd;
+    // the first line is the header
+    if (iLine > 0 && pNext > pLine)
+    {
+      // the time and the value fill their fields up to the end of line
+      const char *pComma = static_cast<const char *>(std::memchr(pLine, ',', pNext - pLine));
+      double dTime, dValue;
+      std::from_chars_result uTime{pLine, std::errc::invalid_argument};
+      std::from_chars_result uValue{pLine, std::errc::invalid_argument};
+      if (pComma)
+      {
+        uTime = std::from_chars(pComma + 1, pNext, dTime);
+      }
+      if (uTime.ec == std::errc() && uTime.ptr < pNext && *uTime.ptr == ',')
+      {
+        uValue = std::from_chars(uTime.ptr + 1, pNext, dValue);
+      }
+      if (uValue.ec != std::errc() || uValue.ptr != pNext)
+      {
+        munmap(const_cast<char *>(pBegin), iBytes);
+        throw std::runtime_error("wrong line " + std::to_string(iLine + 1) + " of the file " +
+                                 sFile + "; expected \"curve,time,value\"");
+      }
+      std::string_view sName(pLine, pComma - pLine);
+      if (uData.size() == 0 || sName != sCurve)
+      {
+        uData.m_sNames.append(sName);
+        uData.m_uNames.push_back(uData.m_sNames.size());
+        uData.m_uOffsets.push_back(uData.m_uTimes.size());
+        sCurve = sName;
+      }
+      else if (dTime <= uData.m_uTimes.back())
+      {
+        munmap(const_cast<char *>(pBegin), iBytes);
+        throw std::runtime_error("times do not increase in line " + std::to_string(iLine + 1) +
+                                 " of the file " + sFile);
+      }
+      uData.m_uTimes.push_back(dTime);
+      uData.m_uValues.push_back(dValue);
+      uData.m_uOffsets.back()++;
+    }
+    pLine = pNext + 1;
+  }
+  if (pBegin)
+  {
+    munmap(const_cast<char *>(pBegin), iBytes);
+  }
+  return uData;
+}
+
+void test::writeMarketCsv(const std::string &sFile, const MarketData &rData)
+{
+  std::ofstream fOut(sFile.c_str(), std::ios::binary);
+  if (!fOut)
+  {
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  std::string sBuffer("curve,time,value\n");
+  char sNumber[32];
+  for (std::size_t i = 0; i < rData.size(); i++)
+  {
+    MarketCurve uCurve = rData.curve(i);
+    for (std::size_t j = 0; j < uCurve.times.size(); j++)
+    {
+      sBuffer.append(uCurve.name);
+      sBuffer.push_back(',');
+      sBuffer.append(sNumber, std::to_chars(sNumber, sNumber + 32, uCurve.times[j]).ptr);
+      sBuffer.push_back(',');
+      sBuffer.append(sNumber, std::to_chars(sNumber, sNumber + 32, uCurve.values[j]).ptr);
+      sBuffer.push_back('\n');
+    }
+    if (sBuffer.size() > (1u << 16))
+    {
+      fOut.write(sBuffer.data(), sBuffer.size());
+      sBuffer.clear();
+    }
+  }
+  fOut.write(sBuffer.data(), sBuffer.size());
+}
+
+void test::writeMarket(const std::string &sFile, const MarketData &rData)
+{
+  using namespace NMarket;
+
+  std::size_t iCurves = rData.size(), iPoints = rData.m_uTimes.size();
+  std::size_t iTimes, iValues, iNames;
+  layout(iCurves, iPoints, iTimes, iValues, iNames);
+
+  std::vector<char> uHeader(iTimes, '\0');
+  std::uint32_t uVersion[2] = {c_iVersion, std::uint32_t(iCurves)};
+  std::uint64_t uSizes[2] = {iPoints, rData.m_sNames.size()};
+  std::memcpy(uHeader.data(), c_sMagic, 8);
+  std::memcpy(uHeader.data() + 8, uVersion, sizeof(uVersion));
+  std::memcpy(uHeader.data() + 16, uSizes, sizeof(uSizes));
+  std::vector<std::uint64_t> uOffsets(rData.m_uOffsets.begin(), rData.m_uOffsets.end());
+  uOffsets.insert(uOffsets.end(), rData.m_uNames.begin(), rData.m_uNames.end());
+  std::memcpy(uHeader.data() + c_iHeader, uOffsets.data(), uOffsets.size() * sizeof(std::uint64_t));
+
+  std::ofstream fOut(sFile.c_str(), std::ios::binary);
+  if (!fOut)
+  {
+    throw std::runtime_error("cannot open the file " + sFile);
+  }
+  std::vector<char> uPad(c_iAlign, '\0');
+  fOut.write(uHeader.data(), uHeader.size());
+  fOut.write(reinterpret_cast<const char *>(rData.m_uTimes.data()), iPoints * sizeof(double));
+  fOut.write(uPad.data(), iValues - iTimes - iPoints * sizeof(double));
+  fOut.write(reinterpret_cast<const char *>(rData.m_uValues.data()), iPoints * sizeof(double));
+  fOut.write(rData.m_sNames.data(), rData.m_sNames.size());
+}
+
+test::MarketFile::MarketFile(const std::string &sFile)
+    : m_pMap(nullptr), m_iBytes(0), m_iCurves(0)
+{
+  using namespace NMarket;
+
+  m_pMap = map(sFile, m_iBytes);
+  bool bValid = (m_iBytes >= c_iHeader) && (std::memcmp(m_pMap, c_sMagic, 8) == 0) &&
+                (get<std::uint32_t>(m_pMap + 8) == c_iVersion);
+  if (bValid)
+  {
+    m_iCurves = get<std::uint32_t>(m_pMap + 12);
+    std::size_t iPoints = get<std::uint64_t>(m_pMap + 16);
+    std::size_t iNameChars = get<std::uint64_t>(m_pMap + 24);
+    std::size_t iTimes, iValues, iNames;
+    // the sizes are bounded by the file before the layout is computed
+    bValid = (iPoints <= m_iBytes / sizeof(double) && iNameChars <= m_iBytes);
+    if (bValid)
+    {
+      layout(m_iCurves, iPoints, iTimes, iValues, iNames);
+      bValid = (iNames + iNameChars <= m_iBytes);
+    }
+    if (bValid)
+    {
+      m_pOffsets = reinterpret_cast<const std::uint64_t *>(m_pMap + c_iHeader);
+      m_pNames = m_pOffsets + m_iCurves + 1;
+      m_pTimes = reinterpret_cast<const double *>(m_pMap + iTimes);
+      m_pValues = reinterpret_cast<const double *>(m_pMap + iValues);
+      m_pNameChars = reinterpret_cast<const char *>(m_pMap + iNames);
+      // the tables of offsets increase from zero to the sizes of the
+      // arrays of points and of names
+      bValid = (m_pOffsets[0] == 0 && m_pOffsets[m_iCurves] == iPoints &&
+                std::is_sorted(m_pOffsets, m_pOffsets + m_iCurves + 1) && m_pNames[0] == 0 &&
+                m_pNames[m_iCurves] == iNameChars &&
+                std::is_sorted(m_pNames, m_pNames + m_iCurves + 1));
+    }
+  }
+  if (!bValid)
+  {
+    if (m_pMap)
+    {
+      munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+    }
+    throw std::runtime_error("the file " + sFile + " is not a market file of version 1");
+  }
+}
+
+test::MarketFile::~MarketFile()
+{
+  munmap(const_cast<unsigned char *>(m_pMap), m_iBytes);
+}
+
+std::size_t test::MarketFile::size() const
+{
+  return m_iCurves;
+}
+
+test::MarketCurve test::MarketFile::curve(std::size_t iCurve) const
+{
+  assert(iCurve < m_iCurves);
+  std::size_t iBegin = m_pOffsets[iCurve], iSize = m_pOffsets[iCurve + 1] - iBegin;
+  return MarketCurve{std::string_view(m_pNameChars + m_pNames[iCurve],
+                                      m_pNames[iCurve + 1] - m_pNames[iCurve]),
+                     ColumnView(m_pTimes + iBegin, iSize),
+                     ColumnView(m_pValues + iBegin, iSize)};
+}
@@ -3,6 +3,7 @@
 #include "test/Output.hpp"
 #include "test/Data.hpp"
 #include "test/Print.hpp"
+#include "test/Table.hpp"
 
 using namespace std;
 using namespace test;
@@ -63,36 +64,47 @@ void test::compare(const std::valarray<double> &rExact,
   printTable(uResults, uHeads, rTitle, iColumn, iSpace, iMaxRows);
 }
 
-void test::print(double dValue, const std::string &sMessage, bool bExtraLine)
+void test::print(Sink &rSink, double dValue, const std::string &sMessage, bool bExtraLine)
 {
   std::string sM(sMessage);
   sM += std::string(" = ");
-  std::cout << sM.c_str() << dValue << endl;
+  rSink.stream() << sM.c_str() << dValue << endl;
   if (bExtraLine)
   {
-    std::cout << endl;
+    rSink.stream() << endl;
   }
 }
 
+void test::print(double dValue, const std::string &sMessage, bool bExtraLine)
+{
+  print(sink(), dValue, sMessage, bExtraLine);
+}
+
+void test::print(Sink &rSink, const std::string &sMessage)
+{
+  rSink.stream() << sMessage.c_str() << endl
+                 << endl;
+}
+
 void test::print(const std::string &sMessage)
 {
-  std::cout << sMessage.c_str() << endl
-            << endl;
+  print(sink(), sMessage);
 }
 
-void test::printTable(const std::vector<std::valarray<double>> &rValues,
+void test::printTable(Sink &rSink, const std::vector<std::valarray<double>> &rValues,
                       const std::vector<std::string> &rNames,
                       const std::string &sMessage, unsigned iColumn,
                       unsigned iSpace, unsigned iMaxRows)
 {
   assert(rValues.size() == rNames.size());
   
-  print(sMessage);
+  print(rSink, sMessage);
+  TableWriter uOut(rSink.stream());
   for (unsigned i = 0; i < rValues.size(); i++)
   {
-    std::cout << std::setw(iColumn) << rNames[i].c_str() << std::setw(iSpace) << "";
+    uOut.cell(rNames[i], iColumn).space(iSpace);
   }
-  std::cout << endl;
+  uOut.endRow();
 
   unsigned iSize = rValues.front().size();
   unsigned iRows = std::min(iSize, iMaxRows);
@@ -105,14 +117,22 @@ void test::printTable(const std::vector<std::valarray<double>> &rValues,
     for (unsigned i = 0; i < rValues.size(); i++)
     {
       assert(rValues[i].size() == iSize);
-      std::cout << std::setw(iColumn) << rValues[i][j] << std::setw(iSpace) << "";
+      uOut.cell(rValues[i][j], iColumn).space(iSpace);
     }
-    std::cout << endl;
+    uOut.endRow();
   }
-  std::cout << std::endl;
+  uOut.endRow();
 }
 
-void test::printTable(const std::vector<std::vector<double>> &rValues,
+void test::printTable(const std::vector<std::valarray<double>> &rValues,
+                      const std::vector<std::string> &rNames,
+                      const std::string &sMessage, unsigned iColumn,
+                      unsigned iSpace, unsigned iMaxRows)
+{
+  printTable(sink(), rValues, rNames, sMessage, iColumn, iSpace, iMaxRows);
+}
+
+void test::printTable(Sink &rSink, const std::vector<std::vector<double>> &rValues,
                       const std::vector<std::string> &rNames,
                       const std::string &sMessage, unsigned iColumn,
                       unsigned iSpace, unsigned iMaxRows)
@@ -123,7 +143,15 @@ void test::printTable(const std::vector<std::vector<double>> &rValues,
   {
     std::copy(rValues[i].begin(), rValues[i].end(), begin(uV[i]));
   }
-  printTable(uV, rNames, sMessage, iColumn, iSpace, iMaxRows);
+  printTable(rSink, uV, rNames, sMessage, iColumn, iSpace, iMaxRows);
+}
+
+void test::printTable(const std::vector<std::vector<double>> &rValues,
+                      const std::vector<std::string> &rNames,
+                      const std::string &sMessage, unsigned iColumn,
+                      unsigned iSpace, unsigned iMaxRows)
+{
+  printTable(sink(), rValues, rNames, sMessage, iColumn, iSpace, iMaxRows);
 }
 
 namespace testPrint
@@ -143,5 +171,5 @@ namespace testPrint
 void test::printCashFlow(const CashFlow &rCashFlow, const std::string &rName)
 {
   testPrint::print(rCashFlow, rName);
-  cout << endl;
+  out() << endl;
 }
@@ -0,0 +1,52 @@
+#include "test/Sink.hpp"
+
+using namespace std;
+using namespace test;
+
+namespace NSink
+{
+  // the current sink of the thread; nullptr means the console
+  thread_local Sink *g_pCurrent = nullptr;
+
+  Sink &console()
+  {
+    static Sink uConsole(std::cout);
+    return uConsole;
+  }
+} // namespace NSink
+
+test::Sink::Sink(std::ostream &rOut)
+    : m_pOut(&rOut)
+{
+}
+
+test::Sink::Sink(const std::string &sFile)
+    : m_pFile(new std::ofstream(sFile.c_str())), m_pOut(m_pFile.get())
+{
+}
+
+std::ostream &test::Sink::stream()
+{
+  return *m_pOut;
+}
+
+test::Sink &test::sink()
+{
+  return (NSink::g_pCurrent) ? *NSink::g_pCurrent : NSink::console();
+}
+
+std::ostream &test::out()
+{
+  return sink().stream();
+}
+
+test::SinkScope::SinkScope(Sink &rSink)
+    : m_pPrevious(NSink::g_pCurrent)
+{
+  NSink::g_pCurrent = &rSink;
+}
+
+test::SinkScope::~SinkScope()
+{
+  NSink::g_pCurrent = m_pPrevious;
+}
@@ -0,0 +1,148 @@
+#include "test/Table.hpp"
+#include <cassert>
+#include <charconv>
+#include <cstring>
+
+using namespace std;
+using namespace test;
+
+namespace NTable
+{
+  // the size of the buffer passed to the stream at once
+  const std::size_t c_iBuffer = 1 << 16;
+  // enough for a number in the general format with any precision
+  const std::size_t c_iNumber = 64;
+} // namespace NTable
+
+test::TableWriter::TableWriter(std::ostream &rOut, TableFormat eFormat)
+    : m_rOut(rOut), m_eFormat(eFormat), m_iPrecision(int(rOut.precision())),
+      m_uBuffer(NTable::c_iBuffer), m_iSize(0), m_bRowStart(true)
+{
+}
+
+test::TableWriter::~TableWriter()
+{
+  flush();
+}
+
+void test::TableWriter::reserve(std::size_t iN)
+{
+  if (m_iSize + iN > m_uBuffer.size())
+  {
+    m_rOut.write(m_uBuffer.data(), m_iSize);
+    m_iSize = 0;
+    if (iN > m_uBuffer.size())
+    {
+      m_uBuffer.resize(iN);
+    }
+  }
+}
+
+void test::TableWriter::separate()
+{
+  if (m_eFormat == TableFormat::csv && !m_bRowStart)
+  {
+    reserve(1);
+    m_uBuffer[m_iSize++] = ',';
+  }
+  m_bRowStart = false;
+}
+
+test::TableWriter &test::TableWriter::cell(double dValue, unsigned iWidth)
+{
+  separate();
+  char sNumber[NTable::c_iNumber];
+  std::to_chars_result uR = std::to_chars(sNumber, sNumber + NTable::c_iNumber, dValue,
+                                          std::chars_format::general, m_iPrecision);
+  assert(uR.ec == std::errc());
+  std::size_t iLength = uR.ptr - sNumber;
+  std::size_t iPad = (m_eFormat == TableFormat::fixed && iWidth > iLength) ? iWidth - iLength : 0;
+  reserve(iPad + iLength);
+  std::memset(m_uBuffer.data() + m_iSize, ' ', iPad);
+  std::memcpy(m_uBuffer.data() + m_iSize + iPad, sNumber, iLength);
+  m_iSize += iPad + iLength;
+  return *this;
+}
+
+test::TableWriter &test::TableWriter::cell(const std::string &sValue, unsigned iWidth)
+{
+  separate();
+  std::size_t iLength = sValue.size();
+  std::size_t iPad = (m_eFormat == TableFormat::fixed && iWidth > iLength) ? iWidth - iLength : 0;
+  reserve(iPad + iLength);
+  std::memset(m_uBuffer.data() + m_iSize, ' ', iPad);
+  std::memcpy(m_uBuffer.data() + m_iSize + iPad, sValue.data(), iLength);
+  m_iSize += iPad + iLength;
+  return *this;
+}
+
+test::TableWriter &test::TableWriter::space(unsigned iWidth)
+{
+  if (m_eFormat == TableFormat::fixed)
+  {
+    reserve(iWidth);
+    std::memset(m_uBuffer.data() + m_iSize, ' ', iWidth);
+    m_iSize += iWidth;
+  }
+  return *this;
+}
+
+test::TableWriter &test::TableWriter::endRow()
+{
+  reserve(1);
+  m_uBuffer[m_iSize++] = '\n';
+  m_bRowStart = true;
+  return *this;
+}
+
+void test::TableWriter::flush()
+{
+  m_rOut.write(m_uBuffer.data(), m_iSize);
+  m_iSize = 0;
+  m_rOut.flush();
+}
+
+void test::writeTable(std::ostream &rOut,
+                      const std::vector<std::valarray<double>> &rValues,
+                      const std::vector<std::string> &rNames,
+                      TableFormat eFormat, unsigned iColumn, unsigned iSpace)
+{
+  assert(rValues.size() == rNames.size());
+
+  TableWriter uOut(rOut, eFormat);
+  for (const std::string &sName : rNames)
+  {
+    uOut.cell(sName, iColumn).space(iSpace);
+  }
+  uOut.endRow();
+
+  std::size_t iSize = rValues.empty() ? 0 : rValues.front().size();
+  for (std::size_t j = 0; j < iSize; j++)
+  {
+    for (const std::valarray<double> &rColumn : rValues)
+    {
+      assert(rColumn.size() == iSize);
+      uOut.cell(rColumn[j], iColumn).space(iSpace);
+    }
+    uOut.endRow();
+  }
+}
+
+void test::writeCurve(std::ostream &rOut, const std::function<double(double)> &rData,
+                      double dStartTime, double dInterval, unsigned iPoints,
+                      TableFormat eFormat)
+{
+  unsigned iSize = (dInterval == 0.) ? 1 : iPoints;
+  unsigned iTime = 8;
+  unsigned iSpace = 6;
+  unsigned iValue = 10;
+
+  double dPeriod = dInterval / (iSize + 0.25);
+  TableWriter uOut(rOut, eFormat);
+  uOut.cell("time", iTime).space(iSpace).cell("value", iValue).endRow();
+  for (unsigned i = 0; i < iSize + 1; i++)
+  {
+    double dTime = dStartTime + i * dPeriod;
+    uOut.cell(dTime, iTime).space(iSpace).cell(rData(dTime), iValue).endRow();
+  }
+}
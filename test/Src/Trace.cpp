@@ -0,0 +1,69 @@
+#include "test/Trace.hpp"
+
+#ifdef VEGA_TRACE
+
+#include "test/Print.hpp"
+#include <algorithm>
+
+using namespace std;
+using namespace test;
+
+void test::printTrace(const std::string &sTitle)
+{
+  vega::TraceRegistry &rRegistry = vega::traceRegistry();
+  std::lock_guard<std::mutex> uLock(rRegistry.mutex);
+  if (rRegistry.nodes.empty())
+  {
+    return;
+  }
+
+  std::vector<const vega::TraceNode *> uNodes;
+  for (const vega::TraceNode &rNode : rRegistry.nodes)
+  {
+    uNodes.push_back(&rNode);
+  }
+  std::stable_sort(uNodes.begin(), uNodes.end(),
+                   [](const vega::TraceNode *pX, const vega::TraceNode *pY)
+                   { return pX->inclusive > pY->inclusive; });
+
+  std::vector<std::vector<double>> uColumns(5);
+  for (unsigned i = 0; i < uNodes.size(); i++)
+  {
+    double dCalls = uNodes[i]->calls;
+    uColumns[0].push_back(i);
+    uColumns[1].push_back(dCalls);
+    uColumns[2].push_back(1E-6 * uNodes[i]->inclusive);
+    uColumns[3].push_back(1E-6 * uNodes[i]->exclusive);
+    uColumns[4].push_back((dCalls > 0) ? uNodes[i]->inner / dCalls : 0.);
+  }
+  printTable(uColumns, {"node", "calls", "incl ms", "excl ms", "fan-out"},
+             sTitle, 12, 4, uNodes.size());
+  for (unsigned i = 0; i < uNodes.size(); i++)
+  {
+    out() << "node " << i << ": " << uNodes[i]->name << endl;
+  }
+  out() << endl;
+}
+
+void test::writeTrace(const std::string &sFile)
+{
+  vega::TraceRegistry &rRegistry = vega::traceRegistry();
+  std::lock_guard<std::mutex> uLock(rRegistry.mutex);
+  std::ofstream fOut(sFile.c_str());
+  fOut << std::setprecision(15);
+  fOut << "{\"traceEvents\": [";
+  for (std::size_t i = 0; i < rRegistry.size(); i++)
+  {
+    const vega::TraceEvent &rE = rRegistry.events[i];
+    fOut << ((i > 0) ? "," : "") << "\n  {"
+         << "\"name\": \"" << rE.node->name << "\", "
+         << "\"ph\": \"X\", "
+         << "\"ts\": " << 1E-3 * rE.start << ", "
+         << "\"dur\": " << 1E-3 * rE.duration << ", "
+         << "\"pid\": 1, "
+         << "\"tid\": " << rE.thread << "}";
+  }
+  fOut << "\n], \"displayTimeUnit\": \"ns\"}\n";
+}
+
+#endif // of VEGA_TRACE
@@ -0,0 +1,157 @@
+#ifndef __test_all_Table_hpp__
+#define __test_all_Table_hpp__
+
+/**
+ * @file Table.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Buffered output of tables.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <valarray>
+#include <vector>
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Table Buffered output of tables.
+   *
+   * This module formats tables of numbers by std::to_chars into a
+   * large buffer that is passed to the output stream in big pieces.
+   * The fixed-width format coincides with the output of
+   * \p std::setw and \p operator<< with the precision of the stream.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The format of a table.
+   */
+  enum class TableFormat
+  {
+    /** Right-aligned columns of given widths. */
+    fixed,
+    /** Comma-separated values; widths and spaces are ignored. */
+    csv
+  };
+
+  /**
+   * @brief The buffered writer of tables.
+   */
+  class TableWriter
+  {
+  public:
+    /**
+     * Constructs the writer. Numbers are printed in the general
+     * format with the precision of \p rOut.
+     *
+     * @param rOut The output stream.
+     * @param eFormat The format of the table.
+     */
+    explicit TableWriter(std::ostream &rOut,
+                         TableFormat eFormat = TableFormat::fixed);
+
+    /**
+     * Writes the rest of the buffer to the stream.
+     */
+    ~TableWriter();
+
+    TableWriter(const TableWriter &) = delete;
+    TableWriter &operator=(const TableWriter &) = delete;
+
+    /**
+     * Writes a number.
+     *
+     * @param dValue The number.
+     * @param iWidth The minimal width; the number is right-aligned.
+     * @return The writer.
+     */
+    TableWriter &cell(double dValue, unsigned iWidth = 0);
+
+    /**
+     * Writes a string.
+     *
+     * @param sValue The string.
+     * @param iWidth The minimal width; the string is right-aligned.
+     * @return The writer.
+     */
+    TableWriter &cell(const std::string &sValue, unsigned iWidth = 0);
+
+    /**
+     * Writes \p iWidth spaces in the fixed-width format.
+     *
+     * @param iWidth The number of spaces.
+     * @return The writer.
+     */
+    TableWriter &space(unsigned iWidth);
+
+    /**
+     * Ends the row.
+     *
+     * @return The writer.
+     */
+    TableWriter &endRow();
+
+    /**
+     * Writes the buffer to the stream and flushes the stream.
+     */
+    void flush();
+
+  private:
+    void reserve(std::size_t iN);
+    void separate();
+
+    std::ostream &m_rOut;
+    TableFormat m_eFormat;
+    int m_iPrecision;
+    std::vector<char> m_uBuffer;
+    std::size_t m_iSize;
+    bool m_bRowStart;
+  };
+
+  /**
+   * Writes the full table: the row of names followed by all rows of
+   * values.
+   *
+   * @param rOut The output stream.
+   * @param rValues The vector of columns of the table.
+   * @param rNames The vector of titles of the columns.
+   * @param eFormat The format of the table.
+   * @param iColumn The width of a column in the fixed-width format.
+   * @param iSpace The space between the columns in the fixed-width
+   * format.
+   */
+  void writeTable(std::ostream &rOut,
+                  const std::vector<std::valarray<double>> &rValues,
+                  const std::vector<std::string> &rNames,
+                  TableFormat eFormat = TableFormat::csv,
+                  unsigned iColumn = 10, unsigned iSpace = 6);
+
+  /**
+   * Writes the values of a data curve row by row without storing
+   * them. The times are the same as in print(const
+   * std::function<double(double)> &, double, double, unsigned).
+   *
+   * @param rOut The output stream.
+   * @param rData The data curve.
+   * @param dStartTime The initial time.
+   * @param dInterval The length of the interval.
+   * @param iPoints The number of points in the output.
+   * @param eFormat The format of the table.
+   */
+  void writeCurve(std::ostream &rOut, const std::function<double(double)> &rData,
+                  double dStartTime, double dInterval, unsigned iPoints,
+                  TableFormat eFormat = TableFormat::csv);
+
+  /** @} */
+} // namespace test
+
+#endif // of __test_all_Table_hpp__
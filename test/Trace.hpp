@@ -0,0 +1,59 @@
+#ifndef __test_all_Trace_hpp__
+#define __test_all_Trace_hpp__
+
+/**
+ * @file Trace.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Reports of the instrumentation of curves.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "vega/trace.hpp"
+#include <string>
+
+#ifdef VEGA_TRACE
+
+namespace test
+{
+  /**
+   *
+   * @defgroup test_all_Trace Reports of the instrumentation of curves.
+   *
+   * This module prints the statistics collected by VEGA_TRACE_CURVE()
+   * and writes the calls of curves in the format of Chrome trace
+   * (chrome://tracing, Perfetto). The functions report the current
+   * registry of the calling thread, which project() sets to a new
+   * registry for every project. The functions exist only if the
+   * macro VEGA_TRACE is defined; then they are called by project().
+   *
+   * @{
+   */
+
+  /**
+   * Prints the table of curve nodes sorted by the inclusive time with
+   * columns "node", "calls", "incl ms", "excl ms" and "fan-out"
+   * (the average number of inner calls per call) followed by the
+   * names of the nodes.
+   *
+   * @param sTitle The title of the table.
+   */
+  void printTrace(const std::string &sTitle);
+
+  /**
+   * Writes the recorded calls of curves to a file in the JSON format
+   * of Chrome trace.
+   *
+   * @param sFile The name of the output file.
+   */
+  void writeTrace(const std::string &sFile);
+
+  /** @} */
+} // namespace test
+
+#endif // of VEGA_TRACE
+
+#endif // of __test_all_Trace_hpp__
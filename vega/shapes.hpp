@@ -0,0 +1,172 @@
+#ifndef __vega_shapes_hpp__
+#define __vega_shapes_hpp__
+
+/**
+ * @file shapes.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Shapes of yield curves from one exponential
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cassert>
+#include <cmath>
+
+namespace vega
+{
+  /**
+   * @defgroup vegaShapes Shapes of yield curves.
+   *
+   * The Vasicek, Nelson-Siegel, Svensson, Black and Hull-White curves
+   * are combinations of the shapes \f$\frac{1-e^{-x}}{x}\f$,
+   * \f$\frac{1-e^{-x}(1+x)}{x}\f$ and \f$\frac{1-e^{-2x}}{2x}\f$ at
+   * the same argument. This module computes all of them from the
+   * single exponential \f$e^{-x}\f$.
+   *
+   * @{
+   */
+
+  /**
+   * @brief The values of the shapes of yield curves at the same
+   * argument \f$x\geq 0\f$.
+   */
+  class ShapeValues
+  {
+  public:
+    /**
+     * \f$\frac{1-e^{-x}}{x}\f$.
+     */
+    double shape1;
+
+    /**
+     * \f$\frac{1-e^{-x}(1+x)}{x}\f$.
+     */
+    double shape2;
+
+    /**
+     * \f$\frac{1-e^{-2x}}{2x}\f$.
+     */
+    double shape1Of2x;
+  };
+
+  /**
+   * The argument below which shape1() is computed by its Taylor
+   * polynomial.
+   */
+  const double c_dShape1Series = 1E-3;
+
+  /**
+   * The argument below which shape2 is computed by its Taylor
+   * polynomial.
+   */
+  const double c_dShape2Series = 0.1;
+
+  /**
+   * @brief The shapes of yield curves.
+   *
+   * The formulas lose accuracy for small \f$x\f$: the cancellation in
+   * \f$1-e^{-x}\f$ costs \f$1.2\cdot 10^{-16}/x\f$ of relative
+   * accuracy of shape1 and the cancellation in
+   * \f$1-e^{-x}(1+x)\f$ costs \f$4.5\cdot 10^{-16}/x^2\f$ of
+   * relative accuracy of shape2. Below \f$10^{-3}\f$ for shape1 and
+   * below \f$0.1\f$ for shape2 the shapes are computed by their
+   * Taylor polynomials, so the relative errors of all shapes are
+   * below \f$2\cdot 10^{-13}\f$.
+   */
+  class Shapes
+  {
+  public:
+    /**
+     * Computes \f$\frac{1-e^{-x}}{x}\f$, \f$x\geq 0\f$, as shape1()
+     * of the builders.
+     *
+     * @param dX The argument.
+     * @return The value of the shape.
+     */
+    static double shape1(double dX)
+    {
+      assert(dX >= 0);
+      if (dX < c_dShape1Series)
+      {
+        return 1. - dX * (1. / 2. - dX * (1. / 6. - dX * (1. / 24. - dX * (1. / 120. - dX / 720.))));
+      }
+      return (1 - std::exp(-dX)) / dX;
+    }
+
+    /**
+     * Computes \f$\frac{1-e^{-2x}}{2x}\f$, \f$x\geq 0\f$, by one
+     * exponential and without the other shapes.
+     *
+     * @param dX The argument.
+     * @return The value of the shape.
+     */
+    static double shape1Of2x(double dX)
+    {
+      return shape1(2. * dX);
+    }
+
+    /**
+     * Computes \f$\frac{1-e^{-x}(1+x)}{x}\f$, \f$x\geq 0\f$, as
+     * shape2() of the builders.
+     *
+     * @param dX The argument.
+     * @return The value of the shape.
+     */
+    static double shape2(double dX)
+    {
+      assert(dX >= 0);
+      if (dX < c_dShape2Series)
+      {
+        return shape2Series(dX);
+      }
+      return (1 - std::exp(-dX) * (1. + dX)) / dX;
+    }
+
+    /**
+     * Computes the shapes shape1(x), shape2(x) and shape1(2x) from the
+     * single exponential \f$e^{-x}\f$, since
+     * \f$1-e^{-2x} = (1-e^{-x})(1+e^{-x})\f$.
+     *
+     * @param dX The argument \f$x\geq 0\f$.
+     * @return The values of the shapes.
+     */
+    static ShapeValues values(double dX)
+    {
+      assert(dX >= 0);
+      if (dX < c_dShape1Series)
+      {
+        return ShapeValues{shape1(dX), shape2Series(dX), shape1(2. * dX)};
+      }
+      double dE = std::exp(-dX);
+      double dShape1 = (1 - dE) / dX;
+      double dShape2 = (dX < c_dShape2Series) ? shape2Series(dX) : (1 - dE * (1. + dX)) / dX;
+      return ShapeValues{dShape1, dShape2, dShape1 * (1. + dE) / 2.};
+    }
+
+  private:
+    // the Taylor polynomial of shape2 of degree 11:
+    // sum_{k>=0} (-1)^k (k+1) x^{k+1} / (k+2)!
+    static double shape2Series(double dX)
+    {
+      double dP = 1. / 43545600.;
+      dP = 1. / 3991680. - dX * dP;
+      dP = 1. / 403200. - dX * dP;
+      dP = 1. / 45360. - dX * dP;
+      dP = 1. / 5760. - dX * dP;
+      dP = 1. / 840. - dX * dP;
+      dP = 1. / 144. - dX * dP;
+      dP = 1. / 30. - dX * dP;
+      dP = 1. / 8. - dX * dP;
+      dP = 1. / 3. - dX * dP;
+      dP = 1. / 2. - dX * dP;
+      return dX * dP;
+    }
+  };
+
+  /** @} */
+} // namespace vega
+
+#endif // of __vega_shapes_hpp__
@@ -0,0 +1,335 @@
+#ifndef __vega_trace_hpp__
+#define __vega_trace_hpp__
+
+/**
+ * @file trace.hpp
+ * @author Vyacheslav Chekmenev
+ * @brief Instrumentation of curves
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/**
+ * @defgroup vegaTrace Instrumentation of curves.
+ *
+ * The builders of curves wrap the returned functions into
+ * VEGA_TRACE_CURVE(). If the macro VEGA_TRACE is defined (the CMake
+ * option VEGA_TRACE), then every call of a curve is recorded: the
+ * number of calls, the inclusive and exclusive times and the number
+ * of calls of inner curves. The statistics are collected per curve
+ * node, that is, per name of the builder. Otherwise, VEGA_TRACE_CURVE()
+ * returns its argument and the instrumentation compiles to nothing.
+ *
+ * The nodes belong to a registry. A curve is bound to the current
+ * registry of the thread that builds it, which is set by
+ * TraceRegistryScope; by default, it is the global registry. Every
+ * project has its own registry, so projects running concurrently do
+ * not mix their statistics. The calls of curves do not take locks:
+ * the counters are atomic and the slots of events are claimed by an
+ * atomic counter.
+ *
+ * @{
+ */
+
+#ifdef VEGA_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vega
+{
+  class TraceRegistry;
+
+  /**
+   * @brief The statistics of calls of the curves with the same name.
+   */
+  class TraceNode
+  {
+  public:
+    /** The name of the builder of the curve. */
+    std::string name;
+    /** The registry of the node. */
+    TraceRegistry *registry = nullptr;
+    /** The number of calls. */
+    std::atomic<unsigned long> calls{0};
+    /** The number of calls of inner curves made by this node. */
+    std::atomic<unsigned long> inner{0};
+    /** The inclusive time in nanoseconds. */
+    std::atomic<long long> inclusive{0};
+    /** The exclusive time (without inner curves) in nanoseconds. */
+    std::atomic<long long> exclusive{0};
+  };
+
+  /**
+   * @brief One call of a curve for the Chrome trace.
+   */
+  class TraceEvent
+  {
+  public:
+    /** The node of the curve. */
+    const TraceNode *node;
+    /** The index of the thread. */
+    unsigned thread;
+    /** The start of the call in nanoseconds from the origin. */
+    long long start;
+    /** The duration of the call in nanoseconds. */
+    long long duration;
+  };
+
+  /**
+   * Returns the steady time in nanoseconds.
+   *
+   * @return The value of a steady clock.
+   */
+  inline long long traceClock()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /**
+   * @brief The nodes and the events of the curves built while the
+   * registry is current. The registry must outlive the calls of its
+   * curves.
+   */
+  class TraceRegistry
+  {
+  public:
+    /**
+     * Constructs the empty registry; the origin of times is the
+     * moment of construction.
+     *
+     * @param iMaxEvents The maximal number of recorded events.
+     */
+    explicit TraceRegistry(std::size_t iMaxEvents = 1000000)
+        : events(new TraceEvent[iMaxEvents]), maxEvents(iMaxEvents), origin(traceClock())
+    {
+    }
+
+    TraceRegistry(const TraceRegistry &) = delete;
+    TraceRegistry &operator=(const TraceRegistry &) = delete;
+
+    /**
+     * Returns the number of recorded events. It is read when the
+     * threads calling the curves have finished.
+     *
+     * @return The number of the first events that are stored.
+     */
+    std::size_t size() const
+    {
+      return std::min(claimed.load(std::memory_order_relaxed), maxEvents);
+    }
+
+    /** The lock for the nodes; the calls of curves do not take it. */
+    std::mutex mutex;
+    /** The nodes; the addresses are stable. */
+    std::deque<TraceNode> nodes;
+    /** The first calls of curves in the order of completion. */
+    std::unique_ptr<TraceEvent[]> events;
+    /** The number of claimed slots of events; it may exceed maxEvents. */
+    std::atomic<std::size_t> claimed{0};
+    /** The maximal number of recorded events. */
+    std::size_t maxEvents;
+    /** The origin of times in nanoseconds. */
+    long long origin;
+  };
+
+  /**
+   * Returns the registry set by the innermost TraceRegistryScope of
+   * the calling thread.
+   *
+   * @return The current registry or nullptr.
+   */
+  inline TraceRegistry *&traceCurrent()
+  {
+    static thread_local TraceRegistry *pCurrent = nullptr;
+    return pCurrent;
+  }
+
+  /**
+   * Returns the current registry of the calling thread.
+   *
+   * @return The registry set by the innermost TraceRegistryScope of
+   * the thread or the global registry.
+   */
+  inline TraceRegistry &traceRegistry()
+  {
+    static TraceRegistry uGlobal;
+    TraceRegistry *pCurrent = traceCurrent();
+    return (pCurrent) ? *pCurrent : uGlobal;
+  }
+
+  /**
+   * @brief Makes a registry current for the calling thread during the
+   * lifetime of the object.
+   */
+  class TraceRegistryScope
+  {
+  public:
+    /**
+     * Makes the registry current.
+     *
+     * @param rRegistry The registry.
+     */
+    explicit TraceRegistryScope(TraceRegistry &rRegistry)
+        : m_pPrevious(traceCurrent())
+    {
+      traceCurrent() = &rRegistry;
+    }
+
+    /**
+     * Restores the previous registry.
+     */
+    ~TraceRegistryScope()
+    {
+      traceCurrent() = m_pPrevious;
+    }
+
+    TraceRegistryScope(const TraceRegistryScope &) = delete;
+    TraceRegistryScope &operator=(const TraceRegistryScope &) = delete;
+
+  private:
+    TraceRegistry *m_pPrevious;
+  };
+
+  /**
+   * Returns the node with the given name in the current registry; the
+   * node is created at the first request. The lock is taken when a
+   * curve is built, not when it is called.
+   *
+   * @param sName The name of the builder of the curve.
+   * @return The node of the curve.
+   */
+  inline TraceNode *traceNode(const std::string &sName)
+  {
+    TraceRegistry &rRegistry = traceRegistry();
+    std::lock_guard<std::mutex> uLock(rRegistry.mutex);
+    for (TraceNode &rNode : rRegistry.nodes)
+    {
+      if (rNode.name == sName)
+      {
+        return &rNode;
+      }
+    }
+    rRegistry.nodes.emplace_back();
+    rRegistry.nodes.back().name = sName;
+    rRegistry.nodes.back().registry = &rRegistry;
+    return &rRegistry.nodes.back();
+  }
+
+  /**
+   * @brief Records one call of a curve from construction to
+   * destruction.
+   */
+  class TraceScope
+  {
+  public:
+    /**
+     * Starts the call.
+     *
+     * @param pNode The node of the curve.
+     */
+    explicit TraceScope(TraceNode *pNode)
+    {
+      std::vector<Frame> &rStack = stack();
+      if (!rStack.empty())
+      {
+        rStack.back().node->inner.fetch_add(1, std::memory_order_relaxed);
+      }
+      rStack.push_back(Frame{pNode, traceClock(), 0});
+    }
+
+    /**
+     * Finishes the call.
+     */
+    ~TraceScope()
+    {
+      std::vector<Frame> &rStack = stack();
+      Frame uFrame = rStack.back();
+      rStack.pop_back();
+      long long iTime = traceClock() - uFrame.start;
+      uFrame.node->calls.fetch_add(1, std::memory_order_relaxed);
+      uFrame.node->inclusive.fetch_add(iTime, std::memory_order_relaxed);
+      uFrame.node->exclusive.fetch_add(iTime - uFrame.children, std::memory_order_relaxed);
+      if (!rStack.empty())
+      {
+        rStack.back().children += iTime;
+      }
+
+      // the event is written to the slot claimed by this call
+      TraceRegistry &rRegistry = *uFrame.node->registry;
+      if (rRegistry.claimed.load(std::memory_order_relaxed) < rRegistry.maxEvents)
+      {
+        std::size_t iEvent = rRegistry.claimed.fetch_add(1, std::memory_order_relaxed);
+        if (iEvent < rRegistry.maxEvents)
+        {
+          rRegistry.events[iEvent] = TraceEvent{uFrame.node, thread(),
+                                                uFrame.start - rRegistry.origin, iTime};
+        }
+      }
+    }
+
+  private:
+    class Frame
+    {
+    public:
+      TraceNode *node;
+      long long start;
+      long long children;
+    };
+
+    static std::vector<Frame> &stack()
+    {
+      static thread_local std::vector<Frame> uStack;
+      return uStack;
+    }
+
+    static unsigned thread()
+    {
+      static std::atomic<unsigned> iThreads{0};
+      static thread_local unsigned iThread = iThreads++;
+      return iThread;
+    }
+  };
+
+  /**
+   * Wraps the curve so that its calls are recorded in the node
+   * \p sName.
+   *
+   * @param sName The name of the builder of the curve.
+   * @param uCurve The curve.
+   * @return The instrumented curve.
+   */
+  template <class F>
+  auto traceCurve(const std::string &sName, F uCurve)
+  {
+    TraceNode *pNode = traceNode(sName);
+    return [pNode, uCurve](auto... dArgs)
+    {
+      TraceScope uScope(pNode);
+      return uCurve(dArgs...);
+    };
+  }
+} // namespace vega
+
+#define VEGA_TRACE_CURVE(NAME, ...) vega::traceCurve(NAME, __VA_ARGS__)
+
+#else
+
+#define VEGA_TRACE_CURVE(NAME, ...) __VA_ARGS__
+
+#endif // of VEGA_TRACE
+
+/** @} */
+
+#endif // of __vega_trace_hpp__